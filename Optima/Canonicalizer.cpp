@@ -19,6 +19,9 @@
 
 // C++ includes
 #include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
 
 // Eigen includes
 #include <Optima/deps/eigen3/Eigen/Dense>
@@ -28,6 +31,44 @@
 #include <Optima/Utils.hpp>
 
 namespace Optima {
+namespace {
+
+/// Return `a*b` and set `overflow` to true if the product does not fit in a 64-bit integer.
+auto checkedMul(Index a, Index b, bool& overflow) -> Index
+{
+    if(a == 0 || b == 0) return 0;
+    const Index maxval = std::numeric_limits<Index>::max();
+    const Index minval = std::numeric_limits<Index>::min();
+    // The magnitude of the smallest integer cannot be represented, so it is treated as overflow before std::abs is used
+    if(a == minval || b == minval) { overflow = true; return 0; }
+    if(std::abs(a) > maxval / std::abs(b)) { overflow = true; return 0; }
+    return a * b;
+}
+
+/// Return `a - b` and set `overflow` to true if the difference does not fit in a 64-bit integer.
+auto checkedSub(Index a, Index b, bool& overflow) -> Index
+{
+    const Index maxval = std::numeric_limits<Index>::max();
+    const Index minval = std::numeric_limits<Index>::min();
+    if((b < 0 && a > maxval + b) || (b > 0 && a < minval + b)) { overflow = true; return 0; }
+    return a - b;
+}
+
+/// Return `(p*aij - aik*akj)/d`, the fraction-free elimination update of an entry.
+/// The division by `d` is exact in a Bareiss elimination. The flag `overflow`
+/// is set to true if any intermediate result does not fit in a 64-bit integer
+/// (including the smallest one, whose magnitude is not representable) or if the
+/// division by `d` is not exact.
+auto bareiss(Index p, Index aij, Index aik, Index akj, Index d, bool& overflow) -> Index
+{
+    const Index num = checkedSub(checkedMul(p, aij, overflow), checkedMul(aik, akj, overflow), overflow);
+    // The smallest integer is rejected so that num/d cannot overflow and std::abs is defined for all entries of the tableau
+    if(num == std::numeric_limits<Index>::min()) { overflow = true; return 0; }
+    if(num % d != 0) { overflow = true; return 0; }
+    return num / d;
+}
+
+} // namespace
 
 struct Canonicalizer::Impl
 {
@@ -67,17 +108,36 @@ struct Canonicalizer::Impl
     /// The threshold used to compare numbers.
     double threshold;
 
+    /// The number of rows, columns and the rank of matrix `A`.
+    Index m = 0, n = 0, r = 0;
+
+    /// The boolean flag that indicates if the canonical form is exact.
+    bool exact = false;
+
+    /// The numerators of the entries in `S` with respect to the common denominator `denom`.
+    MatrixXl Snum;
+
+    /// The numerators of the entries in `R` with respect to the common denominator `denom`.
+    /// The rows corresponding to linearly dependent equations are integer vectors with denominator one.
+    MatrixXl Rnum;
+
+    /// The common denominator of the entries in `S` and in the upper `r` rows of `R`.
+    Index denom = 1;
+
     /// Compute the canonical matrix of the given matrix.
     auto compute(MatrixConstRef A) -> void
     {
         // The number of rows and columns of A
-        const Index m = A.rows();
-        const Index n = A.cols();
+        m = A.rows();
+        n = A.cols();
 
         // Check if number of columns is greater/equal than number of rows
         assert(n >= m && "Could not canonicalize the given matrix. "
             "The given matrix has more rows than columns.");
 
+        // The canonical form computed below is subject to round-off errors
+        exact = false;
+
         /// Initialize the current ordering of the variables
         inv_ordering = indices(n);
 
@@ -85,7 +145,7 @@ struct Canonicalizer::Impl
         lu.compute(A);
 
         // Get the rank of matrix A
-        const Index r = lu.rank();
+        r = lu.rank();
 
         // Get the LU factors of matrix A
         const auto L   = lu.matrixLU().leftCols(m).triangularView<Eigen::UnitLower>();
@@ -119,6 +179,174 @@ struct Canonicalizer::Impl
         threshold = std::abs(lu.maxPivot()) * lu.threshold() * std::max(A.rows(), A.cols());
     }
 
+    /// Compute the canonical matrix of the given matrix using exact integer arithmetic.
+    auto computeExact(MatrixConstRef A) -> bool
+    {
+        // The largest integer that can be exactly represented by a double
+        const double maxint = 9007199254740992.0; // 2^53
+
+        // Use the floating-point algorithm if an entry in A is not an exactly representable integer
+        for(Index j = 0; j < A.cols(); ++j)
+            for(Index i = 0; i < A.rows(); ++i)
+                if(A(i, j) != std::round(A(i, j)) || std::abs(A(i, j)) > maxint)
+                    { compute(A); return false; }
+
+        // The number of rows and columns of A
+        m = A.rows();
+        n = A.cols();
+
+        // Check if number of columns is greater/equal than number of rows
+        assert(n >= m && "Could not canonicalize the given matrix. "
+            "The given matrix has more rows than columns.");
+
+        // The augmented tableau T = [A I] on which the fraction-free Gauss-Jordan elimination is performed
+        MatrixXl T = zeros<Index>(m, n + m);
+        T.leftCols(n) = A.cast<Index>();
+        T.rightCols(m).diagonal().fill(1);
+
+        // The ordering of the rows (equations) and columns (variables) after pivoting
+        Indices rows = indices(m);
+        Indices cols = indices(n);
+
+        // The boolean flag that indicates an overflow or inexact division has happened
+        bool overflow = false;
+
+        // The previous pivot, which divides exactly all updated entries (Bareiss property)
+        Index d = 1;
+
+        // Perform the fraction-free Gauss-Jordan elimination with full pivoting
+        Index k = 0;
+        for(; k < m && k < n; ++k)
+        {
+            // Find the non-zero entry with smallest magnitude to keep the integers small
+            Index ip = -1, jp = -1;
+            for(Index j = k; j < n; ++j)
+                for(Index i = k; i < m; ++i)
+                    if(T(i, j) != 0 && (ip < 0 || std::abs(T(i, j)) < std::abs(T(ip, jp))))
+                        { ip = i; jp = j; }
+
+            // Stop if the remaining rows are all zeros (these are linearly dependent equations)
+            if(ip < 0) break;
+
+            // Move the pivot entry to position (k, k)
+            T.row(k).swap(T.row(ip));
+            T.col(k).swap(T.col(jp));
+            std::swap(rows[k], rows[ip]);
+            std::swap(cols[k], cols[jp]);
+
+            // Eliminate the k-th column in all other rows
+            const Index p = T(k, k);
+            for(Index i = 0; i < m; ++i)
+            {
+                if(i == k) continue;
+                const Index aik = T(i, k);
+                for(Index j = 0; j < n + m; ++j)
+                    T(i, j) = bareiss(p, T(i, j), aik, T(k, j), d, overflow);
+                if(overflow) break;
+            }
+
+            // Use the floating-point algorithm if the integers grew beyond 64-bit
+            if(overflow) { compute(A); return false; }
+
+            d = p;
+        }
+
+        // The rank of matrix A
+        r = k;
+
+        // Ensure the common denominator is positive
+        if(d < 0) { T.topRows(r) *= -1; d = -d; }
+
+        // Set the exact numerators of S and R, and their common denominator
+        denom = d;
+        Snum = T.topRows(r).middleCols(r, n - r);
+        Rnum = T.rightCols(m);
+
+        // Reduce each row of R corresponding to a linearly dependent equation by the gcd of its entries
+        for(Index i = r; i < m; ++i)
+        {
+            Index g = 0;
+            for(Index j = 0; j < m; ++j)
+                g = std::gcd(g, Rnum(i, j));
+            if(g > 1) Rnum.row(i) /= g;
+        }
+
+        // Set the permutation matrices P, Ptr, Q and Q(aux)
+        Ptr = rows;
+        P.resize(m);
+        P(Ptr) = indices(m);
+        Q = cols;
+        Qaux = Q;
+
+        // Initialize the current ordering of the variables
+        inv_ordering = indices(n);
+
+        // Initialize the permutation matrices Kb and Kn
+        Kb.setIdentity(r);
+        Kn.setIdentity(n - r);
+
+        // The canonical form is exact
+        exact = true;
+
+        // Set the floating-point matrices S and R from their exact numerators
+        updateFromNumerators();
+
+        return true;
+    }
+
+    /// Update the floating-point matrices `S` and `R` from their exact numerators.
+    auto updateFromNumerators() -> void
+    {
+        S = Snum.cast<double>() / static_cast<double>(denom);
+        R = Rnum.cast<double>();
+        R.topRows(r) /= static_cast<double>(denom);
+
+        // The non-zero entries in S are multiples of 1/denom, so any smaller magnitude is an exact zero
+        threshold = 0.5 / static_cast<double>(denom);
+    }
+
+    /// Swap a basic variable by a non-basic variable using exact integer arithmetic.
+    /// @return `false` if the update could not be performed without integer overflow.
+    auto updateWithSwapBasicVariableExact(Index ib, Index in) -> bool
+    {
+        // The pivot numerator, which becomes the new common denominator
+        const Index p = Snum(ib, in);
+
+        // The boolean flag that indicates an overflow or inexact division has happened
+        bool overflow = false;
+
+        // The updated numerators of S and R
+        MatrixXl Snew = Snum;
+        MatrixXl Rnew = Rnum;
+
+        // Update the rows of S and the upper `r` rows of R, except those of the pivot row
+        for(Index i = 0; i < r && !overflow; ++i)
+        {
+            if(i == ib) continue;
+            const Index sik = Snum(i, in);
+            for(Index j = 0; j < n - r; ++j)
+                Snew(i, j) = bareiss(p, Snum(i, j), sik, Snum(ib, j), denom, overflow);
+            for(Index j = 0; j < m; ++j)
+                Rnew(i, j) = bareiss(p, Rnum(i, j), sik, Rnum(ib, j), denom, overflow);
+            Snew(i, in) = -sik;
+        }
+
+        // Keep the current numerators unchanged if the integers grew beyond 64-bit
+        if(overflow) return false;
+
+        // Update the pivot entry, whose row is unchanged otherwise
+        Snew(ib, in) = denom;
+
+        // Ensure the new common denominator is positive
+        const Index sign = p < 0 ? -1 : 1;
+
+        Snum = sign * Snew;
+        Rnum.topRows(r) = sign * Rnew.topRows(r);
+        denom = sign * p;
+
+        return true;
+    }
+
     /// Rationalize the entries in the canonical form.
     auto rationalize(Index maxdenominator) -> void
     {
@@ -136,12 +364,12 @@ struct Canonicalizer::Impl
     auto updateWithSwapBasicVariable(Index ib, Index in) -> void
     {
         // Check if ib < rank(A)
-        assert(ib < lu.rank() &&
+        assert(ib < r &&
             "Could not swap basic and non-basic variables. "
                 "Expecting an index of basic variable below `r`, where `r = rank(A)`.");
 
         // Check if in < n - rank(A)
-        assert(in < lu.cols() - lu.rank() &&
+        assert(in < n - r &&
             "Could not swap basic and non-basic variables. "
                 "Expecting an index of non-basic variable below `n - r`, where `r = rank(A)`.");
 
@@ -150,48 +378,44 @@ struct Canonicalizer::Impl
             "Could not swap basic and non-basic variables. "
                 "Expecting a non-basic variable with non-zero pivot.");
 
+        // Update the permutation matrix Q
+        std::swap(Q[ib], Q[r + in]);
+
+        // Use exact integer arithmetic if possible, otherwise continue with floating-point arithmetic
+        if(exact && (exact = updateWithSwapBasicVariableExact(ib, in)))
+            return updateFromNumerators();
+
         // Initialize the matrix M
         M = S.col(in);
 
         // Auxiliary variables
-        const Index m = S.rows();
         const double aux = 1.0/S(ib, in);
 
         // Update the canonicalizer matrix R (only its `r` upper rows, where `r = rank(A)`)
         R.row(ib) *= aux;
-        for(Index i = 0; i < m; ++i)
+        for(Index i = 0; i < r; ++i)
             if(i != ib) R.row(i) -= S(i, in) * R.row(ib);
 
         // Update matrix S
         S.row(ib) *= aux;
-        for(Index i = 0; i < m; ++i)
+        for(Index i = 0; i < r; ++i)
             if(i != ib) S.row(i) -= S(i, in) * S.row(ib);
         S.col(in) = -M*aux;
         S(ib, in) = aux;
-
-        // Update the permutation matrix Q
-        std::swap(Q[ib], Q[m + in]);
     }
 
     /// Update the existing canonical form with given priority weights for the columns.
     auto updateWithPriorityWeights(VectorConstRef w) -> void
     {
         // Assert there are as many weights as there are variables
-        assert(w.rows() == lu.cols() &&
+        assert(w.rows() == n &&
             "Could not update the canonical form."
                 "Mismatch number of variables and given priority weights.");
 
-        // The rank and number of columns of matrix A
-        const Index r = lu.rank();
-        const Index n = lu.cols();
-
         // The number of basic and non-basic variables
         const Index nb = r;
         const Index nn = n - r;
 
-        // The upper part of R corresponding to linearly independent rows of A
-        auto Rb = R.topRows(nb);
-
         // The indices of the basic and non-basic variables
         auto ibasic = Q.head(nb);
         auto inonbasic = Q.tail(nn);
@@ -222,6 +446,29 @@ struct Canonicalizer::Impl
                 updateWithSwapBasicVariable(i, j);
         }
 
+        // Sort the basic and non-basic variables in descend order of weights
+        updateOrderingWithPriorityWeights(w);
+    }
+
+    /// Update the ordering of the basic and non-basic variables with given priority weights, without swapping them.
+    auto updateOrderingWithPriorityWeights(VectorConstRef w) -> void
+    {
+        // Assert there are as many weights as there are variables
+        assert(w.rows() == n &&
+            "Could not update the ordering of the canonical form."
+                "Mismatch number of variables and given priority weights.");
+
+        // The number of basic and non-basic variables
+        const Index nb = r;
+        const Index nn = n - r;
+
+        // The upper part of R corresponding to linearly independent rows of A
+        auto Rb = R.topRows(nb);
+
+        // The indices of the basic and non-basic variables
+        auto ibasic = Q.head(nb);
+        auto inonbasic = Q.tail(nn);
+
         // Sort the basic variables in descend order of weights
         std::sort(Kb.indices().data(), Kb.indices().data() + nb,
             [&](Index l, Index r) { return w[ibasic[l]] > w[ibasic[r]]; });
@@ -244,6 +491,15 @@ struct Canonicalizer::Impl
 
         // Rearrange the permutation matrix Q based on the new order of non-basic variables
         Kn.transpose().applyThisOnTheLeft(inonbasic);
+
+        // Rearrange the exact numerators of S and R in the same way
+        if(exact)
+        {
+            auto Rbnum = Rnum.topRows(nb);
+            Kb.transpose().applyThisOnTheLeft(Snum);
+            Kn.applyThisOnTheRight(Snum);
+            Kb.transpose().applyThisOnTheLeft(Rbnum);
+        }
     }
 };
 
@@ -272,17 +528,17 @@ auto Canonicalizer::operator=(Canonicalizer other) -> Canonicalizer&
 
 auto Canonicalizer::numVariables() const -> Index
 {
-    return pimpl->lu.cols();
+    return pimpl->n;
 }
 
 auto Canonicalizer::numEquations() const -> Index
 {
-    return pimpl->lu.rows();
+    return pimpl->m;
 }
 
 auto Canonicalizer::numBasicVariables() const -> Index
 {
-    return pimpl->lu.rank();
+    return pimpl->r;
 }
 
 auto Canonicalizer::numNonBasicVariables() const -> Index
@@ -305,6 +561,26 @@ auto Canonicalizer::Q() const -> IndicesConstRef
     return pimpl->Q;
 }
 
+auto Canonicalizer::exact() const -> bool
+{
+    return pimpl->exact;
+}
+
+auto Canonicalizer::denominator() const -> Index
+{
+    return pimpl->exact ? pimpl->denom : 0;
+}
+
+auto Canonicalizer::numeratorsS() const -> MatrixXlConstRef
+{
+    return pimpl->Snum;
+}
+
+auto Canonicalizer::numeratorsR() const -> MatrixXlConstRef
+{
+    return pimpl->Rnum;
+}
+
 auto Canonicalizer::C() const -> Matrix
 {
     const Index m  = numEquations();
@@ -335,6 +611,11 @@ auto Canonicalizer::compute(MatrixConstRef A) -> void
     pimpl->compute(A);
 }
 
+auto Canonicalizer::computeExact(MatrixConstRef A) -> bool
+{
+    return pimpl->computeExact(A);
+}
+
 auto Canonicalizer::updateWithSwapBasicVariable(Index ibasic, Index inonbasic) -> void
 {
     pimpl->updateWithSwapBasicVariable(ibasic, inonbasic);
@@ -345,6 +626,11 @@ auto Canonicalizer::updateWithPriorityWeights(VectorConstRef weights) -> void
     pimpl->updateWithPriorityWeights(weights);
 }
 
+auto Canonicalizer::updateOrderingWithPriorityWeights(VectorConstRef weights) -> void
+{
+    pimpl->updateOrderingWithPriorityWeights(weights);
+}
+
 auto Canonicalizer::rationalize(Index maxdenominator) -> void
 {
     pimpl->rationalize(maxdenominator);
@@ -73,6 +73,23 @@ public:
     /// Return the canonicalized matrix \eq{C = RAQ = [I\quad S]}`.
     auto C() const -> Matrix;
 
+    /// Return `true` if the canonical form was computed and updated with exact integer arithmetic.
+    /// @see computeExact
+    auto exact() const -> bool;
+
+    /// Return the common denominator of the entries in \eq{S} and in the rows of \eq{R}
+    /// corresponding to linearly independent equations, or zero if the canonical form is not exact.
+    auto denominator() const -> Index;
+
+    /// Return the numerators of the entries in \eq{S} with respect to the common @ref denominator.
+    /// @note The returned matrix is only meaningful if the canonical form is exact.
+    auto numeratorsS() const -> MatrixXlConstRef;
+
+    /// Return the numerators of the entries in \eq{R} with respect to the common @ref denominator.
+    /// The rows of \eq{R} corresponding to linearly dependent equations have denominator one.
+    /// @note The returned matrix is only meaningful if the canonical form is exact.
+    auto numeratorsR() const -> MatrixXlConstRef;
+
     /// Return the indices of the linearly independent rows of the original matrix.
     auto indicesLinearlyIndependentEquations() const -> IndicesConstRef;
 
@@ -85,6 +102,17 @@ public:
     /// Compute the canonical matrix of the given matrix.
     auto compute(MatrixConstRef A) -> void;
 
+    /// Compute the canonical matrix of the given matrix with integer entries using exact arithmetic.
+    /// This method uses a fraction-free (Bareiss) Gauss-Jordan elimination with 64-bit integers so
+    /// that the entries in matrices \eq{S} and \eq{R} are exact rational numbers with a common
+    /// denominator, which makes a @ref rationalize operation unnecessary. Subsequent basis swap
+    /// operations are also performed exactly. If an entry in \eq{A} is not an integer, or if
+    /// the integers grow beyond 64-bit during the elimination, the floating-point algorithm in
+    /// @ref compute is used instead.
+    /// @param A The matrix with integer entries to be canonicalized.
+    /// @return `true` if the canonical form could be computed exactly.
+    auto computeExact(MatrixConstRef A) -> bool;
+
     /// Update the canonical form with the swap of a basic variable by a non-basic variable.
     /// @param ibasic The index of the basic variable between 0 and \eq{n_\mathrm{b}}`.
     /// @param inonbasic The index of the non-basic variable between 0 and \eq{n_\mathrm{n}}`.
@@ -103,6 +131,13 @@ public:
     /// @param weights The priority weights of the variables.
     auto updateWithPriorityWeights(VectorConstRef weights) -> void;
 
+    /// Update the ordering of the basic and non-basic variables with given priority weights.
+    /// This method sorts the basic and non-basic variables in descend order with respect to their
+    /// priority weights, as in @ref updateWithPriorityWeights, but it does not swap basic and
+    /// non-basic variables, so that the basic variables remain the same.
+    /// @param weights The priority weights of the variables.
+    auto updateOrderingWithPriorityWeights(VectorConstRef weights) -> void;
+
     /// Update the canonical form with a new ordering for the variables.
     auto updateWithNewOrdering(IndicesConstRef ordering) -> void;
 
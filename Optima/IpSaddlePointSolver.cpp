@@ -30,26 +30,66 @@
 #include <Optima/VariantMatrix.hpp>
 
 namespace Optima {
+namespace {
+
+/// Return the rows of `X` scaled by the entries of `d`, i.e., `diag(d)*X`, where `X` is a vector or a matrix with one column per right-hand side vector.
+template<typename MatrixType, typename VectorType>
+auto scaleRows(const MatrixType& X, const VectorType& d)
+{
+    return (X.array().colwise() * d.array()).matrix();
+}
+
+} // namespace
 
 struct IpSaddlePointSolver::Impl
 {
-    /// The `A` matrix ordered according to (s, l, u, z, w, f).
-    Matrix A;
+    /// The columns of `A` corresponding to the variables in the partitions (l, u, z, w).
+    Matrix Aluzw;
+
+    /// The columns of `H` corresponding to the variables in the partitions (l, u, z, w) (used if `H` is dense).
+    Matrix Hluzw;
+
+    /// The rows of `H` corresponding to the variables in the partitions (z, w), with zero columns for fixed variables (used if `H` is dense).
+    Matrix Hzw;
 
-    /// The `H` matrix ordered according to (s, l, u, z, w, f).
-    VariantMatrix H;
+    /// The diagonal entries of `H` corresponding to the variables in the partitions (l, u, z, w) (used if `H` is diagonal).
+    Vector Hdluzw;
 
-    /// The diagonal matrices Z, W, L, U ordered according to (s, l, u, z, w, f).
+    /// The structure of the Hessian matrix `H` in the last decomposition.
+    MatrixStructure structure;
+
+    /// The boolean flag that indicates if the Hessian matrix `H` is constant across decompositions.
+    bool hessianconstant = false;
+
+    /// The boolean flag that indicates if the entries of `H` in Hluzw, Hzw, Hdluzw are up-to-date.
+    bool hessiangathered = false;
+
+    /// The diagonal matrices Z, W, L, U in original order.
     Vector Z, W, L, U;
 
+    /// The reciprocals of the diagonal matrices Z, W, L, U computed once per decomposition.
+    Vector Zinv, Winv, Linv, Uinv;
+
+    /// The diagonal matrices inv(L)*Z and inv(U)*W computed once per decomposition.
+    Vector ZL, WU;
+
     /// The diagonal matrix D in the H + D block in original order.
     Vector D;
 
-    /// The residual vector
-    Vector r;
+    /// The workspace for the solve method, with right-hand side `r = [a b c d]` in original order, the vectors
+    /// `v = [cl/Zl du/Wu cz/Zz dw/Ww]` and the modified `a` of the (l, u, z, w) partitions, and the solution `xy = [x y]`
+    /// of the saddle point problem (only used with several right-hand side vectors).
+    template<typename T>
+    struct Workspace
+    {
+        T r, v, aluzw, xy;
+    };
 
-    /// The solution vector
-    Vector s;
+    /// The workspace for the solve method with a single right-hand side vector.
+    Workspace<Vector> wvector;
+
+    /// The workspace for the solve method with several right-hand side vectors, one per column.
+    Workspace<Matrix> wmatrix;
 
     /// The saddle point solver.
     SaddlePointSolver spsolver;
@@ -57,6 +97,21 @@ struct IpSaddlePointSolver::Impl
     /// The order of the variables as x = [xs xl xu xz xw xf].
     Indices iordering;
 
+    /// The position of each variable in `iordering`.
+    Indices ipositions;
+
+    /// The partition of each variable, with 0, 1, 2, 3, 4, 5 denoting partitions (s, l, u, z, w, f).
+    Indices ipartitions;
+
+    /// The updated partition of each variable computed in @ref updatePartitioning.
+    Indices ipartitionsnew;
+
+    /// The variables whose partition changed in the last call to @ref updatePartitioning.
+    Indices ichanged;
+
+    /// The number of variables whose partition changed in the last call to @ref updatePartitioning.
+    Index nchanged;
+
     /// The number of variables.
     Index n;
 
@@ -78,9 +133,6 @@ struct IpSaddlePointSolver::Impl
         // The result of this method call
         Result res;
 
-        // Create a copy of matrix A
-        this->A = A;
-
         // Initialize the members related to number of variables and constraints
         n  = A.cols();
         m  = A.rows();
@@ -93,8 +145,19 @@ struct IpSaddlePointSolver::Impl
         nw = 0;
         t  = 3*n + m;
 
-        // Initialize the ordering of the variables
+        // Initialize the ordering of the variables, with all of them in partition s
         iordering = indices(n);
+        ipositions = indices(n);
+        ipartitions = zeros<Index>(n);
+        ipartitionsnew = zeros<Index>(n);
+        ichanged = zeros<Index>(n);
+        nchanged = 0;
+
+        // Initialize the columns of A corresponding to the (l, u, z, w) variables, which are none at this point
+        Aluzw.resize(m, 0);
+
+        // The entries of H need to be gathered in the next decomposition
+        hessiangathered = false;
 
         // Allocate memory for some vector/matrix members
         D = zeros(n);
@@ -102,8 +165,15 @@ struct IpSaddlePointSolver::Impl
         W = zeros(n);
         L = zeros(n);
         U = zeros(n);
-        r = zeros(t);
-        s = zeros(t);
+        Zinv = zeros(n);
+        Winv = zeros(n);
+        Linv = zeros(n);
+        Uinv = zeros(n);
+        ZL = zeros(n);
+        WU = zeros(n);
+        wvector.r = zeros(t);
+        wvector.v = zeros(n);
+        wvector.aluzw = zeros(n);
 
         // Initialize the saddle point solver
         res += spsolver.initialize(A);
@@ -111,19 +181,27 @@ struct IpSaddlePointSolver::Impl
         return res.stop();
     }
 
-    /// Update the partitioning of the free variables into (s, l, u, z, w)
+    /// Update the partitioning of the variables into (s, l, u, z, w, f).
+    /// Only the variables whose partition changed since the last call are moved in `iordering`.
     auto updatePartitioning(IpSaddlePointMatrix lhs) -> Result
     {
         // The result of this method call
         Result res;
 
+        // The begin positions in iordering of the partitions (s, l, u, z, w, f) before the update
+        Index begin[7];
+        begin[0] = 0;
+        begin[1] = begin[0] + ns;
+        begin[2] = begin[1] + nl;
+        begin[3] = begin[2] + nu;
+        begin[4] = begin[3] + nz;
+        begin[5] = begin[4] + nw;
+        begin[6] = n;
+
         // Initialize the number of free and fixed variables
         nf = lhs.jf.size();
         nx = n - nf;
 
-        // Partition the variables into (free variables, fixed variables)
-        partitionRight(iordering, lhs.jf);
-
         // Auxiliary variables
         const double eps = std::numeric_limits<double>::epsilon();
 
@@ -133,40 +211,93 @@ struct IpSaddlePointSolver::Impl
         auto partition_z = [&](Index i) { return std::abs(lhs.L[i]) < std::abs(lhs.Z[i]) && std::abs(lhs.L[i]/lhs.Z[i]) <= eps; };
         auto partition_w = [&](Index i) { return std::abs(lhs.U[i]) < std::abs(lhs.W[i]) && std::abs(lhs.U[i]/lhs.W[i]) <= eps; };
 
-        // The begin and end iterators in iordering for the free variables
-        auto ib = iordering.data();
-        auto ie = iordering.data() + nx;
-
-        // Order the free variables into the partitions (w, z, u, l, s)
-        auto iw = std::partition(ib, ie, partition_w);
-        auto iz = std::partition(iw, ie, partition_z);
-        auto iu = std::partition(iz, ie, partition_u);
-        auto il = std::partition(iu, ie, partition_l);
-        auto is = ie;
-
-        // Reverse the order of the free variables into (s, l, u, z, w)
-        std::reverse(ib, ie);
+        // Determine the updated partition of each free variable (in the priority order w, z, u, l, s)
+        for(Index i = 0; i < n; ++i)
+            ipartitionsnew[i] =
+                partition_w(i) ? 4 :
+                partition_z(i) ? 3 :
+                partition_u(i) ? 2 :
+                partition_l(i) ? 1 : 0;
+
+        // Set the partition of the fixed variables
+        ipartitionsnew(lhs.jf).fill(5);
+
+        // Swap the variables at positions p and q in iordering
+        auto swap = [&](Index p, Index q)
+        {
+            std::swap(iordering[p], iordering[q]);
+            ipositions[iordering[p]] = p;
+            ipositions[iordering[q]] = q;
+        };
+
+        // Move only the variables whose partition changed, one partition boundary at a time
+        nchanged = 0;
+        for(Index i = 0; i < n; ++i)
+        {
+            const Index from = ipartitions[i];
+            const Index to = ipartitionsnew[i];
+
+            if(from == to)
+                continue;
+
+            // Move the variable to the end of its partition and then shift the begin of the next partition
+            for(Index k = from; k < to; ++k)
+                swap(ipositions[i], --begin[k + 1]);
+
+            // Move the variable to the begin of its partition and then shift the begin of this partition
+            for(Index k = from; k > to; --k)
+                swap(ipositions[i], begin[k]++);
+
+            ipartitions[i] = to;
+            ichanged[nchanged++] = i;
+        }
 
         // Update the number of (s, l, u, z, w) variables
-        nw = iw - ib;
-        nz = iz - iw;
-        nu = iu - iz;
-        nl = il - iu;
-        ns = is - il;
-
-        // Initialize A, Z, W, L and U according to iordering
-        A.noalias() = lhs.A(all, iordering);
-        Z.noalias() = lhs.Z(iordering);
-        W.noalias() = lhs.W(iordering);
-        L.noalias() = lhs.L(iordering);
-        U.noalias() = lhs.U(iordering);
+        ns = begin[1] - begin[0];
+        nl = begin[2] - begin[1];
+        nu = begin[3] - begin[2];
+        nz = begin[4] - begin[3];
+        nw = begin[5] - begin[4];
+
+        // Initialize Z, W, L and U (no permutation is needed, since they are kept in original order)
+        Z.noalias() = lhs.Z;
+        W.noalias() = lhs.W;
+        L.noalias() = lhs.L;
+        U.noalias() = lhs.U;
+
+        // Initialize the reciprocals of Z, W, L, U so that no division is needed in the solve step
+        Zinv.noalias() = inv(Z);
+        Winv.noalias() = inv(W);
+        Linv.noalias() = inv(L);
+        Uinv.noalias() = inv(U);
+
+        // Initialize the diagonal matrices inv(L)*Z and inv(U)*W
+        ZL.noalias() = Z % Linv;
+        WU.noalias() = W % Uinv;
+
+        // The indices of the (l, u, z, w) variables, the only ones whose columns in A are needed in the solve step
+        const auto jluzw = iordering.segment(ns, nl + nu + nz + nw);
+
+        // Initialize the columns of A corresponding to the (l, u, z, w) variables (skipped if the partition is unchanged)
+        if(nchanged > 0)
+            Aluzw.noalias() = lhs.A(all, jluzw);
 
         return res.stop();
     }
 
+    /// Return true if the entries of H gathered in the last decomposition can be used again.
+    auto reuseHessianEntries(IpSaddlePointMatrix lhs) const -> bool
+    {
+        return hessianconstant && hessiangathered && nchanged == 0 && structure == lhs.H.structure;
+    }
+
     /// Decompose the saddle point matrix equation.
     auto decompose(IpSaddlePointMatrix lhs) -> Result
     {
+        // Assert the dimensions of A are the same as in the last call to initialize
+        Assert(lhs.A.rows() == m && lhs.A.cols() == n, "Could not decompose the saddle point matrix.",
+            "The dimensions of matrix A differ from those given in the last call to initialize.");
+
         switch(lhs.H.structure) {
         case MatrixStructure::Dense: return decomposeDenseHessianMatrix(lhs);
         case MatrixStructure::Diagonal: return decomposeDiagonalHessianMatrix(lhs);
@@ -186,16 +317,28 @@ struct IpSaddlePointSolver::Impl
         res += updatePartitioning(lhs);
 
         // Calculate D = inv(L)*Z + inv(U)*W
-        D = lhs.Z/lhs.L + lhs.W/lhs.U;
+        D.noalias() = ZL + WU;
+
+        // The indices of the (l, u, z, w), (z, w) and fixed variables
+        const auto jluzw = iordering.segment(ns, nl + nu + nz + nw);
+        const auto jzw   = iordering.segment(ns + nl + nu, nz + nw);
+        const auto jf    = iordering.tail(nf);
 
-        // The indices of the free variables
-        const auto jx = iordering.head(nx);
+        // Skip the gathering of the entries of H if H is constant and the partition is unchanged
+        if(!reuseHessianEntries(lhs))
+        {
+            // Set the Hessian matrix to dense structure
+            structure = MatrixStructure::Dense;
 
-        // Set the Hessian matrix to dense structure
-        H.setDense(n);
+            // Set the columns of H corresponding to the (l, u, z, w) variables
+            Hluzw.noalias() = lhs.H.dense(all, jluzw);
 
-        // Set the Hessian matrix considering the ordering (s, l, u, z, w, f)
-        H.dense.topLeftCorner(nx, nx) = lhs.H.dense(jx, jx);
+            // Set the rows of H corresponding to the (z, w) variables, excluding the contribution of fixed variables
+            Hzw.noalias() = lhs.H.dense(jzw, all);
+            Hzw(all, jf).fill(0.0);
+
+            hessiangathered = true;
+        }
 
         // The indices of the (z, w, f) variables that are excluded from the decomposition
         const auto jzwf = iordering.tail(nz + nw + nf);
@@ -203,8 +346,9 @@ struct IpSaddlePointSolver::Impl
         // Define the saddle point matrix in original ordering
         SaddlePointMatrix spm(lhs.H, D, lhs.A, jzwf);
 
-        // Decompose the saddle point matrix
-        res += spsolver.decompose(spm);
+        // Decompose the saddle point matrix, keeping the basic variables of the canonical form if the partition is unchanged
+        if(nchanged == 0) res += spsolver.decomposeKeepingBasicVariables(spm);
+        else res += spsolver.decompose(spm);
 
         return res.stop();
     }
@@ -219,16 +363,24 @@ struct IpSaddlePointSolver::Impl
         res += updatePartitioning(lhs);
 
         // Calculate D = inv(L)*Z + inv(U)*W
-        D = lhs.Z/lhs.L + lhs.W/lhs.U;
+        D.noalias() = ZL + WU;
+
+        // The indices of the (l, u, z, w) variables
+        const auto jluzw = iordering.segment(ns, nl + nu + nz + nw);
 
-        // The indices of the free variables
-        const auto jx = iordering.head(nx);
+        // Skip the gathering of the entries of H if H is constant and the partition is unchanged
+        if(!reuseHessianEntries(lhs))
+        {
+            // Set the Hessian matrix to diagonal (or zero) structure
+            structure = lhs.H.structure;
 
-        // Set the Hessian matrix to diagonal structure
-        H.setDiagonal(n);
+            // Set the diagonal entries of H corresponding to the (l, u, z, w) variables
+            if(structure == MatrixStructure::Diagonal)
+                Hdluzw.noalias() = lhs.H.diagonal(jluzw);
+            else Hdluzw = zeros(jluzw.size());
 
-        // Set the Hessian matrix considering the ordering (s, l, u, z, w, f)
-        H.diagonal.head(nx) = lhs.H.diagonal(jx);
+            hessiangathered = true;
+        }
 
         // The indices of the (z, w, f) variables that are excluded from the decomposition
         const auto jzwf = iordering.tail(nz + nw + nf);
@@ -236,8 +388,9 @@ struct IpSaddlePointSolver::Impl
         // Define the saddle point matrix in original ordering
         SaddlePointMatrix spm(lhs.H, D, lhs.A, jzwf);
 
-        // Decompose the saddle point matrix
-        res += spsolver.decompose(spm);
+        // Decompose the saddle point matrix, keeping the basic variables of the canonical form if the partition is unchanged
+        if(nchanged == 0) res += spsolver.decomposeKeepingBasicVariables(spm);
+        else res += spsolver.decompose(spm);
 
         return res.stop();
     }
@@ -245,422 +398,167 @@ struct IpSaddlePointSolver::Impl
     /// Solve the saddle point matrix equation.
     auto solve(IpSaddlePointVector rhs, IpSaddlePointSolution sol) -> Result
     {
-        switch(H.structure) {
-        case MatrixStructure::Dense: return solveDenseHessianMatrix(rhs, sol);
-        case MatrixStructure::Diagonal: return solveDiagonalHessianMatrix(rhs, sol);
-        case MatrixStructure::Zero: return solveDiagonalHessianMatrix(rhs, sol);
-        }
-
-        return {};
+        return solve<VectorConstRef, VectorRef>(rhs.a, rhs.b, rhs.c, rhs.d, sol.x, sol.y, sol.z, sol.w, wvector);
     }
 
-    /// Solve the saddle point matrix equation with dense Hessian.
-    auto solveDenseHessianMatrix(IpSaddlePointVector rhs, IpSaddlePointSolution sol) -> Result
+    /// Solve the saddle point matrix equation for several right-hand side vectors, given as the columns of `rhs`.
+    auto solve(MatrixConstRef rhs, MatrixRef sol) -> Result
     {
-        // The result of this method call
-        Result res;
-
-        // Views to the blocks of the Hessian matrix Hxx
-        const auto Hxx = H.dense.topLeftCorner(nx, nx);
-
-        const auto Hs  = Hxx.topRows(ns);
-        const auto Hl  = Hxx.middleRows(ns, nl);
-        const auto Hu  = Hxx.middleRows(ns + nl, nu);
-        const auto Hz  = Hxx.middleRows(ns + nl + nu, nz);
-        const auto Hw  = Hxx.bottomRows(nw);
-
-        const auto Hsl = Hs.middleCols(ns, nl);
-        const auto Hsu = Hs.middleCols(ns + nl, nu);
-        const auto Hsz = Hs.middleCols(ns + nl + nu, nz);
-        const auto Hsw = Hs.rightCols(nw);
-
-        const auto Hll = Hl.middleCols(ns, nl);
-        const auto Hlu = Hl.middleCols(ns + nl, nu);
-        const auto Hlz = Hl.middleCols(ns + nl + nu, nz);
-        const auto Hlw = Hl.rightCols(nw);
-
-        const auto Hul = Hu.middleCols(ns, nl);
-        const auto Huu = Hu.middleCols(ns + nl, nu);
-        const auto Huz = Hu.middleCols(ns + nl + nu, nz);
-        const auto Huw = Hu.rightCols(nw);
-
-        const auto Hzs = Hz.leftCols(ns);
-        const auto Hzl = Hz.middleCols(ns, nl);
-        const auto Hzu = Hz.middleCols(ns + nl, nu);
-        const auto Hzz = Hz.middleCols(ns + nl + nu, nz);
-        const auto Hzw = Hz.rightCols(nw);
-
-        const auto Hws = Hw.leftCols(ns);
-        const auto Hwl = Hw.middleCols(ns, nl);
-        const auto Hwu = Hw.middleCols(ns + nl, nu);
-        const auto Hwz = Hw.middleCols(ns + nl + nu, nz);
-        const auto Hww = Hw.rightCols(nw);
-
-        // Views to the sub-matrices in A = [As Al Au Az Aw Af]
-        const auto Ax = A.leftCols(nx);
-        const auto Al = Ax.middleCols(ns, nl);
-        const auto Au = Ax.middleCols(ns + nl, nu);
-        const auto Az = Ax.middleCols(ns + nl + nu, nz);
-        const auto Aw = Ax.rightCols(nw);
-
-        // Views to the sub-vectors in Z = [Zs Zl Zu Zz Zw Zf]
-        const auto Zx = Z.head(nx);
-        const auto Zs = Zx.head(ns);
-        const auto Zl = Zx.segment(ns, nl);
-        const auto Zu = Zx.segment(ns + nl, nu);
-        const auto Zz = Zx.segment(ns + nl + nu, nz);
-        const auto Zw = Zx.tail(nw);
-
-        // Views to the sub-vectors in W = [Ws Wl Wu Wz Ww Wf]
-        const auto Wx = W.head(nx);
-        const auto Ws = Wx.head(ns);
-        const auto Wl = Wx.segment(ns, nl);
-        const auto Wu = Wx.segment(ns + nl, nu);
-        const auto Wz = Wx.segment(ns + nl + nu, nz);
-        const auto Ww = Wx.tail(nw);
-
-        // Views to the sub-vectors in L = [Ls Ll Lu Lz Lw Lf]
-        const auto Lx = L.head(nx);
-        const auto Ls = Lx.head(ns);
-        const auto Ll = Lx.segment(ns, nl);
-        const auto Lu = Lx.segment(ns + nl, nu);
-        const auto Lz = Lx.segment(ns + nl + nu, nz);
-        const auto Lw = Lx.tail(nw);
-
-        // Views to the sub-vectors in U = [Us Ul Uu Uz Uw Uf]
-        const auto Ux = U.head(nx);
-        const auto Us = Ux.head(ns);
-        const auto Ul = Ux.segment(ns, nl);
-        const auto Uu = Ux.segment(ns + nl, nu);
-        const auto Uz = Ux.segment(ns + nl + nu, nz);
-        const auto Uw = Ux.tail(nw);
-
-        // The right-hand side vectors [a b c d]
-        auto a = r.head(n);
-        auto b = r.segment(n, m);
-        auto c = r.segment(n + m, n);
-        auto d = r.tail(n);
-
-        // The solution vectors [x y z w]
-        auto x = s.head(n);
-        auto y = s.segment(n, m);
-        auto z = s.segment(n + m, n);
-        auto w = s.tail(n);
-
-        // Views to the sub-vectors in a = [as al au az aw af]
-        auto ax = a.head(nx);
-        auto as = ax.head(ns);
-        auto al = ax.segment(ns, nl);
-        auto au = ax.segment(ns + nl, nu);
-        auto az = ax.segment(ns + nl + nu, nz);
-        auto aw = ax.tail(nw);
-        auto af = a.tail(nf);
-
-        // Views to the sub-vectors in c = [cs cl cu cz cw cf]
-        auto cx = c.head(nx);
-        auto cs = cx.head(ns);
-        auto cl = cx.segment(ns, nl);
-        auto cu = cx.segment(ns + nl, nu);
-        auto cz = cx.segment(ns + nl + nu, nz);
-        auto cw = cx.tail(nw);
-        auto cf = c.tail(nf);
-
-        // Views to the sub-vectors in d = [ds dl du dz dw df]
-        auto dx = d.head(nx);
-        auto ds = dx.head(ns);
-        auto dl = dx.segment(ns, nl);
-        auto du = dx.segment(ns + nl, nu);
-        auto dz = dx.segment(ns + nl + nu, nz);
-        auto dw = dx.tail(nw);
-        auto df = d.tail(nf);
-
-        // Views to the sub-vectors in x = [xs xl xu xz xw xf]
-        auto xx = x.head(nx);
-        auto xs = xx.head(ns);
-        auto xl = xx.segment(ns, nl);
-        auto xu = xx.segment(ns + nl, nu);
-        auto xz = xx.segment(ns + nl + nu, nz);
-        auto xw = xx.tail(nw);
-        auto xf = x.tail(nf);
-
-        // Views to the sub-vectors in z = [zs zl zu zz zw zf]
-        auto zx = z.head(nx);
-        auto zs = zx.head(ns);
-        auto zl = zx.segment(ns, nl);
-        auto zu = zx.segment(ns + nl, nu);
-        auto zz = zx.segment(ns + nl + nu, nz);
-        auto zw = zx.tail(nw);
-        auto zf = z.tail(nf);
-
-        // Views to the sub-vectors in w = [ws wl wu wz ww wf]
-        auto wx = w.head(nx);
-        auto ws = wx.head(ns);
-        auto wl = wx.segment(ns, nl);
-        auto wu = wx.segment(ns + nl, nu);
-        auto wz = wx.segment(ns + nl + nu, nz);
-        auto ww = wx.tail(nw);
-        auto wf = w.tail(nf);
-
-        // Initialize a, b, c, d in the ordering x = [xs, xl, xu, xz, xw, xf]
-        a.noalias() = rhs.a(iordering);
-        b.noalias() = rhs.b;
-        c.noalias() = rhs.c(iordering);
-        d.noalias() = rhs.d(iordering);
-
-        // Calculate as', al', au', az', aw', b'
-        as += cs/Ls + ds/Us - Hsl*(cl/Zl) - Hsu*(du/Wu) - Hsz*(cz/Zz) - Hsw*(dw/Ww);
-        al += dl/Ul - Hll*(cl/Zl) - Hlu*(du/Wu) - Hlz*(cz/Zz) - Hlw*(dw/Ww) - (Wl/Ul) % (cl/Zl);
-        au += cu/Lu - Hul*(cl/Zl) - Huu*(du/Wu) - Huz*(cz/Zz) - Huw*(dw/Ww) - (Zu/Lu) % (du/Wu);
-        az += dz/Uz - Hzl*(cl/Zl) - Hzu*(du/Wu) - Hzz*(cz/Zz) - Hzw*(dw/Ww) - (Wz/Uz) % (cz/Zz);
-        aw += cw/Lw - Hwl*(cl/Zl) - Hwu*(du/Wu) - Hwz*(cz/Zz) - Hww*(dw/Ww) - (Zw/Lw) % (dw/Ww);
-         b -= Al*(cl/Zl) + Au*(du/Wu) + Az*(cz/Zz) + Aw*(dw/Ww);
-
-        // Store az and aw in zz and ww for later use
-        zz.noalias() = -az;
-        ww.noalias() = -aw;
-
-        // Set az and aw to zero
-        az.fill(0.0);
-        aw.fill(0.0);
-
-        // Take advantage of `sol.x` to bring `a` back to original ordering
-        sol.x(iordering) = a;
-
-        // Solve the saddle point problem
-        res += spsolver.solve({sol.x, b}, {sol.x, y});
-
-        // Set `x` to the just calculated `sol.x` in the ordering (s, l, u, z, w, f)
-        x = sol.x(iordering);
-
-        // Calculate zz and ww
-        zz.noalias() += Hzs*xs + Hzl*xl + Hzu*xu + tr(Az)*y;
-        ww.noalias() += Hws*xs + Hwl*xl + Hwu*xu + tr(Aw)*y;
-
-        // Calculate zl and wu
-        zl.noalias() = -(Zl % xl)/Ll;
-        wu.noalias() = -(Wu % xu)/Uu;
-
-        // Calculate xl and xu
-        xl.noalias() = (cl - Ll % zl)/Zl;
-        xu.noalias() = (du - Uu % wu)/Wu;
-
-        // Calculate xz and xw
-        xz.noalias() = (cz - Lz % zz)/Zz;
-        xw.noalias() = (dw - Uw % ww)/Ww;
-
-        // Calculate zs and ws
-        zs.noalias() = (cs - Zs % xs)/Ls;
-        ws.noalias() = (ds - Ws % xs)/Us;
-
-        // Calculate zu and zw
-        zu.noalias() = (cu - Zu % xu)/Lu;
-        zw.noalias() = (cw - Zw % xw)/Lw;
-
-        // Calculate wl and wz
-        wl.noalias() = (dl - Wl % xl)/Ul;
-        wz.noalias() = (dz - Wz % xz)/Uz;
-
-        // Calculate xf, zf, wf
-        xf.noalias() = af;
-        zf.noalias() = cf;
-        wf.noalias() = df;
+        // Resize the workspace matrices for the number of right-hand side vectors
+        const Index k = rhs.cols();
+        wmatrix.r.resize(t, k);
+        wmatrix.v.resize(n, k);
+        wmatrix.aluzw.resize(n, k);
+        wmatrix.xy.resize(n + m, k);
+
+        return solve<MatrixConstRef, MatrixRef>(
+            rhs.topRows(n), rhs.middleRows(n, m), rhs.middleRows(n + m, n), rhs.bottomRows(n),
+            sol.topRows(n), sol.middleRows(n, m), sol.middleRows(n + m, n), sol.bottomRows(n), wmatrix);
+    }
 
-        // Permute the calculated (x z w) to their original order
-        sol.y = y;
-        sol.x(iordering) = x;
-        sol.z(iordering) = z;
-        sol.w(iordering) = w;
+    /// Solve the saddle point problem [a b] = [x y] using the decomposition of the saddle point solver.
+    auto solveReduced(Workspace<Vector>& ws, VectorRef x, VectorRef y) -> Result
+    {
+        return spsolver.solve({ws.r.head(n), ws.r.segment(n, m)}, {x, y});
+    }
 
-        return res.stop();
+    /// Solve the saddle point problem [a b] = [x y] using the decomposition of the saddle point solver (one column per right-hand side).
+    auto solveReduced(Workspace<Matrix>& ws, MatrixRef x, MatrixRef y) -> Result
+    {
+        Result res = spsolver.solve(ws.r.topRows(n + m), ws.xy);
+        x.noalias() = ws.xy.topRows(n);
+        y.noalias() = ws.xy.bottomRows(m);
+        return res;
     }
 
-    /// Solve the saddle point matrix equation with diagonal Hessian.
-    auto solveDiagonalHessianMatrix(IpSaddlePointVector rhs, IpSaddlePointSolution sol) -> Result
+    /// Solve the saddle point matrix equation for the right-hand side [a b c d] with solution [x y z w], which are
+    /// either vectors or matrices with one column per right-hand side vector (with workspace of the same kind).
+    /// All vectors are kept in original order: the operations on the variables in
+    /// partition s are performed on the full vectors, and then the entries of the
+    /// variables in the (typically small) partitions (l, u, z, w, f) are corrected.
+    template<typename ConstRef, typename Ref, typename T>
+    auto solve(ConstRef rhsa, ConstRef rhsb, ConstRef rhsc, ConstRef rhsd, Ref x, Ref y, Ref z, Ref w, Workspace<T>& ws) -> Result
     {
         // The result of this method call
         Result res;
 
-        // Views to the blocks of the Hessian matrix Hxx
-        const auto Hxx = H.diagonal.head(nx);
-        const auto Hll = Hxx.segment(ns, nl);
-        const auto Huu = Hxx.segment(ns + nl, nu);
-        const auto Hzz = Hxx.segment(ns + nl + nu, nz);
-        const auto Hww = Hxx.tail(nw);
-
-        // Views to the sub-matrices in A = [As Al Au Az Aw Af]
-        const auto Ax = A.leftCols(nx);
-        const auto Al = Ax.middleCols(ns, nl);
-        const auto Au = Ax.middleCols(ns + nl, nu);
-        const auto Az = Ax.middleCols(ns + nl + nu, nz);
-        const auto Aw = Ax.rightCols(nw);
-
-        // Views to the sub-vectors in Z = [Zs Zl Zu Zz Zw Zf]
-        const auto Zx = Z.head(nx);
-        const auto Zs = Zx.head(ns);
-        const auto Zl = Zx.segment(ns, nl);
-        const auto Zu = Zx.segment(ns + nl, nu);
-        const auto Zz = Zx.segment(ns + nl + nu, nz);
-        const auto Zw = Zx.tail(nw);
-
-        // Views to the sub-vectors in W = [Ws Wl Wu Wz Ww Wf]
-        const auto Wx = W.head(nx);
-        const auto Ws = Wx.head(ns);
-        const auto Wl = Wx.segment(ns, nl);
-        const auto Wu = Wx.segment(ns + nl, nu);
-        const auto Wz = Wx.segment(ns + nl + nu, nz);
-        const auto Ww = Wx.tail(nw);
-
-        // Views to the sub-vectors in L = [Ls Ll Lu Lz Lw Lf]
-        const auto Lx = L.head(nx);
-        const auto Ls = Lx.head(ns);
-        const auto Ll = Lx.segment(ns, nl);
-        const auto Lu = Lx.segment(ns + nl, nu);
-        const auto Lz = Lx.segment(ns + nl + nu, nz);
-        const auto Lw = Lx.tail(nw);
-
-        // Views to the sub-vectors in U = [Us Ul Uu Uz Uw Uf]
-        const auto Ux = U.head(nx);
-        const auto Us = Ux.head(ns);
-        const auto Ul = Ux.segment(ns, nl);
-        const auto Uu = Ux.segment(ns + nl, nu);
-        const auto Uz = Ux.segment(ns + nl + nu, nz);
-        const auto Uw = Ux.tail(nw);
-
-        // The right-hand side vectors [a b c d]
-        auto a = r.head(n);
-        auto b = r.segment(n, m);
-        auto c = r.segment(n + m, n);
-        auto d = r.tail(n);
-
-        // The solution vectors [x y z w]
-        auto x = s.head(n);
-        auto y = s.segment(n, m);
-        auto z = s.segment(n + m, n);
-        auto w = s.tail(n);
-
-        // Views to the sub-vectors in a = [as al au az aw af]
-        auto ax = a.head(nx);
-        auto as = ax.head(ns);
-        auto al = ax.segment(ns, nl);
-        auto au = ax.segment(ns + nl, nu);
-        auto az = ax.segment(ns + nl + nu, nz);
-        auto aw = ax.tail(nw);
-        auto af = a.tail(nf);
-
-        // Views to the sub-vectors in c = [cs cl cu cz cw cf]
-        auto cx = c.head(nx);
-        auto cs = cx.head(ns);
-        auto cl = cx.segment(ns, nl);
-        auto cu = cx.segment(ns + nl, nu);
-        auto cz = cx.segment(ns + nl + nu, nz);
-        auto cw = cx.tail(nw);
-        auto cf = c.tail(nf);
-
-        // Views to the sub-vectors in d = [ds dl du dz dw df]
-        auto dx = d.head(nx);
-        auto ds = dx.head(ns);
-        auto dl = dx.segment(ns, nl);
-        auto du = dx.segment(ns + nl, nu);
-        auto dz = dx.segment(ns + nl + nu, nz);
-        auto dw = dx.tail(nw);
-        auto df = d.tail(nf);
-
-        // Views to the sub-vectors in x = [xs xl xu xz xw xf]
-        auto xx = x.head(nx);
-        auto xs = xx.head(ns);
-        auto xl = xx.segment(ns, nl);
-        auto xu = xx.segment(ns + nl, nu);
-        auto xz = xx.segment(ns + nl + nu, nz);
-        auto xw = xx.tail(nw);
-        auto xf = x.tail(nf);
-
-        // Views to the sub-vectors in z = [zs zl zu zz zw zf]
-        auto zx = z.head(nx);
-        auto zs = zx.head(ns);
-        auto zl = zx.segment(ns, nl);
-        auto zu = zx.segment(ns + nl, nu);
-        auto zz = zx.segment(ns + nl + nu, nz);
-        auto zw = zx.tail(nw);
-        auto zf = z.tail(nf);
-
-        // Views to the sub-vectors in w = [ws wl wu wz ww wf]
-        auto wx = w.head(nx);
-        auto ws = wx.head(ns);
-        auto wl = wx.segment(ns, nl);
-        auto wu = wx.segment(ns + nl, nu);
-        auto wz = wx.segment(ns + nl + nu, nz);
-        auto ww = wx.tail(nw);
-        auto wf = w.tail(nf);
-
-        // Initialize a, b, c, d in the ordering x = [xs, xl, xu, xf]
-        a.noalias() = rhs.a(iordering);
-        b.noalias() = rhs.b;
-        c.noalias() = rhs.c(iordering);
-        d.noalias() = rhs.d(iordering);
-
-        // Calculate as', al', au', az', aw', b'
-        as += cs/Ls + ds/Us;
-        al += dl/Ul - Hll % (cl/Zl) - (Wl/Ul) % (cl/Zl);
-        au += cu/Lu - Huu % (du/Wu) - (Zu/Lu) % (du/Wu);
-        az += dz/Uz - Hzz % (cz/Zz) - (Wz/Uz) % (cz/Zz);
-        aw += cw/Lw - Hww % (dw/Ww) - (Zw/Lw) % (dw/Ww);
-         b -= Al*(cl/Zl) + Au*(du/Wu) + Az*(cz/Zz) + Aw*(dw/Ww);
-
-		// Store az and aw in zz and ww for later use
-		zz.noalias() = -az;
-		ww.noalias() = -aw;
-
-		// Set az and aw to zero
-		az.fill(0.0);
-		aw.fill(0.0);
-
-        // Take advantage of `sol.x` to bring `a` back to original ordering
-        sol.x(iordering) = a;
+        // The indices of the variables in the partitions (l, u, z, w, f)
+        const auto jl = iordering.segment(ns, nl);
+        const auto ju = iordering.segment(ns + nl, nu);
+        const auto jz = iordering.segment(ns + nl + nu, nz);
+        const auto jw = iordering.segment(ns + nl + nu + nz, nw);
+        const auto jf = iordering.tail(nf);
+
+        // The indices of the variables in the partitions (l, u, z, w)
+        const auto jluzw = iordering.segment(ns, nl + nu + nz + nw);
+
+        // Views to the sub-matrices in Aluzw = [Al Au Az Aw]
+        const auto Az = Aluzw.middleCols(nl + nu, nz);
+        const auto Aw = Aluzw.rightCols(nw);
+
+        // The right-hand side vectors [a b c d] in original order
+        auto a = ws.r.topRows(n);
+        auto b = ws.r.middleRows(n, m);
+        auto c = ws.r.middleRows(n + m, n);
+        auto d = ws.r.bottomRows(n);
+
+        // Initialize a, b, c, d (a copy is needed in case rhs and sol share memory)
+        a.noalias() = rhsa;
+        b.noalias() = rhsb;
+        c.noalias() = rhsc;
+        d.noalias() = rhsd;
+
+        // Views to the sub-vectors in v = [vl vu vz vw] = [cl/Zl du/Wu cz/Zz dw/Ww]
+        auto vluzw = ws.v.topRows(nl + nu + nz + nw);
+        auto vl = vluzw.topRows(nl);
+        auto vu = vluzw.middleRows(nl, nu);
+        auto vz = vluzw.middleRows(nl + nu, nz);
+        auto vw = vluzw.bottomRows(nw);
+
+        // Views to the sub-vectors in aluzw = [al' au' az' aw']
+        auto aall = ws.aluzw.topRows(nl + nu + nz + nw);
+        auto al = aall.topRows(nl);
+        auto au = aall.middleRows(nl, nu);
+        auto az = aall.middleRows(nl + nu, nz);
+        auto aw = aall.bottomRows(nw);
+
+        // Calculate vl, vu, vz, vw
+        vl.noalias() = scaleRows(c(jl, all), Zinv(jl));
+        vu.noalias() = scaleRows(d(ju, all), Winv(ju));
+        vz.noalias() = scaleRows(c(jz, all), Zinv(jz));
+        vw.noalias() = scaleRows(d(jw, all), Winv(jw));
+
+        // Calculate al', au', az', aw' (without the contribution of H)
+        al.noalias() = a(jl, all) + scaleRows(d(jl, all), Uinv(jl)) - scaleRows(vl, WU(jl));
+        au.noalias() = a(ju, all) + scaleRows(c(ju, all), Linv(ju)) - scaleRows(vu, ZL(ju));
+        az.noalias() = a(jz, all) + scaleRows(d(jz, all), Uinv(jz)) - scaleRows(vz, WU(jz));
+        aw.noalias() = a(jw, all) + scaleRows(c(jw, all), Linv(jw)) - scaleRows(vw, ZL(jw));
+
+        // Calculate as' (without the contribution of H) for all variables, and then correct the (l, u, z, w) ones
+        a += scaleRows(c, Linv) + scaleRows(d, Uinv);
+        a(jluzw, all) = aall;
+
+        // Add the contribution of H in a'
+        switch(structure) {
+        case MatrixStructure::Dense: a.noalias() -= Hluzw * vluzw; break;
+        case MatrixStructure::Diagonal: a(jluzw, all) -= scaleRows(vluzw, Hdluzw); break;
+        case MatrixStructure::Zero: break;
+        }
+
+        // Calculate b'
+        b.noalias() -= Aluzw * vluzw;
+
+        // Store az' and aw' for later use
+        az.noalias() = -a(jz, all);
+        aw.noalias() = -a(jw, all);
+
+        // Set az' and aw' to zero, and af' to af
+        a(jz, all).fill(0.0);
+        a(jw, all).fill(0.0);
+        a(jf, all) = rhsa(jf, all);
 
         // Solve the saddle point problem
-        res += spsolver.solve({sol.x, b}, {sol.x, y});
+        res += solveReduced(ws, x, y);
 
-        // Set `x` to the just calculated `sol.x` in the ordering (s, l, u, z, w, f)
-        x = sol.x(iordering);
+        // Calculate zs and ws for all variables (the remaining ones are overwritten below)
+        z.noalias() = scaleRows(c, Linv) - scaleRows(x, ZL);
+        w.noalias() = scaleRows(d, Uinv) - scaleRows(x, WU);
 
         // Calculate zz and ww
-        zz.noalias() += tr(Az)*y;
-        ww.noalias() += tr(Aw)*y;
+        z(jz, all) = az + tr(Az)*y;
+        w(jw, all) = aw + tr(Aw)*y;
+
+        // Add the contribution of H in zz and ww
+        if(structure == MatrixStructure::Dense)
+        {
+            z(jz, all) += Hzw.topRows(nz) * x;
+            w(jw, all) += Hzw.bottomRows(nw) * x;
+        }
 
         // Calculate zl and wu
-        zl.noalias() = -(Zl % xl)/Ll;
-        wu.noalias() = -(Wu % xu)/Uu;
+        z(jl, all) = -scaleRows(x(jl, all), ZL(jl));
+        w(ju, all) = -scaleRows(x(ju, all), WU(ju));
 
         // Calculate xl and xu
-        xl.noalias() = (cl - Ll % zl)/Zl;
-        xu.noalias() = (du - Uu % wu)/Wu;
+        x(jl, all) = scaleRows(c(jl, all) - scaleRows(z(jl, all), L(jl)), Zinv(jl));
+        x(ju, all) = scaleRows(d(ju, all) - scaleRows(w(ju, all), U(ju)), Winv(ju));
 
         // Calculate xz and xw
-        xz.noalias() = (cz - Lz % zz)/Zz;
-        xw.noalias() = (dw - Uw % ww)/Ww;
-
-        // Calculate zs and ws
-        zs.noalias() = (cs - Zs % xs)/Ls;
-        ws.noalias() = (ds - Ws % xs)/Us;
+        x(jz, all) = scaleRows(c(jz, all) - scaleRows(z(jz, all), L(jz)), Zinv(jz));
+        x(jw, all) = scaleRows(d(jw, all) - scaleRows(w(jw, all), U(jw)), Winv(jw));
 
         // Calculate zu and zw
-        zu.noalias() = (cu - Zu % xu)/Lu;
-        zw.noalias() = (cw - Zw % xw)/Lw;
+        z(ju, all) = scaleRows(c(ju, all), Linv(ju)) - scaleRows(x(ju, all), ZL(ju));
+        z(jw, all) = scaleRows(c(jw, all), Linv(jw)) - scaleRows(x(jw, all), ZL(jw));
 
         // Calculate wl and wz
-        wl.noalias() = (dl - Wl % xl)/Ul;
-        wz.noalias() = (dz - Wz % xz)/Uz;
+        w(jl, all) = scaleRows(d(jl, all), Uinv(jl)) - scaleRows(x(jl, all), WU(jl));
+        w(jz, all) = scaleRows(d(jz, all), Uinv(jz)) - scaleRows(x(jz, all), WU(jz));
 
         // Calculate xf, zf, wf
-        xf.noalias() = af;
-        zf.noalias() = cf;
-        wf.noalias() = df;
-
-        // Permute the calculated (x z w) to their original order
-        sol.y = y;
-        sol.x(iordering) = x;
-        sol.z(iordering) = z;
-        sol.w(iordering) = w;
+        x(jf, all) = a(jf, all);
+        z(jf, all) = c(jf, all);
+        w(jf, all) = d(jf, all);
 
         return res.stop();
     }
@@ -693,6 +591,12 @@ auto IpSaddlePointSolver::options() const -> const SaddlePointOptions&
     return pimpl->spsolver.options();
 }
 
+auto IpSaddlePointSolver::setConstantHessian(bool constant) -> void
+{
+    pimpl->hessianconstant = constant;
+    pimpl->hessiangathered = false;
+}
+
 auto IpSaddlePointSolver::initialize(MatrixConstRef A) -> Result
 {
     return pimpl->initialize(A);
@@ -708,4 +612,29 @@ auto IpSaddlePointSolver::solve(IpSaddlePointVector rhs, IpSaddlePointSolution s
     return pimpl->solve(rhs, sol);
 }
 
+auto IpSaddlePointSolver::solve(MatrixConstRef rhs, MatrixRef sol) -> Result
+{
+    return pimpl->solve(rhs, sol);
+}
+
+auto IpSaddlePointSolver::changedVariables() const -> IndicesConstRef
+{
+    return pimpl->ichanged.head(pimpl->nchanged);
+}
+
+auto IpSaddlePointSolver::variablesAtLowerBounds() const -> IndicesConstRef
+{
+    return pimpl->iordering.segment(pimpl->ns + pimpl->nl + pimpl->nu, pimpl->nz);
+}
+
+auto IpSaddlePointSolver::variablesAtUpperBounds() const -> IndicesConstRef
+{
+    return pimpl->iordering.segment(pimpl->ns + pimpl->nl + pimpl->nu + pimpl->nz, pimpl->nw);
+}
+
+auto IpSaddlePointSolver::canonicalizer() const -> const Canonicalizer&
+{
+    return pimpl->spsolver.canonicalizer();
+}
+
 } // namespace Optima
@@ -27,6 +27,7 @@
 namespace Optima {
 
 // Forward declarations
+class Canonicalizer;
 class IpSaddlePointMatrix;
 class IpSaddlePointSolution;
 class IpSaddlePointVector;
@@ -55,6 +56,12 @@ public:
     /// Return the current saddle point options.
     auto options() const -> const SaddlePointOptions&;
 
+    /// Set whether the Hessian matrix \eq{H} remains constant in subsequent calls to @ref decompose.
+    /// If so, the entries of \eq{H} needed in the solve step are only gathered again
+    /// when the partition of the variables changes (see @ref changedVariables). The decomposition
+    /// itself is still computed in every call, since it depends on the diagonal \eq{L^{-1}Z + U^{-1}W}.
+    auto setConstantHessian(bool constant) -> void;
+
     /// Initialize the saddle point solver with the coefficient matrix \eq{A} of the saddle point problem.
     /// @note This method should be called before the @ref decompose method. However, it does not
     /// need to be called again if matrix \eq{A} of the saddle point problem is the same as in the
@@ -63,7 +70,11 @@ public:
     auto initialize(MatrixConstRef A) -> Result;
 
     /// Decompose the coefficient matrix of the saddle point problem.
+    /// If no variable changed its partition since the last call (see @ref changedVariables), the basic
+    /// variables of the canonical form of \eq{A} are kept (see SaddlePointSolver::decomposeKeepingBasicVariables).
     /// @note This method should be called before the @ref solve method and after @ref canonicalize.
+    /// @note Matrix \eq{A} in `lhs` must be the same as in the last call to @ref initialize, since its columns
+    /// needed in the solve step are only gathered again when the partition of the variables changes.
     /// @param lhs The coefficient matrix of the saddle point problem.
     auto decompose(IpSaddlePointMatrix lhs) -> Result;
 
@@ -74,6 +85,28 @@ public:
     /// @param sol The solution of the saddle point problem.
     auto solve(IpSaddlePointVector rhs, IpSaddlePointSolution sol) -> Result;
 
+    /// Solve the saddle point problem for several right-hand side vectors at once.
+    /// @note This method expects that a call to method @ref decompose has already been performed.
+    /// @param rhs The matrix whose columns are the right-hand side vectors [a b c d] of the saddle point problem.
+    /// @param sol The matrix whose columns are the solution vectors [x y z w] of the saddle point problem.
+    auto solve(MatrixConstRef rhs, MatrixRef sol) -> Result;
+
+    /// Return the indices of the variables whose partition changed in the last call to @ref decompose.
+    /// The variables are partitioned as free variables with lower bound (l), upper bound (u),
+    /// lower bound with negligible slack (z), upper bound with negligible slack (w), the
+    /// remaining free variables (s), and fixed variables (f).
+    auto changedVariables() const -> IndicesConstRef;
+
+    /// Return the indices of the variables at their lower bounds with negligible slack (partition z) in the last call to @ref decompose.
+    auto variablesAtLowerBounds() const -> IndicesConstRef;
+
+    /// Return the indices of the variables at their upper bounds with negligible slack (partition w) in the last call to @ref decompose.
+    auto variablesAtUpperBounds() const -> IndicesConstRef;
+
+    /// Return the canonical form of the coefficient matrix \eq{A} of the saddle point problem.
+    /// @note This method expects that a call to method @ref initialize has already been performed.
+    auto canonicalizer() const -> const Canonicalizer&;
+
 private:
     struct Impl;
 
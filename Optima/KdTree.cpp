@@ -0,0 +1,131 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "KdTree.hpp"
+
+// C++ includes
+#include <vector>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+
+struct KdTree::Impl
+{
+    /// Used to represent a node in the kd-tree, with the same index as its stored vector.
+    struct Node { Index left, right, dim; };
+
+    /// The vectors stored in the kd-tree.
+    std::vector<Vector> points;
+
+    /// The nodes of the kd-tree.
+    std::vector<Node> nodes;
+
+    /// Insert a vector in the kd-tree, which has index equal to the number of previously inserted vectors.
+    auto insert(VectorConstRef p) -> void
+    {
+        const Index k = points.size();
+
+        Assert(k == 0 || p.size() == points.front().size(),
+            "Could not insert the vector in the kd-tree.",
+            "The vector has a different dimension than the stored ones.");
+
+        points.push_back(p);
+        nodes.push_back({-1, -1, 0});
+
+        // Descend the tree until an empty child is found for the new node
+        for(Index i = 0; k > 0; )
+        {
+            const Index dim = nodes[i].dim;
+            Index& child = p[dim] < points[i][dim] ? nodes[i].left : nodes[i].right;
+            if(child < 0)
+            {
+                child = k;
+                nodes[k].dim = (dim + 1) % p.size();
+                break;
+            }
+            i = child;
+        }
+    }
+
+    /// Return the index of the stored vector nearest to a given one (or -1 if the kd-tree is empty).
+    auto nearest(VectorConstRef p) const -> Index
+    {
+        Index best = -1;
+        double bestdist = infinity();
+        if(points.size()) search(0, p, best, bestdist);
+        return best;
+    }
+
+    /// Search the subtree with root node i for the stored vector nearest to p.
+    auto search(Index i, VectorConstRef p, Index& best, double& bestdist) const -> void
+    {
+        if(i < 0) return;
+
+        // Update the nearest vector found so far
+        const double dist = (points[i] - p).squaredNorm();
+        if(dist < bestdist) { best = i; bestdist = dist; }
+
+        // Search first the side of the splitting plane where p lies, and the other side only if it can contain a nearer vector
+        const Index dim = nodes[i].dim;
+        const double delta = p[dim] - points[i][dim];
+        search(delta < 0.0 ? nodes[i].left : nodes[i].right, p, best, bestdist);
+        if(delta * delta < bestdist)
+            search(delta < 0.0 ? nodes[i].right : nodes[i].left, p, best, bestdist);
+    }
+};
+
+KdTree::KdTree()
+: pimpl(new Impl())
+{}
+
+KdTree::KdTree(const KdTree& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+KdTree::~KdTree()
+{}
+
+auto KdTree::operator=(KdTree other) -> KdTree&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto KdTree::insert(VectorConstRef p) -> void
+{
+    pimpl->insert(p);
+}
+
+auto KdTree::nearest(VectorConstRef p) const -> Index
+{
+    return pimpl->nearest(p);
+}
+
+auto KdTree::point(Index i) const -> VectorConstRef
+{
+    return pimpl->points[i];
+}
+
+auto KdTree::size() const -> Index
+{
+    return pimpl->points.size();
+}
+
+} // namespace Optima
@@ -0,0 +1,67 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+/// Used to find the stored vector nearest to a given one using a kd-tree.
+/// Each inserted vector is stored in a node of the tree, which splits the space of its subtree along one dimension,
+/// alternating the dimensions along the depth of the tree. The nearest stored vector is found by descending first
+/// into the side of each splitting plane where the given vector lies, and into the other side only if it can contain a nearer one.
+class KdTree
+{
+public:
+    /// Construct a default KdTree instance.
+    KdTree();
+
+    /// Construct a copy of a KdTree instance.
+    KdTree(const KdTree& other);
+
+    /// Destroy this KdTree instance.
+    virtual ~KdTree();
+
+    /// Assign a KdTree instance to this.
+    auto operator=(KdTree other) -> KdTree&;
+
+    /// Insert a vector in the kd-tree, which has index equal to the number of previously inserted vectors.
+    /// @note All inserted vectors must have the same dimension.
+    auto insert(VectorConstRef p) -> void;
+
+    /// Return the index of the stored vector nearest to a given one (or -1 if the kd-tree is empty).
+    auto nearest(VectorConstRef p) const -> Index;
+
+    /// Return the stored vector with given index.
+    auto point(Index i) const -> VectorConstRef;
+
+    /// Return the number of stored vectors.
+    auto size() const -> Index;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -19,6 +19,7 @@
 
 // C++ includes
 #include <functional>
+#include <vector>
 
 // Optima includes
 #include <Optima/Matrix.hpp>
@@ -69,4 +70,28 @@ public:
 /// @return An ObjectiveResult object with the evaluated result of the objective function.
 using ObjectiveFunction = std::function<void(VectorConstRef, ObjectiveResult&)>;
 
+/// The result of the evaluation of an objective function at many points at once.
+/// @see ObjectiveBatchFunction
+class ObjectiveBatchResult
+{
+public:
+    /// The evaluated values of the objective function, one for each point.
+    Vector values;
+
+    /// The evaluated gradients of the objective function, one in each column for each point.
+    Matrix gradients;
+
+    /// The evaluated Hessians of the objective function, one for each point.
+    std::vector<VariantMatrix> hessians;
+
+    /// The requirements in the evaluation of the objective function, which are the same for all points.
+    ObjectiveRequirement requires;
+};
+
+/// The functional signature of an objective function evaluated at many points at once.
+/// @param problems The indices of the optimization problems to which the points belong.
+/// @param X The values of the variables \eq{x} at each point, one in each column.
+/// @param[out] F The evaluated results of the objective function, already sized for the number of points.
+using ObjectiveBatchFunction = std::function<void(IndicesConstRef, MatrixConstRef, ObjectiveBatchResult&)>;
+
 } // namespace Optima
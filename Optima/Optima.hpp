@@ -24,18 +24,28 @@
 #include <Optima/IndexUtils.hpp>
 #include <Optima/IpSaddlePointMatrix.hpp>
 #include <Optima/IpSaddlePointSolver.hpp>
+#include <Optima/KdTree.hpp>
 #include <Optima/Matrix.hpp>
 #include <Optima/Objective.hpp>
+#include <Optima/OptimumBatchSolver.hpp>
 #include <Optima/OptimumOptions.hpp>
 #include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumPresolvedSolver.hpp>
+#include <Optima/OptimumPresolver.hpp>
 #include <Optima/OptimumProblem.hpp>
+#include <Optima/OptimumReducedSolver.hpp>
+#include <Optima/OptimumReducer.hpp>
 #include <Optima/OptimumResult.hpp>
+#include <Optima/OptimumScaling.hpp>
+#include <Optima/OptimumSensitivity.hpp>
 #include <Optima/OptimumSolver.hpp>
+#include <Optima/OptimumSolverT.hpp>
 #include <Optima/OptimumState.hpp>
 #include <Optima/OptimumStepper.hpp>
 #include <Optima/OptimumStructure.hpp>
 #include <Optima/Outputter.hpp>
 #include <Optima/Partition.hpp>
+#include <Optima/QuasiNewtonHessian.hpp>
 #include <Optima/Result.hpp>
 #include <Optima/SaddlePointMatrix.hpp>
 #include <Optima/SaddlePointOptions.hpp>
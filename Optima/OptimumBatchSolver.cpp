@@ -0,0 +1,558 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "OptimumBatchSolver.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/IndexUtils.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumResult.hpp>
+#include <Optima/OptimumSolver.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+
+namespace Optima {
+namespace {
+
+/// Used to represent the queue of problems of a thread as a range of problem indices.
+/// The owner thread takes problems from the front of the range, while other
+/// threads steal chunks of problems from its back.
+struct alignas(64) WorkQueue
+{
+    /// The mutex used to synchronize the owner and the thieves of the queue.
+    std::mutex mutex;
+
+    /// The index of the first problem in the queue.
+    Index begin = 0;
+
+    /// The index past the last problem in the queue.
+    Index end = 0;
+};
+
+} // namespace
+
+struct OptimumBatchSolver::Impl
+{
+    /// The structure shared by all optimization problems.
+    OptimumStructure structure;
+
+    /// The options for the optimization calculations.
+    OptimumOptions options;
+
+    /// The optimization solver with the options of the calculations and no state from previous calculations.
+    /// It is copied to the solver of a thread or lockstep slot before each problem, so that the result of
+    /// each problem does not depend on the number of threads, the scheduling, or the problems solved before.
+    OptimumSolver prototype;
+
+    /// The optimization solvers, one for each thread.
+    std::vector<OptimumSolver> solvers;
+
+    /// The threads in the pool, except the calling thread, which is also used as a worker.
+    std::vector<std::thread> threads;
+
+    /// The task executed by each worker, with the index of the worker as argument.
+    std::function<void(Index)> task;
+
+    /// The mutex used to synchronize the workers.
+    std::mutex mutex;
+
+    /// The condition variable used to notify the workers of a new task.
+    std::condition_variable cvtask;
+
+    /// The condition variable used to notify the calling thread that all workers finished the task.
+    std::condition_variable cvdone;
+
+    /// The counter of tasks, used by the workers to detect a new task.
+    Index numtasks = 0;
+
+    /// The number of workers that have not yet finished the current task.
+    Index numpending = 0;
+
+    /// The boolean flag that indicates the workers should stop.
+    bool stopping = false;
+
+    /// The first exception thrown by a worker in the current task.
+    std::exception_ptr exception;
+
+    /// The strategy for distributing the optimization problems among threads.
+    BatchScheduling scheduling = BatchScheduling::WorkStealing;
+
+    /// The queues of problems of each thread, used in work-stealing scheduling.
+    std::unique_ptr<WorkQueue[]> queues;
+
+    /// The maximum number of optimization problems solved at the same time in lockstep calculations.
+    Index maxlockstep = 256;
+
+    /// The optimization solvers used in lockstep calculations, one for each problem being solved (at most `maxlockstep`).
+    std::vector<OptimumSolver> lockstepsolvers;
+
+    /// The points at which the batch objective function is evaluated in the current iteration, one in each column.
+    Matrix X;
+
+    /// The results of the batch objective function evaluated in the current iteration.
+    ObjectiveBatchResult F;
+
+    /// The column in X of the point of each problem evaluated in the current iteration (-1 if none).
+    Indices icolumns;
+
+    /// Construct an OptimumBatchSolver::Impl instance.
+    Impl(const OptimumStructure& structure, Index numthreads)
+    : structure(structure), prototype(structure)
+    {
+        // Use the number of concurrent threads supported by the hardware if not specified
+        if(numthreads <= 0)
+            numthreads = std::max<Index>(std::thread::hardware_concurrency(), 1);
+
+        // Create the optimization solvers, one for each thread
+        solvers.assign(numthreads, prototype);
+
+        // Create the queues of problems, one for each thread
+        queues.reset(new WorkQueue[numthreads]);
+
+        // Create the threads in the pool (the calling thread is the worker with index zero)
+        for(Index i = 1; i < numthreads; ++i)
+            threads.emplace_back([=] { work(i); });
+    }
+
+    /// Destroy this OptimumBatchSolver::Impl instance.
+    ~Impl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cvtask.notify_all();
+        for(auto& thread : threads)
+            thread.join();
+    }
+
+    /// The loop executed by each thread in the pool.
+    auto work(Index worker) -> void
+    {
+        for(Index done = 0; ; ++done)
+        {
+            // Wait for a new task or for the request to stop
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cvtask.wait(lock, [&] { return stopping || numtasks > done; });
+                if(stopping) return;
+            }
+
+            execute(worker);
+        }
+    }
+
+    /// Execute the current task by a worker, storing the first exception thrown, if any.
+    auto execute(Index worker) -> void
+    {
+        try { task(worker); }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(!exception) exception = std::current_exception();
+        }
+
+        // Notify the calling thread if this was the last worker to finish the task
+        std::lock_guard<std::mutex> lock(mutex);
+        if(--numpending == 0)
+            cvdone.notify_one();
+    }
+
+    /// Execute a task in all workers and wait for its completion.
+    auto run(const std::function<void(Index)>& newtask) -> void
+    {
+        // Start the new task in the threads of the pool
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = newtask;
+            numpending = solvers.size();
+            exception = nullptr;
+            ++numtasks;
+        }
+        cvtask.notify_all();
+
+        // Execute the task also in the calling thread
+        execute(0);
+
+        // Wait for all workers to finish the task
+        std::unique_lock<std::mutex> lock(mutex);
+        cvdone.wait(lock, [&] { return numpending == 0; });
+
+        // Propagate the exception thrown by a worker, if any
+        if(exception)
+            std::rethrow_exception(exception);
+    }
+
+    /// Set the options for the optimization calculations.
+    auto setOptions(const OptimumOptions& _options) -> void
+    {
+        options = _options;
+        prototype.setOptions(options);
+    }
+
+    /// Solve a batch of optimization problems in parallel.
+    auto solve(const std::vector<OptimumParams>& params, std::vector<OptimumState>& states) -> std::vector<OptimumResult>
+    {
+        // The number of optimization problems
+        const Index numproblems = params.size();
+
+        // Ensure there is a state for each optimization problem
+        states.resize(numproblems);
+
+        // The result of each optimization calculation
+        std::vector<OptimumResult> results(numproblems);
+
+        // The function that solves the k-th optimization problem in a given worker
+        auto solveproblem = [&](Index worker, Index k)
+        {
+            solvers[worker] = prototype;
+            results[k] = solvers[worker].solve(params[k], states[k]);
+        };
+
+        // Solve the optimization problems, with each worker starting with a contiguous range of problems
+        runProblems(numproblems, solveproblem);
+
+        return results;
+    }
+
+    /// Solve a batch of optimization problems in lockstep, with their objective functions evaluated together.
+    /// At most `maxlockstep` problems are solved at the same time, each one with the optimization solver of a slot.
+    /// When the calculation of a problem finishes, its slot is used to begin the calculation of the next problem.
+    auto solve(const std::vector<OptimumParams>& params, const ObjectiveBatchFunction& objective, std::vector<OptimumState>& states) -> std::vector<OptimumResult>
+    {
+        // The number of optimization problems
+        const Index numproblems = params.size();
+
+        // Ensure there is a state for each optimization problem
+        states.resize(numproblems);
+
+        // The result of each optimization calculation
+        std::vector<OptimumResult> results(numproblems);
+
+        // The number of slots, which bounds the number of optimization problems solved at the same time
+        const Index numslots = std::min(numproblems, maxlockstep);
+
+        // Ensure there is an optimization solver for each slot
+        lockstepsolvers.resize(std::max<Index>(lockstepsolvers.size(), numslots), prototype);
+
+        // No point of any problem has been evaluated yet
+        icolumns.setConstant(numproblems, -1);
+
+        // The parameters of the problem in each slot, with an objective function that uses the results of the batch evaluation
+        std::vector<OptimumParams> slotparams(numslots);
+
+        // The problem in each slot
+        Indices islotproblems = Indices::Constant(numslots, -1);
+
+        // The slots whose problems have not yet finished, followed by the free slots
+        Indices islots = indices(numslots);
+        Index numactive = 0;
+
+        // The problems of the active slots, whose current points are evaluated together
+        Indices iactive(numslots);
+
+        // The flags that indicate whether the problem in each slot needs more iterations
+        std::vector<char> iterating(numslots);
+
+        // The next problem to be solved
+        Index next = 0;
+
+        while(true)
+        {
+            // Begin the calculations of the next problems in the free slots
+            const Index numbegin = std::min(numslots - numactive, numproblems - next);
+            for(Index j = numactive; j < numactive + numbegin; ++j)
+            {
+                const Index slot = islots[j];
+                const Index k = next++;
+                islotproblems[slot] = k;
+                slotparams[slot] = params[k];
+                slotparams[slot].objective = [&, k](VectorConstRef x, ObjectiveResult& f) { evaluate(objective, k, x, f); };
+            }
+            runProblems(numbegin, [&](Index /*worker*/, Index j)
+            {
+                const Index slot = islots[numactive + j];
+                const Index k = islotproblems[slot];
+                lockstepsolvers[slot] = prototype;
+                lockstepsolvers[slot].begin(slotparams[slot], states[k]);
+                iterating[slot] = !lockstepsolvers[slot].converged();
+                if(!iterating[slot]) results[k] = lockstepsolvers[slot].finish();
+            });
+            numactive = partitionSlots(islots, numactive + numbegin, iterating);
+
+            // Begin more problems if some of those just begun finished at once (e.g., with predicted solutions)
+            if(numactive < numslots && next < numproblems)
+                continue;
+
+            // Stop if all problems have finished
+            if(numactive == 0)
+                break;
+
+            // Evaluate the objective function at the current points of all active problems in a single call
+            for(Index j = 0; j < numactive; ++j)
+                iactive[j] = islotproblems[islots[j]];
+            evaluateBatch(objective, iactive.head(numactive), states);
+
+            // Perform one iteration of each active problem, which uses the results of the batch evaluation, and finish those that converged
+            runProblems(numactive, [&](Index /*worker*/, Index j)
+            {
+                const Index slot = islots[j];
+                iterating[slot] = lockstepsolvers[slot].step();
+                if(!iterating[slot]) results[islotproblems[slot]] = lockstepsolvers[slot].finish();
+            });
+            numactive = partitionSlots(islots, numactive, iterating);
+        }
+
+        return results;
+    }
+
+    /// Move the slots in the first `count` entries of `islots` that need more iterations to the front, and return their number.
+    static auto partitionSlots(IndicesRef islots, Index count, const std::vector<char>& iterating) -> Index
+    {
+        return std::stable_partition(islots.data(), islots.data() + count, [&](Index slot) { return iterating[slot]; }) - islots.data();
+    }
+
+    /// Evaluate the batch objective function at the current points of the given problems.
+    auto evaluateBatch(const ObjectiveBatchFunction& objective, IndicesConstRef iproblems, const std::vector<OptimumState>& states) -> void
+    {
+        const Index n = structure.numVariables();
+        const Index numpoints = iproblems.size();
+
+        // The Hessian matrices are not evaluated if they are constant or approximated with a quasi-Newton mode
+        const bool hessian = !structure.hasConstantHessian() && options.hessian.mode == HessianMode::Exact;
+
+        // Gather the current points of the problems in the columns of X
+        X.resize(n, numpoints);
+        for(Index j = 0; j < numpoints; ++j)
+        {
+            X.col(j) = states[iproblems[j]].x;
+            icolumns[iproblems[j]] = j;
+        }
+
+        // Establish the current needs for the objective function evaluation
+        F.requires.value = true;
+        F.requires.gradient = true;
+        F.requires.hessian = hessian;
+
+        // Evaluate the objective function at all points
+        F.values.resize(numpoints);
+        F.gradients.resize(n, numpoints);
+        F.hessians.resize(hessian ? numpoints : 0);
+        objective(iproblems, X, F);
+    }
+
+    /// Evaluate the objective function of a problem using the results of the batch evaluation, if available.
+    auto evaluate(const ObjectiveBatchFunction& objective, Index k, VectorConstRef x, ObjectiveResult& f) -> void
+    {
+        const Index j = icolumns[k];
+
+        // Use the results of the batch evaluation of the current iteration only once
+        if(j >= 0)
+        {
+            icolumns[k] = -1;
+            return extract(F, j, f);
+        }
+
+        // Evaluate the objective function at the single point otherwise
+        ObjectiveBatchResult Fk;
+        Fk.requires = f.requires;
+        Fk.values.resize(1);
+        Fk.gradients.resize(x.size(), 1);
+        Fk.hessians.resize(f.requires.hessian ? 1 : 0);
+        objective(Indices::Constant(1, k), x, Fk);
+
+        extract(Fk, 0, f);
+    }
+
+    /// Extract the result of the objective function at the j-th point of a batch evaluation.
+    static auto extract(const ObjectiveBatchResult& batch, Index j, ObjectiveResult& f) -> void
+    {
+        f.value = batch.values[j];
+        f.gradient = batch.gradients.col(j);
+        if(f.requires.hessian)
+            f.hessian = batch.hessians[j];
+    }
+
+    /// Execute a function for each problem according to the current scheduling strategy.
+    auto runProblems(Index numproblems, const std::function<void(Index, Index)>& function) -> void
+    {
+        switch(scheduling) {
+        case BatchScheduling::Static: runStatic(numproblems, function); break;
+        case BatchScheduling::WorkStealing: runWorkStealing(numproblems, function); break;
+        }
+    }
+
+    /// Execute a function for each problem, with each worker processing a contiguous range of problems.
+    auto runStatic(Index numproblems, const std::function<void(Index, Index)>& function) -> void
+    {
+        const Index numworkers = solvers.size();
+
+        run([&](Index worker)
+        {
+            const Index begin = worker * numproblems / numworkers;
+            const Index end = (worker + 1) * numproblems / numworkers;
+            for(Index k = begin; k < end; ++k)
+                function(worker, k);
+        });
+    }
+
+    /// Execute a function for each problem, with workers that run out of problems stealing from the others.
+    auto runWorkStealing(Index numproblems, const std::function<void(Index, Index)>& function) -> void
+    {
+        const Index numworkers = solvers.size();
+
+        // Initialize the queue of each worker with a contiguous range of problems
+        for(Index i = 0; i < numworkers; ++i)
+        {
+            queues[i].begin = i * numproblems / numworkers;
+            queues[i].end = (i + 1) * numproblems / numworkers;
+        }
+
+        run([&](Index worker)
+        {
+            WorkQueue& queue = queues[worker];
+
+            while(true)
+            {
+                // Take the next problem from the front of the worker's own queue
+                Index k = -1;
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if(queue.begin < queue.end)
+                        k = queue.begin++;
+                }
+
+                // Steal half of the remaining problems of another worker if the own queue is empty
+                if(k < 0 && (k = steal(worker)) < 0)
+                    return;
+
+                function(worker, k);
+            }
+        });
+    }
+
+    /// Steal a chunk of problems from another worker, returning the first stolen problem (or -1 if there is none left).
+    /// The other stolen problems, if any, are moved to the queue of the given worker.
+    auto steal(Index worker) -> Index
+    {
+        const Index numworkers = solvers.size();
+
+        // Visit the other workers in a round-robin order, starting from the next one
+        for(Index offset = 1; offset < numworkers; ++offset)
+        {
+            WorkQueue& victim = queues[(worker + offset) % numworkers];
+
+            Index begin, end;
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                const Index remaining = victim.end - victim.begin;
+                if(remaining <= 0) continue;
+                begin = victim.end - (remaining + 1)/2;
+                end = victim.end;
+                victim.end = begin;
+            }
+
+            // Move the stolen problems, except the first one, to the queue of the given worker
+            WorkQueue& queue = queues[worker];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.begin = begin + 1;
+            queue.end = end;
+
+            return begin;
+        }
+
+        return -1;
+    }
+};
+
+OptimumBatchSolver::OptimumBatchSolver(const OptimumStructure& structure, Index numthreads)
+: pimpl(new Impl(structure, numthreads))
+{}
+
+OptimumBatchSolver::OptimumBatchSolver(const OptimumBatchSolver& other)
+: pimpl(new Impl(other.pimpl->structure, other.pimpl->solvers.size()))
+{
+    pimpl->setOptions(other.pimpl->options);
+    pimpl->scheduling = other.pimpl->scheduling;
+    pimpl->maxlockstep = other.pimpl->maxlockstep;
+}
+
+OptimumBatchSolver::~OptimumBatchSolver()
+{}
+
+auto OptimumBatchSolver::operator=(OptimumBatchSolver other) -> OptimumBatchSolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto OptimumBatchSolver::setOptions(const OptimumOptions& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto OptimumBatchSolver::setScheduling(BatchScheduling scheduling) -> void
+{
+    pimpl->scheduling = scheduling;
+}
+
+auto OptimumBatchSolver::scheduling() const -> BatchScheduling
+{
+    return pimpl->scheduling;
+}
+
+auto OptimumBatchSolver::setMaxLockstepProblems(Index size) -> void
+{
+    Assert(size > 0, "Could not set the maximum number of problems solved in lockstep.",
+        "The maximum number of problems must be positive.");
+    pimpl->maxlockstep = size;
+    if(Index(pimpl->lockstepsolvers.size()) > size)
+        pimpl->lockstepsolvers.erase(pimpl->lockstepsolvers.begin() + size, pimpl->lockstepsolvers.end());
+}
+
+auto OptimumBatchSolver::maxLockstepProblems() const -> Index
+{
+    return pimpl->maxlockstep;
+}
+
+auto OptimumBatchSolver::numThreads() const -> Index
+{
+    return pimpl->solvers.size();
+}
+
+auto OptimumBatchSolver::solve(const std::vector<OptimumParams>& params, std::vector<OptimumState>& states) -> std::vector<OptimumResult>
+{
+    return pimpl->solve(params, states);
+}
+
+auto OptimumBatchSolver::solve(const std::vector<OptimumParams>& params, const ObjectiveBatchFunction& objective, std::vector<OptimumState>& states) -> std::vector<OptimumResult>
+{
+    return pimpl->solve(params, objective, states);
+}
+
+} // namespace Optima
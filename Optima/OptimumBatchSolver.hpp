@@ -0,0 +1,121 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+#include <vector>
+
+// Optima includes
+#include <Optima/Objective.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class OptimumOptions;
+class OptimumParams;
+class OptimumResult;
+class OptimumState;
+class OptimumStructure;
+
+/// Used to describe the possible strategies for distributing optimization problems among threads.
+enum class BatchScheduling
+{
+    /// Each thread solves a contiguous range of problems of about the same size.
+    /// This strategy has the least overhead, but leaves threads idle when some
+    /// problems need many more iterations than others.
+    Static,
+
+    /// Each thread starts with a contiguous range of problems in its own queue, and
+    /// threads that run out of problems steal half of the remaining problems of another thread.
+    /// This strategy balances the load when problems need very different numbers of iterations.
+    WorkStealing,
+};
+
+/// Used to solve many optimization problems with the same structure in parallel.
+/// Each thread in the pool of threads of this class has its own OptimumSolver
+/// instance, which is reset before each problem to the state of a new solver with the
+/// current options. Thus, the result of each problem is the same regardless of the number
+/// of threads, the scheduling, and the problems solved before it, but no information of
+/// previous calculations is used (e.g., for predictions or warm starts of the canonical form).
+/// @note The objective functions of the problems are evaluated concurrently and must be thread-safe.
+class OptimumBatchSolver
+{
+public:
+    /// Construct an OptimumBatchSolver instance with given optimization structure.
+    /// @param structure The structure shared by all optimization problems.
+    /// @param numthreads The number of threads (zero to use the number of concurrent threads supported by the hardware).
+    OptimumBatchSolver(const OptimumStructure& structure, Index numthreads = 0);
+
+    /// Construct a copy of an OptimumBatchSolver instance.
+    OptimumBatchSolver(const OptimumBatchSolver& other);
+
+    /// Destroy this OptimumBatchSolver instance.
+    virtual ~OptimumBatchSolver();
+
+    /// Assign an OptimumBatchSolver instance to this.
+    auto operator=(OptimumBatchSolver other) -> OptimumBatchSolver&;
+
+    /// Set the options for the optimization calculations.
+    auto setOptions(const OptimumOptions& options) -> void;
+
+    /// Set the strategy for distributing the optimization problems among threads (default: BatchScheduling::WorkStealing).
+    auto setScheduling(BatchScheduling scheduling) -> void;
+
+    /// Return the strategy for distributing the optimization problems among threads.
+    auto scheduling() const -> BatchScheduling;
+
+    /// Set the maximum number of optimization problems solved at the same time in lockstep (default: 256).
+    /// Each problem being solved in lockstep needs its own OptimumSolver instance, so this bounds the memory
+    /// used by the lockstep calculations. The remaining problems begin as soon as others finish.
+    auto setMaxLockstepProblems(Index size) -> void;
+
+    /// Return the maximum number of optimization problems solved at the same time in lockstep.
+    auto maxLockstepProblems() const -> Index;
+
+    /// Return the number of threads used to solve the optimization problems.
+    auto numThreads() const -> Index;
+
+    /// Solve a batch of optimization problems in parallel.
+    /// @param params The parameters of each optimization problem.
+    /// @param states[in,out] The initial guess and the final state of each optimization problem.
+    /// @return The result of each optimization calculation.
+    auto solve(const std::vector<OptimumParams>& params, std::vector<OptimumState>& states) -> std::vector<OptimumResult>;
+
+    /// Solve a batch of optimization problems in lockstep, with their objective functions evaluated together.
+    /// At each iteration, the objective function is evaluated in a single call at the current
+    /// points of all problems being solved that have not yet finished, and then one iteration of
+    /// each of these problems is performed in parallel. At most @ref maxLockstepProblems problems
+    /// are solved at the same time, and the next ones begin as soon as others finish. This is useful
+    /// when the objective function is much faster when evaluated at many points at once (e.g., with vectorized models).
+    /// @note The objective functions in @p params are not used.
+    /// @note The batch objective function is called from the calling thread, except when a single point needs
+    /// @note to be evaluated outside the iterations, which can happen concurrently.
+    /// @param params The parameters of each optimization problem.
+    /// @param objective The objective function evaluated at many points at once.
+    /// @param states[in,out] The initial guess and the final state of each optimization problem.
+    /// @return The result of each optimization calculation.
+    auto solve(const std::vector<OptimumParams>& params, const ObjectiveBatchFunction& objective, std::vector<OptimumState>& states) -> std::vector<OptimumResult>;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -18,6 +18,7 @@
 #pragma once
 
 // C++ includes
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -66,6 +67,235 @@ struct OptimumOutputOptions : OutputterOptions
     auto operator=(bool active) -> OptimumOutputOptions&;
 };
 
+/// A type that describes the options for the prediction of solutions from previously calculated ones.
+/// When active, each converged calculation is stored together with its sensitivity derivatives with
+/// respect to \eq{b}. A new calculation then starts by predicting its solution from the stored one with
+/// closest \eq{b}, using a first-order Taylor extrapolation. The predicted solution is accepted if its
+/// residual error is below the given tolerance. Otherwise, a full calculation is performed and learned.
+/// The sensitivity derivatives of a predicted solution are lagged (see OptimumSolver::sensitivities).
+struct OptimumPredictionOptions
+{
+    /// The boolean flag that indicates if solutions should be predicted from previously calculated ones.
+    bool active = false;
+
+    /// The tolerance for the residual error of a predicted solution to be accepted.
+    double tolerance = 1.0e-6;
+
+    /// The maximum number of stored solutions used for predictions.
+    unsigned max_records = 1000;
+};
+
+/// A type that describes the options for the backtracking line search along the Newton steps.
+/// When active, the step length is reduced until the merit function, which combines the objective
+/// value and a penalty on the infeasibility of \eq{Ax = b}, decreases sufficiently (Armijo condition).
+/// Only the value of the objective function is evaluated at the trial iterates, so that its gradient
+/// and Hessian are computed only at the accepted ones.
+struct OptimumLineSearchOptions
+{
+    /// The boolean flag that indicates if the backtracking line search should be performed.
+    /// The trial iterates are evaluated with the objective function in OptimumParams, and the line search
+    /// is skipped if it is empty (e.g., in step-by-step calculations with evaluations given to OptimumSolver::step).
+    bool active = false;
+
+    /// The parameter of the sufficient decrease (Armijo) condition.
+    double armijo = 1.0e-4;
+
+    /// The factor by which the step length is reduced at each backtracking step.
+    double backtrack = 0.5;
+
+    /// The maximum number of backtracking steps, after which the last trial iterate is accepted.
+    unsigned max_backtracks = 10;
+};
+
+/// The available modes for the Hessian matrix of the objective function in the Newton steps.
+enum class HessianMode
+{
+    /// The Hessian matrix is evaluated by the objective function at every iteration.
+    Exact,
+
+    /// The Hessian matrix is approximated with a damped BFGS update of a dense matrix.
+    BFGS,
+
+    /// The Hessian matrix is approximated with the compact representation of a limited-memory BFGS update,
+    /// using only the most recent pairs of variations of \eq{x} and of the gradient.
+    LBFGS,
+
+    /// The Hessian matrix is approximated with a diagonal matrix updated to satisfy a weak secant condition.
+    DiagonalSecant,
+};
+
+/// A type that describes the options for the Hessian matrix of the objective function.
+/// In the quasi-Newton modes, the objective function is asked only for its value and gradient, and
+/// its Hessian matrix is approximated from the variation of the gradient along the iterations.
+/// These modes are ignored if the Hessian matrix is constant (see OptimumStructure). Sensitivity derivatives
+/// and predictions of solutions then use the approximated Hessian matrix of the last iteration.
+/// @note The quasi-Newton modes need BarrierMode::Monotone when starting from an initial guess at the bounds
+/// @note (e.g., the default zero initial guess of nonnegative variables), since their first approximations miss
+/// @note the large curvature of the objective function there. With the other barrier modes, an initial guess away
+/// @note from the bounds is needed (e.g., the solution of a similar problem).
+struct OptimumHessianOptions
+{
+    /// The mode for the Hessian matrix of the objective function.
+    HessianMode mode = HessianMode::Exact;
+
+    /// The number of most recent pairs of variations of \eq{x} and of the gradient used in the HessianMode::LBFGS mode.
+    unsigned memory = 5;
+
+    /// The parameter of the Powell damping, which keeps the Hessian approximation positive definite.
+    double damping = 0.2;
+};
+
+/// The available strategies for updating the barrier parameter along the iterations.
+enum class BarrierMode
+{
+    /// The barrier parameter is constant and equal to OptimumOptions::mu.
+    Fixed,
+
+    /// The barrier parameter is decreased (Fiacco-McCormick) whenever the residual of the barrier problem
+    /// becomes smaller than a multiple of the barrier parameter, until it reaches OptimumOptions::mu.
+    Monotone,
+
+    /// The barrier parameter is a fraction of the average complementarity of the current iterate (LOQO rule),
+    /// which depends on how far the smallest complementarity product is from the average one.
+    LOQO,
+};
+
+/// A type that describes the options for the barrier parameter of the interior-point method.
+/// In all modes, OptimumOptions::mu is the smallest barrier parameter used, and it is still used to
+/// keep the initial guess for \eq{x} strictly within the bounds.
+/// @see Wächter, A., Biegler, L. T. (2006). On the implementation of an interior-point filter line-search algorithm
+/// for large-scale nonlinear programming. Mathematical Programming, 106(1), 25–57.
+/// @see Vanderbei, R. J., Shanno, D. F. (1999). An interior-point algorithm for nonconvex nonlinear programming.
+/// Computational Optimization and Applications, 13(1), 231–252.
+struct OptimumBarrierOptions
+{
+    /// The strategy for updating the barrier parameter.
+    BarrierMode mode = BarrierMode::Fixed;
+
+    /// The initial barrier parameter in the BarrierMode::Monotone mode and the largest one in the BarrierMode::LOQO mode.
+    double initial = 0.01;
+
+    /// The factor of the linear decrease of the barrier parameter in the BarrierMode::Monotone mode.
+    double kappa = 0.2;
+
+    /// The exponent of the superlinear decrease of the barrier parameter in the BarrierMode::Monotone mode.
+    double theta = 1.5;
+
+    /// The multiple of the barrier parameter below which the residual of the barrier problem triggers a decrease in the BarrierMode::Monotone mode.
+    double kappa_epsilon = 10.0;
+};
+
+/// A type that describes the options for reusing the decomposition of the saddle point matrix across iterations.
+/// A new decomposition, together with a new evaluation of the Hessian matrix, is computed only every few
+/// iterations. In between, Newton steps are calculated with the last decomposition and with fresh gradients
+/// and residuals (a chord or lagged Newton method), which is accepted only while the residual error contracts
+/// sufficiently. Sensitivity derivatives are calculated with the last decomposition, which may then be lagged.
+struct OptimumReuseOptions
+{
+    /// The maximum number of iterations that use the same decomposition (1 for a new decomposition in every iteration).
+    unsigned period = 1;
+
+    /// The maximum ratio between the residual errors of consecutive iterations for reusing the last decomposition.
+    double contraction = 0.5;
+};
+
+/// A type that describes the options for stopping optimization calculations that cannot make further progress.
+/// The residual error of every iteration is compared with the smallest one found so far in the calculation.
+/// A calculation that neither improves on the smallest error nor changes the objective value for a number
+/// of iterations is regarded as stagnated (e.g., when the dual variables cycle while the primal ones are frozen).
+/// These calculations stop without success, with OptimumResult::status describing the reason, instead of
+/// spending all remaining iterations up to OptimumOptions::max_iterations.
+struct OptimumTerminationOptions
+{
+    /// The number of consecutive iterations without sufficient decrease of the smallest residual error and
+    /// without variation of the objective value after which the calculation stops as stagnated (0 to disable).
+    /// This is disabled by default, so that calculations run up to OptimumOptions::max_iterations unless this is set.
+    unsigned stagnation_iterations = 0;
+
+    /// The relative decrease of the smallest residual error regarded as sufficient progress.
+    double stagnation_decrease = 0.1;
+
+    /// The relative variation of the objective value regarded as progress, even if the residual error does not decrease.
+    double stagnation_objective = 1.0e-10;
+
+    /// The ratio between the current and the smallest residual errors above which the calculation
+    /// stops as diverged (0 to disable). This is disabled by default because the residual error of the
+    /// first iterations is not monotone when the barrier parameter is small. A calculation with a non-finite
+    /// residual error always stops as diverged.
+    double divergence_ratio = 0.0;
+
+    /// The number of consecutive iterations with diverging multipliers and without sufficient decrease of the
+    /// smallest feasibility error after which the calculation stops as infeasible (0 to disable).
+    /// This is disabled by default because the multipliers of variables approaching their bounds can also grow
+    /// large in feasible problems. Iterations whose step is shortened by the line search are not counted.
+    /// Independently of this option, a calculation stops as infeasible before its first iteration if vector b
+    /// is inconsistent with the linearly dependent rows of matrix A identified in its canonical form.
+    unsigned infeasibility_iterations = 0;
+
+    /// The ratio between the largest multiplier (in y, z and w) and the largest entry of the gradient
+    /// (plus one) above which the multipliers are regarded as diverging, as happens when the equality
+    /// constraints and the bounds have no solution.
+    double infeasibility_multiplier = 1.0e+10;
+};
+
+/// A type that describes the options for the automatic scaling of the optimization problem.
+/// The rows and columns of matrix A are equilibrated with Ruiz's method, so that their largest entries in absolute value
+/// become close to one, which also scales the variables \eq{x} and vector b. The objective function is scaled down if
+/// its gradient at the initial guess is too large. The calculation is then performed with the scaled problem, but the
+/// states and sensitivity derivatives are always returned unscaled. The scaling factors are powers of two, so that
+/// scaling and unscaling introduce no round-off errors. Note that the tolerances, and the residual errors in
+/// OptimumResult, then refer to the scaled problem.
+/// @see Ruiz, D. (2001). A scaling algorithm to equilibrate both rows and columns norms in matrices. Technical Report RAL-TR-2001-034.
+struct OptimumScalingOptions
+{
+    /// The boolean flag that indicates if the optimization problem should be scaled.
+    bool active = false;
+
+    /// The maximum number of passes of Ruiz's method over the rows and columns of matrix A.
+    unsigned passes = 10;
+
+    /// The largest entry in absolute value of the scaled gradient of the objective function at the initial guess (0 to not scale the objective function).
+    /// The scaling factor of the objective function is determined in the first calculation after the options are set.
+    double max_gradient = 100.0;
+};
+
+/// A type that describes the options for the presolve of the optimization problem.
+/// Before the calculation, the variables with fixed values or equal lower and upper bounds are removed from the problem,
+/// as well as the equality constraints without variables or with a single variable (whose value is then determined),
+/// and the forcing constraints, whose vector \eq{b} can only be attained with all their variables at their bounds (e.g.,
+/// a chemical element with zero amount). The smaller presolved problem is then calculated, and the state of the original
+/// problem is recovered from its solution. Note that the objective function must then be defined at the bounds of the
+/// variables fixed by forcing constraints, and that the derivatives of the multipliers of removed constraints and bounds
+/// in OptimumSensitivity are zero.
+/// @see OptimumPresolver
+struct OptimumPresolveOptions
+{
+    /// The boolean flag that indicates if the optimization problem should be presolved.
+    bool active = false;
+
+    /// The relative tolerance for regarding an equality constraint as forcing, i.e., with vector \eq{b} at the bound of its left-hand side.
+    double tolerance = 1.0e-12;
+};
+
+/// A type that describes the options for fixing the variables that remain at their bounds along the iterations.
+/// A variable in the partition z or w of IpSaddlePointSolver (i.e., at a bound with negligible slack relative to
+/// its multiplier) for a number of consecutive iterations with feasible iterates is fixed at its bound, and its
+/// multiplier is then determined from the optimality conditions only. The variable is released as soon as a step
+/// would change the sign of its multiplier, and it is not fixed again in the same calculation. This avoids the slow
+/// convergence of the variables to their bounds in problems with many of them at their bounds (e.g., chemical
+/// equilibrium problems with many absent species).
+/// @note This mostly benefits linear problems. In nonlinear problems (e.g., Gibbs energy minimization with the
+/// @note fixed barrier), it reduces the iterations of some calculations but considerably increases those of others,
+/// @note and may change which calculations converge, so it should be assessed for the problems at hand before use.
+struct OptimumActiveSetOptions
+{
+    /// The boolean flag that indicates if the variables at their bounds should be fixed along the iterations.
+    bool active = false;
+
+    /// The number of consecutive iterations in the partition z or w, with feasible iterates, after which a variable is fixed at its bound.
+    unsigned iterations = 5;
+};
+
 /// A type that describes the options of a optimization calculation
 class OptimumOptions
 {
@@ -91,9 +321,25 @@ public:
     /// The maximum number of iterations in the optimization calculations.
     unsigned max_iterations = 200;
 
+    /// The maximum wall time of each optimization calculation (in units of s, 0 for no limit).
+    /// The elapsed time is checked after the evaluation of the objective function, after the decomposition
+    /// of the saddle point matrix and after the update of the iterate. A calculation that exceeds it stops
+    /// without success with the iterate of smallest residual error found so far.
+    double max_time = 0.0;
+
+    /// The cooperative cancellation token of the optimization calculations.
+    /// This function, if given, is called at the same points as the check of `max_time`, and the calculation
+    /// stops without success with the iterate of smallest residual error found so far if it returns true.
+    /// It can be called from the thread of the calculation while another thread requests the
+    /// cancellation (e.g., by reading a `std::atomic<bool>` flag set by the other thread).
+    std::function<bool()> cancellation;
+
     /// The perturbation/barrier parameter for the interior-point method.
     double mu = 1.0e-20;
 
+    /// The options for updating the barrier parameter along the iterations.
+    OptimumBarrierOptions barrier;
+
     /// The fraction-to-the boundary parameter to relax the line-search backtracking step.
     /// This parameter should be carefully selected as it can mistakenly drive some
     /// primal variables prematurely to the bounds, keeping them trapped there until convergence.
@@ -103,8 +349,60 @@ public:
     /// The step mode for the Newton updates.
     StepMode step = Aggressive;
 
+    /// The boolean flag that indicates if Mehrotra's predictor-corrector steps should be used.
+    /// In this mode, an affine-scaling predictor step is calculated first, which determines an adaptive
+    /// centering parameter. The Newton step is then calculated with a corrector that accounts for the
+    /// second-order term of the complementarity conditions. Both steps use the same decomposition
+    /// of the KKT matrix, so that each iteration costs only one extra back-substitution. If the
+    /// barrier parameter is updated along the iterations (see OptimumBarrierOptions), it replaces the adaptive
+    /// centering parameter.
+    bool predictor_corrector = false;
+
+    /// The boolean flag that indicates if the calculation should be warm-started from the given state.
+    /// In this mode, the given dual variables z and w are kept, instead of being initialized from
+    /// the barrier parameter, unless they have improper signs. Moreover, if the given state is the
+    /// solution of the last calculation, the last decomposition of the KKT matrix is reused for
+    /// the first Newton step. This is useful when solving a sequence of problems that differ
+    /// slightly (e.g., only in vector b), in which the previous solution is a good initial guess.
+    bool warmstart = false;
+
     /// The options for the solution of the KKT equations.
     SaddlePointOptions kkt;
+
+    /// The options for the prediction of solutions from previously calculated ones.
+    OptimumPredictionOptions prediction;
+
+    /// The options for the backtracking line search along the Newton steps.
+    OptimumLineSearchOptions linesearch;
+
+    /// The options for the Hessian matrix of the objective function.
+    OptimumHessianOptions hessian;
+
+    /// The options for reusing the decomposition of the saddle point matrix across iterations.
+    OptimumReuseOptions reuse;
+
+    /// The options for stopping calculations that stagnate or diverge.
+    OptimumTerminationOptions termination;
+
+    /// The options for the automatic scaling of the optimization problem.
+    OptimumScalingOptions scaling;
+
+    /// The options for the presolve of the optimization problem.
+    OptimumPresolveOptions presolve;
+
+    /// The boolean flag that indicates if the calculation should be performed in the space of the non-basic variables only.
+    /// In this mode, the basic variables of the canonical form of matrix A are eliminated with \eq{x_b = R_b b - S x_n},
+    /// so that each Newton step solves a linear system with the reduced Hessian matrix of dimension \eq{n_n} only.
+    /// This mode is used only if the basic variables can be chosen among the variables without bounds and fixed
+    /// values (the calculation is otherwise performed in the full space). It is efficient for problems with few
+    /// non-basic variables (i.e., with nearly as many linearly independent equality constraints as variables).
+    /// Since the basic variables then follow every step of the non-basic ones exactly, the backtracking line
+    /// search (see OptimumLineSearchOptions) is recommended for objective functions that are strongly nonlinear.
+    /// @see OptimumReducer
+    bool reduced_space = false;
+
+    /// The options for fixing the variables that remain at their bounds along the iterations.
+    OptimumActiveSetOptions activeset;
 };
 
 } // namespace Optima
@@ -0,0 +1,411 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "OptimumPresolvedSolver.hpp"
+
+// C++ includes
+#include <cmath>
+#include <optional>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/Objective.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumPresolver.hpp>
+#include <Optima/OptimumResult.hpp>
+#include <Optima/OptimumSensitivity.hpp>
+#include <Optima/OptimumSolver.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+#include <Optima/Timing.hpp>
+#include <Optima/Utils.hpp>
+#include <Optima/VariantMatrix.hpp>
+
+namespace Optima {
+
+struct OptimumPresolvedSolver::Impl
+{
+    /// The structure of the original optimization problem.
+    OptimumStructure structure;
+
+    /// The options of the presolve and of the optimization calculations.
+    OptimumOptions options;
+
+    /// The presolver of the optimization problem.
+    OptimumPresolver presolver;
+
+    /// The optimization solver of the presolved problem, created in the first calculation.
+    std::optional<OptimumSolver> solver;
+
+    /// The indices of the variables and equality constraints in the problem of the optimization solver of the presolved problem.
+    Indices presolvedvariables, presolvedconstraints;
+
+    /// The parameters and state of the presolved problem in the current calculation.
+    OptimumParams presolvedparams;
+    OptimumState presolvedstate;
+
+    /// The evaluation of the objective function of the presolved problem given to the current step of the calculation.
+    ObjectiveResult fpresolved;
+
+    /// The evaluation of the objective function of the original problem.
+    ObjectiveResult f;
+
+    /// The variables x of the original problem at which the objective function is evaluated in the calculation.
+    Vector xpostsolved;
+
+    /// The block of the Hessian matrix at the solution with respect to the remaining and the dependent variables of the presolve.
+    Matrix hessiandependent;
+
+    /// The parameters and the state of the original problem in the current calculation.
+    const OptimumParams* pparams = nullptr;
+    OptimumState* pstate = nullptr;
+
+    /// The result of the current calculation.
+    OptimumResult result;
+
+    /// The time at which the current calculation began.
+    Time timestart;
+
+    /// The flag that indicates if the presolve of the current calculation succeeded (i.e., no infeasibility was found).
+    bool presolved = false;
+
+    /// The flag that indicates if the calculation of the presolved problem began and has not yet finished.
+    bool initialized = false;
+
+    /// The flag that indicates if the calculation of the presolved problem needs more iterations.
+    bool iterating = false;
+
+    /// The number of variables and equality constraints of the original problem.
+    Index n, m;
+
+    /// Construct an OptimumPresolvedSolver::Impl instance with given optimization structure.
+    Impl(const OptimumStructure& structure)
+    : structure(structure), presolver(structure)
+    {
+        n = structure.numVariables();
+        m = structure.numEqualityConstraints();
+        xpostsolved.resize(n);
+    }
+
+    /// Set the options of the presolve and of the optimization calculations of the presolved problem.
+    auto setOptions(const OptimumOptions& _options) -> void
+    {
+        options = _options;
+        presolver.setOptions(options);
+        if(solver)
+            solver->setOptions(solverOptions());
+    }
+
+    /// Return the options of the optimization solver of the presolved problem.
+    auto solverOptions() const -> OptimumOptions
+    {
+        OptimumOptions presolvedoptions = options;
+        presolvedoptions.presolve.active = false;
+
+        // The names of the remaining variables and equality constraints in the output
+        if(options.output.xnames.size() == std::size_t(n))
+        {
+            presolvedoptions.output.xnames.clear();
+            for(Index j : presolver.variables())
+                presolvedoptions.output.xnames.push_back(options.output.xnames[j]);
+        }
+        if(options.output.ynames.size() == std::size_t(m))
+        {
+            presolvedoptions.output.ynames.clear();
+            for(Index i : presolver.constraints())
+                presolvedoptions.output.ynames.push_back(options.output.ynames[i]);
+        }
+
+        return presolvedoptions;
+    }
+
+    /// Begin the calculation with the presolved problem.
+    auto begin(const OptimumParams& params, OptimumState& state) -> void
+    {
+        // Start timing the calculation
+        timestart = timenow();
+
+        // Store the parameters and the state of the calculation for the next steps
+        pparams = &params;
+        pstate = &state;
+
+        // Reset the result and the flags of the calculation
+        result = OptimumResult();
+        presolved = false;
+        initialized = false;
+        iterating = false;
+
+        // Finish the calculation if the equality constraints and the bounds were found to have no solution in the presolve
+        if(!presolver.presolve(params))
+        {
+            result.status = OptimumStatus::Infeasible;
+            return;
+        }
+
+        presolved = true;
+
+        IndicesConstRef ivariables = presolver.variables();
+        IndicesConstRef iconstraints = presolver.constraints();
+
+        // Finish the calculation if all variables were removed, since the presolve then determined the solution
+        if(ivariables.size() == 0)
+        {
+            presolvedstate = OptimumState();
+            presolver.postsolve(presolvedstate, state);
+            result.succeeded = true;
+            result.status = OptimumStatus::Converged;
+            return;
+        }
+
+        // Create the optimization solver of the presolved problem if its variables or equality constraints changed
+        // (otherwise, its stored solutions for predictions and warm-starting remain valid)
+        const bool changed = !solver ||
+            presolvedvariables.size() != ivariables.size() || !(presolvedvariables.array() == ivariables.array()).all() ||
+            presolvedconstraints.size() != iconstraints.size() || !(presolvedconstraints.array() == iconstraints.array()).all();
+
+        if(changed)
+        {
+            solver = OptimumSolver(presolver.structure());
+            solver->setOptions(solverOptions());
+            presolvedvariables = ivariables;
+            presolvedconstraints = iconstraints;
+        }
+
+        // Set the presolved parameters, with the objective function evaluated from the given one (if any)
+        presolvedparams = presolver.params();
+        presolvedparams.objective = nullptr;
+        if(params.objective)
+            presolvedparams.objective = [this](VectorConstRef x, ObjectiveResult& fx) { evaluate(x, fx); };
+
+        // Begin the calculation of the presolved problem from the given state
+        presolver.presolve(state, presolvedstate);
+        solver->begin(presolvedparams, presolvedstate);
+
+        initialized = true;
+        iterating = true;
+
+        postsolveState();
+    }
+
+    /// Evaluate the objective function of the presolved problem at given variables, with the objective function of the original problem.
+    auto evaluate(VectorConstRef x, ObjectiveResult& fx) -> void
+    {
+        presolver.postsolve(x, xpostsolved);
+
+        // Evaluate the objective function of the original problem with the same requirements
+        f.requires = fx.requires;
+        f.gradient.resize(n);
+        if(fx.requires.hessian) f.hessian.diagonal.resize(n);
+        if(fx.requires.hessian) f.hessian.dense.resize(n, n);
+        pparams->objective(xpostsolved, f);
+
+        presolver.presolve(f, fx);
+    }
+
+    /// Update the given state of the calculation with the postsolved state of the presolved problem.
+    auto postsolveState() -> void
+    {
+        presolver.postsolve(presolvedstate, *pstate);
+        result.succeeded = solver->converged();
+    }
+
+    /// Perform one iteration of the calculation of the presolved problem, with the given evaluation of the objective function (if any).
+    auto step(const ObjectiveResult* fx) -> bool
+    {
+        // Skip if the calculation has converged or the maximum number of iterations has been reached
+        if(!iterating)
+            return false;
+
+        // Perform the iteration with the evaluation of the objective function reduced to the remaining variables (if given)
+        if(fx) presolver.presolve(*fx, fpresolved);
+        iterating = fx ? solver->step(fpresolved) : solver->step();
+
+        postsolveState();
+
+        return iterating;
+    }
+
+    /// Finish the calculation of the presolved problem, and determine the multipliers of the removed constraints and bounds.
+    auto finish() -> OptimumResult
+    {
+        // No more iterations can be performed after the calculation has finished
+        iterating = false;
+
+        // Set the result of the calculation of the presolved problem (if it began)
+        if(initialized)
+        {
+            result = solver->finish();
+            initialized = false;
+        }
+
+        hessiandependent.resize(0, 0);
+
+        // Determine the multipliers of the removed constraints and bounds from the gradient of the objective function at the solution
+        if(presolved && pparams->objective)
+        {
+            // The Hessian matrix is also needed for the sensitivity derivatives if some removed variables depend on vector b
+            const bool hessian = presolver.dependentVariables().size() && !structure.hasConstantHessian() && options.hessian.mode == HessianMode::Exact;
+
+            f.requires.value = true;
+            f.requires.gradient = true;
+            f.requires.hessian = hessian;
+
+            Timer timer;
+            f.gradient.resize(n);
+            if(hessian) f.hessian.diagonal.resize(n);
+            if(hessian) f.hessian.dense.resize(n, n);
+            pparams->objective(pstate->x, f);
+
+            result.num_objective_evals += 1;
+            result.num_hessian_evals += hessian;
+            result.time_objective_evals += timer.elapsed();
+
+            if(std::isfinite(f.value) && f.gradient.allFinite())
+            {
+                presolver.postsolve(presolvedstate, f.gradient, *pstate);
+
+                if(structure.hasConstantHessian()) hessiandependent = dependentHessian(structure.constantHessian());
+                else if(hessian) hessiandependent = dependentHessian(f.hessian);
+            }
+        }
+
+        // Finish timing the calculation, including the presolve and postsolve
+        result.time = elapsed(timestart);
+
+        return result;
+    }
+
+    /// Return the block of the given Hessian matrix with respect to the remaining and the dependent variables of the presolve.
+    auto dependentHessian(VariantMatrixConstRef H) const -> Matrix
+    {
+        IndicesConstRef ivariables = presolver.variables();
+        IndicesConstRef idependent = presolver.dependentVariables();
+
+        // Diagonal and zero Hessian matrices have no entries with respect to distinct variables
+        if(H.structure == MatrixStructure::Dense)
+            return H.dense(ivariables, idependent);
+        return zeros(ivariables.size(), idependent.size());
+    }
+
+    /// Calculate the sensitivity derivatives of the solution with respect to parameters p using the presolved problem.
+    auto sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> void
+    {
+        // Assert the presolve of the last calculation succeeded
+        Assert(presolved, "Could not compute the sensitivity derivatives.",
+            "The equality constraints and the bounds were found to have no solution in the presolve.");
+
+        IndicesConstRef ivariables = presolver.variables();
+        IndicesConstRef iconstraints = presolver.constraints();
+        IndicesConstRef idependent = presolver.dependentVariables();
+
+        const Index np = std::max(dgdp.cols(), dbdp.cols());
+
+        // The derivatives of the removed variables, which depend on vector b only if determined by singleton constraints
+        const Matrix dxdpremoved = dbdp.size() ? presolver.derivatives(dbdp) : Matrix(zeros(n, np));
+
+        sensitivity.dxdp = dxdpremoved;
+        sensitivity.dydp = zeros(m, np);
+        sensitivity.dzdp = zeros(n, np);
+        sensitivity.dwdp = zeros(n, np);
+
+        // Skip if all variables were removed in the presolve
+        if(ivariables.size() == 0)
+            return;
+
+        // The derivatives of the gradient of the presolved problem, including the variation of the dependent variables
+        Matrix dgdppresolved = dgdp.size() ? Matrix(dgdp(ivariables, Eigen::all)) : Matrix(zeros(ivariables.size(), np));
+        if(idependent.size() && hessiandependent.size())
+            dgdppresolved += hessiandependent * dxdpremoved(idependent, Eigen::all);
+
+        // The derivatives of vector b of the presolved problem, without the contribution of the dependent variables
+        Matrix dbdppresolved;
+        if(dbdp.size())
+        {
+            const Matrix dbdpremaining = dbdp - structure.A * dxdpremoved;
+            dbdppresolved = dbdpremaining(iconstraints, Eigen::all);
+        }
+
+        // Calculate the sensitivity derivatives of the presolved problem, with zero derivatives for the multipliers of removed constraints and bounds
+        OptimumSensitivity presolvedsensitivity;
+        solver->sensitivities(dgdppresolved, dbdppresolved, presolvedsensitivity);
+
+        sensitivity.dxdp(ivariables, Eigen::all) = presolvedsensitivity.dxdp;
+        sensitivity.dydp(iconstraints, Eigen::all) = presolvedsensitivity.dydp;
+        sensitivity.dzdp(ivariables, Eigen::all) = presolvedsensitivity.dzdp;
+        sensitivity.dwdp(ivariables, Eigen::all) = presolvedsensitivity.dwdp;
+    }
+};
+
+OptimumPresolvedSolver::OptimumPresolvedSolver(const OptimumStructure& structure)
+: pimpl(new Impl(structure))
+{}
+
+OptimumPresolvedSolver::OptimumPresolvedSolver(const OptimumPresolvedSolver& other)
+{
+    // Assert the copy is not made during a calculation, whose presolved objective function refers to the copied instance
+    Assert(!other.pimpl->initialized, "Could not copy the optimization solver of the presolved problem.",
+        "A copy cannot be made between the calls to methods begin and finish.");
+
+    pimpl.reset(new Impl(*other.pimpl));
+}
+
+OptimumPresolvedSolver::~OptimumPresolvedSolver()
+{}
+
+auto OptimumPresolvedSolver::operator=(OptimumPresolvedSolver other) -> OptimumPresolvedSolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto OptimumPresolvedSolver::setOptions(const OptimumOptions& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto OptimumPresolvedSolver::begin(const OptimumParams& params, OptimumState& state) -> void
+{
+    pimpl->begin(params, state);
+}
+
+auto OptimumPresolvedSolver::step() -> bool
+{
+    return pimpl->step(nullptr);
+}
+
+auto OptimumPresolvedSolver::step(const ObjectiveResult& f) -> bool
+{
+    return pimpl->step(&f);
+}
+
+auto OptimumPresolvedSolver::converged() const -> bool
+{
+    return pimpl->result.succeeded;
+}
+
+auto OptimumPresolvedSolver::finish() -> OptimumResult
+{
+    return pimpl->finish();
+}
+
+auto OptimumPresolvedSolver::sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> void
+{
+    pimpl->sensitivities(dgdp, dbdp, sensitivity);
+}
+
+} // namespace Optima
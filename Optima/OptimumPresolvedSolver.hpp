@@ -0,0 +1,88 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class ObjectiveResult;
+class OptimumOptions;
+class OptimumParams;
+class OptimumResult;
+class OptimumSensitivity;
+class OptimumState;
+class OptimumStructure;
+
+/// Used to solve an optimization problem through its presolved problem, which is solved by an optimization solver of its own.
+/// The objective function of the presolved problem is evaluated with that of the original problem at the postsolved
+/// variables. The solution of the presolved problem is postsolved along the iterations, and the multipliers of the
+/// removed constraints and bounds are determined from the gradient of the objective function at the solution.
+/// @note A copy of an OptimumPresolvedSolver instance cannot be made between the calls to methods @ref begin and @ref finish.
+/// @see OptimumPresolver, OptimumPresolveOptions
+class OptimumPresolvedSolver
+{
+public:
+    /// Construct an OptimumPresolvedSolver instance with given optimization structure.
+    OptimumPresolvedSolver(const OptimumStructure& structure);
+
+    /// Construct a copy of an OptimumPresolvedSolver instance.
+    OptimumPresolvedSolver(const OptimumPresolvedSolver& other);
+
+    /// Destroy this OptimumPresolvedSolver instance.
+    virtual ~OptimumPresolvedSolver();
+
+    /// Assign an OptimumPresolvedSolver instance to this.
+    auto operator=(OptimumPresolvedSolver other) -> OptimumPresolvedSolver&;
+
+    /// Set the options of the presolve and of the optimization calculations of the presolved problem.
+    auto setOptions(const OptimumOptions& options) -> void;
+
+    /// Begin a step-by-step optimization calculation with the presolved problem.
+    /// @param params The parameters of the original optimization problem.
+    /// @param state[in,out] The initial guess and the current state of the original optimization problem.
+    auto begin(const OptimumParams& params, OptimumState& state) -> void;
+
+    /// Perform one iteration of the calculation of the presolved problem and return true if more iterations are needed.
+    auto step() -> bool;
+
+    /// Perform one iteration of the calculation of the presolved problem with the given evaluation of the objective function of the original problem at the current state.
+    auto step(const ObjectiveResult& f) -> bool;
+
+    /// Return true if the calculation has converged.
+    auto converged() const -> bool;
+
+    /// Finish the calculation and return its result, including the presolve and postsolve.
+    auto finish() -> OptimumResult;
+
+    /// Calculate the sensitivity derivatives of the solution of the original problem with respect to parameters \eq{p}.
+    /// @see OptimumSolver::sensitivities
+    auto sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> void;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
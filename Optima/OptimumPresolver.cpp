@@ -0,0 +1,568 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "OptimumPresolver.hpp"
+
+// C++ includes
+#include <cmath>
+#include <vector>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/Objective.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+namespace {
+
+/// The kinds of reductions of the optimization problem performed in the presolve.
+enum class ReductionKind
+{
+    /// A variable with fixed value in the structure of the problem.
+    FixedVariable,
+
+    /// A variable with equal lower and upper bounds.
+    FixedBounds,
+
+    /// An equality constraint without remaining variables.
+    EmptyConstraint,
+
+    /// An equality constraint with a single remaining variable, whose value is determined from vector b.
+    SingletonConstraint,
+
+    /// An equality constraint whose vector b is attained only with all its remaining variables at their bounds.
+    ForcingConstraint,
+};
+
+/// A reduction of the optimization problem, recorded in the order it was performed for the postsolve.
+struct Reduction
+{
+    /// The kind of the reduction.
+    ReductionKind kind;
+
+    /// The index of the removed equality constraint (if any).
+    Index constraint;
+
+    /// The indices of the removed variables.
+    std::vector<Index> variables;
+
+    /// The flag that indicates if vector b of the forcing constraint is at the minimum of its left-hand side (or at its maximum otherwise).
+    bool minimum;
+};
+
+/// Return true if the given vectors of indices are equal.
+auto equal(IndicesConstRef a, IndicesConstRef b) -> bool
+{
+    return a.size() == b.size() && (a.array() == b.array()).all();
+}
+
+} // namespace
+
+struct OptimumPresolver::Impl
+{
+    /// The structure of the original optimization problem.
+    OptimumStructure structure;
+
+    /// The structure of the presolved optimization problem.
+    OptimumStructure presolvedstructure;
+
+    /// The parameters of the presolved optimization problem.
+    OptimumParams presolvedparams;
+
+    /// The options for the presolve.
+    OptimumOptions options;
+
+    /// The indices of the variables and equality constraints that remain in the presolved problem.
+    Indices ivariables, iconstraints;
+
+    /// The indices of the removed variables whose values were determined from vector b.
+    Indices idependent;
+
+    /// The flags that indicate if each variable has lower and upper bounds in the original problem.
+    std::vector<bool> haslower, hasupper;
+
+    /// The flags that indicate if each variable and equality constraint remain in the presolved problem.
+    std::vector<bool> keptvariable, keptconstraint;
+
+    /// The values of the variables, with those of the removed ones determined in the presolve.
+    Vector x;
+
+    /// The lower and upper bounds of all variables (-inf and +inf for variables without bounds).
+    Vector xlower, xupper;
+
+    /// The right-hand side of the equality constraints after the removal of variables.
+    Vector r;
+
+    /// The scale of the right-hand side of the equality constraints, i.e., the sum of the absolute values of its terms.
+    Vector rscale;
+
+    /// The reductions performed in the presolve, in the order they were performed.
+    std::vector<Reduction> reductions;
+
+    /// The number of variables and equality constraints of the original problem.
+    Index n, m;
+
+    /// Construct an OptimumPresolver::Impl instance with given optimization structure.
+    Impl(const OptimumStructure& structure)
+    : structure(structure), presolvedstructure(0, 0)
+    {
+        n = structure.numVariables();
+        m = structure.numEqualityConstraints();
+
+        // Initialize the flags that indicate the variables with lower and upper bounds
+        haslower.assign(n, false);
+        hasupper.assign(n, false);
+        for(Index i : structure.variablesWithLowerBounds()) haslower[i] = true;
+        for(Index i : structure.variablesWithUpperBounds()) hasupper[i] = true;
+
+        // Allocate memory
+        x.resize(n);
+        xlower.resize(n);
+        xupper.resize(n);
+    }
+
+    /// Remove the given variable from the problem with given value.
+    auto fix(Index j, double value) -> void
+    {
+        x[j] = value;
+        keptvariable[j] = false;
+
+        // Move the contribution of the removed variable to the right-hand side of the equality constraints
+        if(value != 0.0)
+        {
+            r -= structure.A.col(j) * value;
+            rscale += structure.A.col(j).cwiseAbs() * std::abs(value);
+        }
+    }
+
+    /// Remove the given equality constraint if possible, and return false if it cannot be satisfied within the bounds.
+    auto reduce(Index i, bool& reduced) -> bool
+    {
+        const auto row = structure.A.row(i);
+
+        // The number of remaining variables in the constraint, the last one of them, and the minimum and maximum values of its left-hand side
+        Index count = 0, jlast = 0;
+        double minimum = 0.0, maximum = 0.0;
+        for(Index j = 0; j < n; ++j)
+        {
+            if(!keptvariable[j] || row[j] == 0.0)
+                continue;
+            ++count;
+            jlast = j;
+            minimum += row[j] > 0.0 ? row[j] * xlower[j] : row[j] * xupper[j];
+            maximum += row[j] > 0.0 ? row[j] * xupper[j] : row[j] * xlower[j];
+        }
+
+        // The tolerance for the feasibility of the equality constraint, as in the calculation
+        const double tolerance = options.tolerance;
+
+        // Remove the constraint without variables if it is satisfied
+        if(count == 0)
+        {
+            if(std::abs(r[i]) > tolerance)
+                return false;
+            reductions.push_back({ReductionKind::EmptyConstraint, i, {}, false});
+            keptconstraint[i] = false;
+            return reduced = true;
+        }
+
+        // Remove the constraint with a single variable, whose value is then determined (within its bounds)
+        if(count == 1)
+        {
+            const double a = row[jlast];
+            const double value = r[i] / a;
+            if((xlower[jlast] - value) * std::abs(a) > tolerance || (value - xupper[jlast]) * std::abs(a) > tolerance)
+                return false;
+            fix(jlast, std::max(xlower[jlast], std::min(value, xupper[jlast])));
+            reductions.push_back({ReductionKind::SingletonConstraint, i, {jlast}, false});
+            keptconstraint[i] = false;
+            return reduced = true;
+        }
+
+        // Check if vector b is beyond the minimum or maximum of the left-hand side of the constraint
+        if(r[i] < minimum - tolerance || r[i] > maximum + tolerance)
+            return false;
+
+        // Check if vector b is at the minimum or maximum of the left-hand side of the constraint, in which case all its variables are at their bounds
+        const double tolerancemin = options.presolve.tolerance * (rscale[i] + std::abs(minimum));
+        const double tolerancemax = options.presolve.tolerance * (rscale[i] + std::abs(maximum));
+        const bool atminimum = std::isfinite(minimum) && r[i] <= minimum + tolerancemin;
+        const bool atmaximum = std::isfinite(maximum) && r[i] >= maximum - tolerancemax;
+
+        if(!atminimum && !atmaximum)
+            return true;
+
+        // Remove the forcing constraint, with its variables fixed at the bounds that attain the minimum or maximum of its left-hand side
+        Reduction reduction = {ReductionKind::ForcingConstraint, i, {}, atminimum};
+        for(Index j = 0; j < n; ++j)
+        {
+            if(!keptvariable[j] || row[j] == 0.0)
+                continue;
+            fix(j, (row[j] > 0.0) == atminimum ? xlower[j] : xupper[j]);
+            reduction.variables.push_back(j);
+        }
+        reductions.push_back(reduction);
+        keptconstraint[i] = false;
+        return reduced = true;
+    }
+
+    /// Presolve the optimization problem with given parameters.
+    auto presolve(const OptimumParams& params) -> bool
+    {
+        // The indices of variables with lower/upper bounds and fixed values
+        IndicesConstRef ilower = structure.variablesWithLowerBounds();
+        IndicesConstRef iupper = structure.variablesWithUpperBounds();
+        IndicesConstRef ifixed = structure.variablesWithFixedValues();
+
+        // Initialize the lower and upper bounds of all variables
+        xlower.fill(-infinity());
+        xupper.fill(infinity());
+        xlower(ilower) = params.xlower;
+        xupper(iupper) = params.xupper;
+
+        // Initialize the right-hand side of the equality constraints and its scale
+        r = params.b;
+        rscale = params.b.cwiseAbs();
+
+        // Initialize the variables and equality constraints, all of them remaining in the problem
+        x.fill(0.0);
+        keptvariable.assign(n, true);
+        keptconstraint.assign(m, true);
+        reductions.clear();
+
+        // Remove the variables with fixed values
+        for(Index k = 0; k < ifixed.size(); ++k)
+        {
+            fix(ifixed[k], params.xfixed[k]);
+            reductions.push_back({ReductionKind::FixedVariable, 0, {ifixed[k]}, false});
+        }
+
+        // Remove the variables with equal lower and upper bounds, and check for bounds without values between them
+        for(Index j = 0; j < n; ++j)
+        {
+            if(!keptvariable[j])
+                continue;
+            if(xlower[j] > xupper[j])
+                return false;
+            if(xlower[j] == xupper[j])
+            {
+                fix(j, xlower[j]);
+                reductions.push_back({ReductionKind::FixedBounds, 0, {j}, false});
+            }
+        }
+
+        // Remove the empty, singleton and forcing constraints until no more reduction is possible
+        bool reduced = true;
+        while(reduced)
+        {
+            reduced = false;
+            for(Index i = 0; i < m; ++i)
+                if(keptconstraint[i] && !reduce(i, reduced))
+                    return false;
+        }
+
+        // Update the structure and parameters of the presolved problem
+        update();
+
+        return true;
+    }
+
+    /// Update the structure (if its variables or equality constraints changed) and the parameters of the presolved problem.
+    auto update() -> void
+    {
+        // The indices of the remaining variables and equality constraints
+        const Indices jvariables = indicesOf(keptvariable);
+        const Indices jconstraints = indicesOf(keptconstraint);
+
+        // The indices of the removed variables determined from vector b
+        idependent.resize(reductions.size());
+        Index ndependent = 0;
+        for(const Reduction& reduction : reductions)
+            if(reduction.kind == ReductionKind::SingletonConstraint)
+                idependent[ndependent++] = reduction.variables.front();
+        idependent.conservativeResize(ndependent);
+
+        // Update the structure of the presolved problem only if its variables or equality constraints changed
+        if(!equal(jvariables, ivariables) || !equal(jconstraints, iconstraints))
+        {
+            ivariables = jvariables;
+            iconstraints = jconstraints;
+
+            const Index np = ivariables.size();
+            const Index mp = iconstraints.size();
+
+            presolvedstructure = OptimumStructure(np, mp);
+            presolvedstructure.A = structure.A(iconstraints, ivariables);
+
+            // The indices of the remaining variables with lower and upper bounds, with respect to the presolved problem
+            std::vector<bool> keptlower(np), keptupper(np);
+            for(Index k = 0; k < np; ++k) keptlower[k] = haslower[ivariables[k]];
+            for(Index k = 0; k < np; ++k) keptupper[k] = hasupper[ivariables[k]];
+            presolvedstructure.setVariablesWithLowerBounds(indicesOf(keptlower));
+            presolvedstructure.setVariablesWithUpperBounds(indicesOf(keptupper));
+
+            // The constant Hessian matrix restricted to the remaining variables
+            if(structure.hasConstantHessian())
+            {
+                VariantMatrixConstRef H = structure.constantHessian();
+                switch(H.structure) {
+                case MatrixStructure::Dense: presolvedstructure.setConstantHessianDense(H.dense(ivariables, ivariables)); break;
+                case MatrixStructure::Diagonal: presolvedstructure.setConstantHessianDiagonal(H.diagonal(ivariables)); break;
+                case MatrixStructure::Zero: presolvedstructure.setConstantHessianZero(); break;
+                }
+            }
+        }
+
+        // The parameters of the presolved problem, with the contribution of the removed variables in vector b
+        const Indices ilower = ivariables(presolvedstructure.variablesWithLowerBounds());
+        const Indices iupper = ivariables(presolvedstructure.variablesWithUpperBounds());
+        presolvedparams.b = r(iconstraints);
+        presolvedparams.xlower = xlower(ilower);
+        presolvedparams.xupper = xupper(iupper);
+        presolvedparams.xfixed.resize(0);
+    }
+
+    /// Return the indices of the entries with true value.
+    static auto indicesOf(const std::vector<bool>& flags) -> Indices
+    {
+        Indices inds(flags.size());
+        Index size = 0;
+        for(Index i = 0; i < Index(flags.size()); ++i)
+            if(flags[i]) inds[size++] = i;
+        inds.conservativeResize(size);
+        return inds;
+    }
+
+    /// Set the state of the presolved problem from a state of the original problem.
+    auto presolve(const OptimumState& state, OptimumState& presolvedstate) const -> void
+    {
+        presolvedstate.x = state.x.size() == n ? Vector(state.x(ivariables)) : Vector();
+        presolvedstate.y = state.y.size() == m ? Vector(state.y(iconstraints)) : Vector();
+        presolvedstate.z = state.z.size() == n ? Vector(state.z(ivariables)) : Vector();
+        presolvedstate.w = state.w.size() == n ? Vector(state.w(ivariables)) : Vector();
+    }
+
+    /// Set the evaluation of the objective function of the presolved problem (only the evaluated parts according to its requirements).
+    auto presolve(const ObjectiveResult& f, ObjectiveResult& presolvedf) const -> void
+    {
+        presolvedf.requires = f.requires;
+        presolvedf.failed = f.failed;
+
+        if(f.requires.value)
+            presolvedf.value = f.value;
+
+        if(f.requires.gradient)
+            presolvedf.gradient = f.gradient(ivariables);
+
+        if(f.requires.hessian)
+        {
+            const Index np = ivariables.size();
+            switch(f.hessian.structure) {
+            case MatrixStructure::Dense: presolvedf.hessian.setDense(np); presolvedf.hessian.dense = f.hessian.dense(ivariables, ivariables); break;
+            case MatrixStructure::Diagonal: presolvedf.hessian.setDiagonal(np); presolvedf.hessian.diagonal = f.hessian.diagonal(ivariables); break;
+            case MatrixStructure::Zero: presolvedf.hessian.setZero(); break;
+            }
+        }
+    }
+
+    /// Set the variables x of the original problem from those of the presolved problem.
+    auto postsolve(VectorConstRef presolvedx, VectorRef xfull) const -> void
+    {
+        xfull = x;
+        xfull(ivariables) = presolvedx;
+    }
+
+    /// Set the state of the original problem, with zero multipliers for the removed constraints and bounds.
+    auto postsolve(const OptimumState& presolvedstate, OptimumState& state) const -> void
+    {
+        state.x.resize(n);
+        postsolve(presolvedstate.x, state.x);
+
+        state.y = zeros(m);
+        state.z = zeros(n);
+        state.w = zeros(n);
+
+        if(presolvedstate.y.size()) state.y(iconstraints) = presolvedstate.y;
+        if(presolvedstate.z.size()) state.z(ivariables) = presolvedstate.z;
+        if(presolvedstate.w.size()) state.w(ivariables) = presolvedstate.w;
+    }
+
+    /// Set the state of the original problem, with the multipliers of the removed constraints and bounds determined from the gradient g.
+    auto postsolve(const OptimumState& presolvedstate, VectorConstRef g, OptimumState& state) const -> void
+    {
+        postsolve(presolvedstate, state);
+
+        MatrixConstRef A = structure.A;
+        VectorRef y = state.y;
+        VectorRef z = state.z;
+        VectorRef w = state.w;
+
+        // The residual of the optimality condition g + tr(A)*y - z - w = 0 for variable j without its z and w
+        auto residual = [&](Index j) { return g[j] + A.col(j).dot(y); };
+
+        // Undo the reductions in reverse order, so that the multipliers of the constraints removed later are known
+        for(auto reduction = reductions.rbegin(); reduction != reductions.rend(); ++reduction)
+        {
+            const Index i = reduction->constraint;
+            switch(reduction->kind) {
+            case ReductionKind::FixedVariable:
+                break;
+            case ReductionKind::FixedBounds:
+            {
+                // The multiplier of the active bound of the variable has the sign of the residual
+                const Index j = reduction->variables.front();
+                const double s = residual(j);
+                if(s >= 0.0) z[j] = s; else w[j] = s;
+                break;
+            }
+            case ReductionKind::EmptyConstraint:
+                y[i] = 0.0;
+                break;
+            case ReductionKind::SingletonConstraint:
+            {
+                // The multiplier of the constraint that satisfies the optimality condition of its single variable
+                const Index j = reduction->variables.front();
+                y[i] = -residual(j) / A(i, j);
+                break;
+            }
+            case ReductionKind::ForcingConstraint:
+            {
+                // The multiplier of the constraint that gives multipliers z and w with proper signs for all its variables, the
+                // smallest one if vector b is at the minimum of the left-hand side, and the largest one if at its maximum
+                double yi = reduction->minimum ? -infinity() : infinity();
+                for(Index j : reduction->variables)
+                    yi = reduction->minimum ? std::max(yi, -residual(j) / A(i, j)) : std::min(yi, -residual(j) / A(i, j));
+                y[i] = yi;
+                for(Index j : reduction->variables)
+                {
+                    const double s = residual(j);
+                    if((A(i, j) > 0.0) == reduction->minimum) z[j] = s; else w[j] = s;
+                }
+                break;
+            }
+            }
+        }
+    }
+
+    /// Return the derivatives of the removed variables with respect to parameters.
+    auto derivatives(MatrixConstRef dbdp) const -> Matrix
+    {
+        MatrixConstRef A = structure.A;
+
+        Matrix dxdp = zeros(n, dbdp.cols());
+
+        // Only the variables determined by singleton constraints depend on b, possibly through those removed before them
+        for(const Reduction& reduction : reductions)
+        {
+            if(reduction.kind != ReductionKind::SingletonConstraint)
+                continue;
+            const Index i = reduction.constraint;
+            const Index j = reduction.variables.front();
+            dxdp.row(j) = (dbdp.row(i) - A.row(i) * dxdp) / A(i, j);
+        }
+
+        return dxdp;
+    }
+};
+
+OptimumPresolver::OptimumPresolver(const OptimumStructure& structure)
+: pimpl(new Impl(structure))
+{}
+
+OptimumPresolver::OptimumPresolver(const OptimumPresolver& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+OptimumPresolver::~OptimumPresolver()
+{}
+
+auto OptimumPresolver::operator=(OptimumPresolver other) -> OptimumPresolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto OptimumPresolver::setOptions(const OptimumOptions& options) -> void
+{
+    pimpl->options = options;
+}
+
+auto OptimumPresolver::presolve(const OptimumParams& params) -> bool
+{
+    return pimpl->presolve(params);
+}
+
+auto OptimumPresolver::structure() const -> const OptimumStructure&
+{
+    return pimpl->presolvedstructure;
+}
+
+auto OptimumPresolver::params() const -> const OptimumParams&
+{
+    return pimpl->presolvedparams;
+}
+
+auto OptimumPresolver::variables() const -> IndicesConstRef
+{
+    return pimpl->ivariables;
+}
+
+auto OptimumPresolver::constraints() const -> IndicesConstRef
+{
+    return pimpl->iconstraints;
+}
+
+auto OptimumPresolver::dependentVariables() const -> IndicesConstRef
+{
+    return pimpl->idependent;
+}
+
+auto OptimumPresolver::presolve(const OptimumState& state, OptimumState& presolvedstate) const -> void
+{
+    pimpl->presolve(state, presolvedstate);
+}
+
+auto OptimumPresolver::presolve(const ObjectiveResult& f, ObjectiveResult& presolvedf) const -> void
+{
+    pimpl->presolve(f, presolvedf);
+}
+
+auto OptimumPresolver::postsolve(VectorConstRef presolvedx, VectorRef x) const -> void
+{
+    pimpl->postsolve(presolvedx, x);
+}
+
+auto OptimumPresolver::postsolve(const OptimumState& presolvedstate, OptimumState& state) const -> void
+{
+    pimpl->postsolve(presolvedstate, state);
+}
+
+auto OptimumPresolver::postsolve(const OptimumState& presolvedstate, VectorConstRef g, OptimumState& state) const -> void
+{
+    pimpl->postsolve(presolvedstate, g, state);
+}
+
+auto OptimumPresolver::derivatives(MatrixConstRef dbdp) const -> Matrix
+{
+    return pimpl->derivatives(dbdp);
+}
+
+} // namespace Optima
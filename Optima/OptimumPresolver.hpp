@@ -0,0 +1,109 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class ObjectiveResult;
+class OptimumOptions;
+class OptimumParams;
+class OptimumState;
+class OptimumStructure;
+
+/// Used to reduce an optimization problem before its calculation, and to recover the solution of the original problem afterwards.
+/// The presolve removes the variables with fixed values (including those with equal lower and upper bounds), the equality
+/// constraints without variables, the equality constraints with a single variable (whose value is then determined), and
+/// the forcing constraints, which can only be satisfied with all their variables at their bounds. These reductions
+/// are repeated until no more is possible, and constraints that cannot be satisfied within the bounds are detected.
+/// The postsolve recovers the state of the original problem, including the multipliers of the removed constraints and
+/// bounds, which are determined from the gradient of the objective function at the solution.
+/// @see OptimumPresolveOptions
+class OptimumPresolver
+{
+public:
+    /// Construct an OptimumPresolver instance with given optimization structure.
+    OptimumPresolver(const OptimumStructure& structure);
+
+    /// Construct a copy of an OptimumPresolver instance.
+    OptimumPresolver(const OptimumPresolver& other);
+
+    /// Destroy this OptimumPresolver instance.
+    virtual ~OptimumPresolver();
+
+    /// Assign an OptimumPresolver instance to this.
+    auto operator=(OptimumPresolver other) -> OptimumPresolver&;
+
+    /// Set the options for the presolve.
+    auto setOptions(const OptimumOptions& options) -> void;
+
+    /// Presolve the optimization problem with given parameters.
+    /// @return `false` if the equality constraints and the bounds were found to have no solution.
+    auto presolve(const OptimumParams& params) -> bool;
+
+    /// Return the structure of the presolved problem, which has no variable with fixed values.
+    auto structure() const -> const OptimumStructure&;
+
+    /// Return the parameters of the presolved problem, without objective function.
+    auto params() const -> const OptimumParams&;
+
+    /// Return the indices of the variables of the original problem that remain in the presolved problem.
+    auto variables() const -> IndicesConstRef;
+
+    /// Return the indices of the equality constraints of the original problem that remain in the presolved problem.
+    auto constraints() const -> IndicesConstRef;
+
+    /// Return the indices of the removed variables whose values were determined from vector \eq{b} (i.e., by singleton constraints).
+    auto dependentVariables() const -> IndicesConstRef;
+
+    /// Set the state of the presolved problem from a state of the original problem (e.g., an initial guess).
+    /// The given state is ignored if its dimensions are inconsistent with those of the original problem.
+    auto presolve(const OptimumState& state, OptimumState& presolvedstate) const -> void;
+
+    /// Set the evaluation of the objective function of the presolved problem from one of the original problem.
+    auto presolve(const ObjectiveResult& f, ObjectiveResult& presolvedf) const -> void;
+
+    /// Set the variables \eq{x} of the original problem from those of the presolved problem.
+    auto postsolve(VectorConstRef presolvedx, VectorRef x) const -> void;
+
+    /// Set the state of the original problem from that of the presolved problem, with zero multipliers for the removed constraints and bounds.
+    auto postsolve(const OptimumState& presolvedstate, OptimumState& state) const -> void;
+
+    /// Set the state of the original problem from that of the presolved problem, with the multipliers of the removed
+    /// constraints and bounds determined from the given gradient of the objective function at the postsolved \eq{x}.
+    auto postsolve(const OptimumState& presolvedstate, VectorConstRef g, OptimumState& state) const -> void;
+
+    /// Return the derivatives of the variables removed in the presolve with respect to parameters.
+    /// Only the rows corresponding to the @ref dependentVariables are non-zero.
+    /// @param dbdp The derivatives of vector \eq{b} with respect to the parameters.
+    auto derivatives(MatrixConstRef dbdp) const -> Matrix;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
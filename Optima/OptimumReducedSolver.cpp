@@ -0,0 +1,379 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "OptimumReducedSolver.hpp"
+
+// C++ includes
+#include <cmath>
+#include <optional>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/Objective.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumReducer.hpp>
+#include <Optima/OptimumResult.hpp>
+#include <Optima/OptimumSensitivity.hpp>
+#include <Optima/OptimumSolver.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+#include <Optima/Timing.hpp>
+#include <Optima/Utils.hpp>
+#include <Optima/VariantMatrix.hpp>
+
+namespace Optima {
+
+struct OptimumReducedSolver::Impl
+{
+    /// The structure of the original optimization problem.
+    OptimumStructure structure;
+
+    /// The options of the reduction and of the optimization calculations.
+    OptimumOptions options;
+
+    /// The reducer of the optimization problem to the space of its non-basic variables.
+    OptimumReducer reducer;
+
+    /// The optimization solver of the reduced problem, created in the first calculation.
+    std::optional<OptimumSolver> solver;
+
+    /// The parameters and state of the reduced problem in the current calculation.
+    OptimumParams reducedparams;
+    OptimumState reducedstate;
+
+    /// The evaluation of the objective function of the reduced problem given to the current step of the calculation.
+    ObjectiveResult freduced;
+
+    /// The last evaluation of the objective function of the original problem, whose gradient determines the multipliers y.
+    ObjectiveResult f;
+
+    /// The variables x of the original problem at which the objective function is evaluated in the calculation.
+    Vector xrecovered;
+
+    /// The Hessian matrix at the solution of the calculation (empty if not available).
+    Matrix hessiansolution;
+
+    /// The parameters and the state of the original problem in the current calculation.
+    const OptimumParams* pparams = nullptr;
+    OptimumState* pstate = nullptr;
+
+    /// The result of the current calculation.
+    OptimumResult result;
+
+    /// The time at which the current calculation began.
+    Time timestart;
+
+    /// The flag that indicates if the reduction of the current calculation succeeded (i.e., vector b is consistent).
+    bool reduced = false;
+
+    /// The flag that indicates if the calculation of the reduced problem began and has not yet finished.
+    bool initialized = false;
+
+    /// The flag that indicates if the calculation of the reduced problem needs more iterations.
+    bool iterating = false;
+
+    /// The number of variables of the original problem.
+    Index n;
+
+    /// Construct an OptimumReducedSolver::Impl instance with given optimization structure.
+    Impl(const OptimumStructure& structure)
+    : structure(structure), reducer(structure)
+    {
+        n = structure.numVariables();
+        xrecovered.resize(n);
+    }
+
+    /// Set the options of the reduction and of the optimization calculations of the reduced problem.
+    auto setOptions(const OptimumOptions& _options) -> void
+    {
+        options = _options;
+        reducer.setOptions(options);
+        if(solver)
+            solver->setOptions(solverOptions());
+    }
+
+    /// Return the options of the optimization solver of the reduced problem.
+    auto solverOptions() const -> OptimumOptions
+    {
+        OptimumOptions reducedoptions = options;
+        reducedoptions.reduced_space = false;
+
+        // Predictions are not used, since the reduced problem has no vector b with respect to which solutions are stored
+        reducedoptions.prediction.active = false;
+
+        // The names of the non-basic variables in the output, without equality constraints
+        if(options.output.xnames.size() == std::size_t(n))
+        {
+            reducedoptions.output.xnames.clear();
+            for(Index j : reducer.nonBasicVariables())
+                reducedoptions.output.xnames.push_back(options.output.xnames[j]);
+        }
+        reducedoptions.output.ynames.clear();
+
+        return reducedoptions;
+    }
+
+    /// Begin the calculation in the space of the non-basic variables.
+    auto begin(const OptimumParams& params, OptimumState& state) -> void
+    {
+        // Start timing the calculation
+        timestart = timenow();
+
+        // Store the parameters and the state of the calculation for the next steps
+        pparams = &params;
+        pstate = &state;
+
+        // Reset the result and the flags of the calculation
+        result = OptimumResult();
+        reduced = false;
+        initialized = false;
+        iterating = false;
+
+        // Finish the calculation if vector b is inconsistent with the linearly dependent rows of matrix A
+        if(!reducer.reduce(params))
+        {
+            result.status = OptimumStatus::Infeasible;
+            return;
+        }
+
+        reduced = true;
+
+        // Create the optimization solver of the reduced problem in the first calculation
+        if(!solver)
+        {
+            solver = OptimumSolver(reducer.structure());
+            solver->setOptions(solverOptions());
+        }
+
+        // Set the reduced parameters, with the objective function evaluated from the given one (if any)
+        reducedparams = reducer.params();
+        reducedparams.objective = nullptr;
+        if(params.objective)
+            reducedparams.objective = [this](VectorConstRef x, ObjectiveResult& fx) { evaluate(x, fx); };
+
+        // Begin the calculation of the reduced problem from the given state, without the gradient of the last calculation
+        f.gradient.resize(0);
+        reducer.reduce(state, reducedstate);
+        solver->begin(reducedparams, reducedstate);
+
+        initialized = true;
+        iterating = true;
+
+        recoverState();
+    }
+
+    /// Evaluate the objective function of the reduced problem at given non-basic variables, with the objective function of the original problem.
+    auto evaluate(VectorConstRef x, ObjectiveResult& fx) -> void
+    {
+        reducer.recover(x, xrecovered);
+
+        // Evaluate the objective function of the original problem with the same requirements
+        f.requires = fx.requires;
+        f.gradient.resize(n);
+        if(fx.requires.hessian) f.hessian.diagonal.resize(n);
+        if(fx.requires.hessian) f.hessian.dense.resize(n, n);
+        pparams->objective(xrecovered, f);
+
+        reducer.reduce(f, fx);
+    }
+
+    /// Update the given state of the calculation with the state of the reduced problem, and the multipliers y from the last evaluated gradient.
+    auto recoverState() -> void
+    {
+        reducer.recover(reducedstate, f.gradient, *pstate);
+        result.succeeded = solver->converged();
+    }
+
+    /// Perform one iteration of the calculation of the reduced problem, with the given evaluation of the objective function (if any).
+    auto step(const ObjectiveResult* fx) -> bool
+    {
+        // Skip if the calculation has converged or the maximum number of iterations has been reached
+        if(!iterating)
+            return false;
+
+        // Perform the iteration with the evaluation of the objective function reduced to the non-basic variables (if given)
+        if(fx) reducer.reduce(*fx, freduced);
+        if(fx) f.gradient = fx->gradient;
+        iterating = fx ? solver->step(freduced) : solver->step();
+
+        recoverState();
+
+        return iterating;
+    }
+
+    /// Finish the calculation of the reduced problem, and determine the multipliers y from the gradient of the objective function at the solution.
+    auto finish() -> OptimumResult
+    {
+        // No more iterations can be performed after the calculation has finished
+        iterating = false;
+
+        // Set the result of the calculation of the reduced problem (if it began)
+        if(initialized)
+        {
+            result = solver->finish();
+            initialized = false;
+        }
+
+        hessiansolution.resize(0, 0);
+
+        // Evaluate the objective function at the solution, whose gradient determines the multipliers y
+        if(reduced && pparams->objective)
+        {
+            // The Hessian matrix is also needed for the sensitivity derivatives, since the basic variables depend on vector b
+            const bool hessian = !structure.hasConstantHessian() && options.hessian.mode == HessianMode::Exact;
+
+            f.requires.value = true;
+            f.requires.gradient = true;
+            f.requires.hessian = hessian;
+
+            Timer timer;
+            f.gradient.resize(n);
+            if(hessian) f.hessian.diagonal.resize(n);
+            if(hessian) f.hessian.dense.resize(n, n);
+            pparams->objective(pstate->x, f);
+
+            result.num_objective_evals += 1;
+            result.num_hessian_evals += hessian;
+            result.time_objective_evals += timer.elapsed();
+
+            if(std::isfinite(f.value) && f.gradient.allFinite())
+            {
+                reducer.recover(reducedstate, f.gradient, *pstate);
+
+                if(structure.hasConstantHessian()) hessiansolution = denseHessian(structure.constantHessian());
+                else if(hessian) hessiansolution = denseHessian(f.hessian);
+            }
+        }
+
+        // Finish timing the calculation, including the reduction and the recovery of the basic variables
+        result.time = elapsed(timestart);
+
+        return result;
+    }
+
+    /// Return the given Hessian matrix as a dense matrix.
+    auto denseHessian(VariantMatrixConstRef H) const -> Matrix
+    {
+        switch(H.structure) {
+        case MatrixStructure::Dense: return H.dense;
+        case MatrixStructure::Diagonal: return H.diagonal.asDiagonal();
+        default: return zeros(n, n);
+        }
+    }
+
+    /// Calculate the sensitivity derivatives of the solution with respect to parameters p using the reduced problem.
+    auto sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> void
+    {
+        // Assert the reduction of the last calculation succeeded
+        Assert(reduced, "Could not compute the sensitivity derivatives.",
+            "Vector b was found to be inconsistent with the linearly dependent rows of matrix A.");
+
+        IndicesConstRef inonbasic = reducer.nonBasicVariables();
+
+        const Index nn = inonbasic.size();
+        const Index np = std::max(dgdp.cols(), dbdp.cols());
+
+        // The derivatives of the gradient, and the derivatives of x at fixed non-basic variables (which vary with vector b through the basic variables)
+        const Matrix dgdpfull = dgdp.size() ? Matrix(dgdp) : Matrix(zeros(n, np));
+        const Matrix dxdpbasic = reducer.derivatives(zeros(nn, np), dbdp);
+
+        // The derivatives of the reduced gradient, including the variation of the basic variables (if the Hessian matrix is available)
+        const Matrix dgdpreduced = hessiansolution.size() ?
+            reducer.reducedGradient(dgdpfull + hessiansolution * dxdpbasic) :
+            reducer.reducedGradient(dgdpfull);
+
+        // Calculate the sensitivity derivatives of the reduced problem, which has no equality constraints
+        OptimumSensitivity reducedsensitivity;
+        if(nn > 0) solver->sensitivities(dgdpreduced, Matrix(), reducedsensitivity);
+        else reducedsensitivity.dxdp = reducedsensitivity.dzdp = reducedsensitivity.dwdp = zeros(0, np);
+
+        // Recover the derivatives of the basic variables, and those of the multipliers y from the derivatives of the gradient at the solution
+        sensitivity.dxdp = reducer.derivatives(reducedsensitivity.dxdp, dbdp);
+        sensitivity.dydp = hessiansolution.size() ?
+            reducer.multipliers(dgdpfull + hessiansolution * sensitivity.dxdp) :
+            reducer.multipliers(dgdpfull);
+        sensitivity.dzdp = zeros(n, np);
+        sensitivity.dwdp = zeros(n, np);
+        sensitivity.dzdp(inonbasic, Eigen::all) = reducedsensitivity.dzdp;
+        sensitivity.dwdp(inonbasic, Eigen::all) = reducedsensitivity.dwdp;
+    }
+};
+
+OptimumReducedSolver::OptimumReducedSolver(const OptimumStructure& structure)
+: pimpl(new Impl(structure))
+{}
+
+OptimumReducedSolver::OptimumReducedSolver(const OptimumReducedSolver& other)
+{
+    // Assert the copy is not made during a calculation, whose reduced objective function refers to the copied instance
+    Assert(!other.pimpl->initialized, "Could not copy the optimization solver of the reduced problem.",
+        "A copy cannot be made between the calls to methods begin and finish.");
+
+    pimpl.reset(new Impl(*other.pimpl));
+}
+
+OptimumReducedSolver::~OptimumReducedSolver()
+{}
+
+auto OptimumReducedSolver::operator=(OptimumReducedSolver other) -> OptimumReducedSolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto OptimumReducedSolver::setOptions(const OptimumOptions& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto OptimumReducedSolver::reducible() const -> bool
+{
+    return pimpl->reducer.reducible();
+}
+
+auto OptimumReducedSolver::begin(const OptimumParams& params, OptimumState& state) -> void
+{
+    pimpl->begin(params, state);
+}
+
+auto OptimumReducedSolver::step() -> bool
+{
+    return pimpl->step(nullptr);
+}
+
+auto OptimumReducedSolver::step(const ObjectiveResult& f) -> bool
+{
+    return pimpl->step(&f);
+}
+
+auto OptimumReducedSolver::converged() const -> bool
+{
+    return pimpl->result.succeeded;
+}
+
+auto OptimumReducedSolver::finish() -> OptimumResult
+{
+    return pimpl->finish();
+}
+
+auto OptimumReducedSolver::sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> void
+{
+    pimpl->sensitivities(dgdp, dbdp, sensitivity);
+}
+
+} // namespace Optima
@@ -0,0 +1,91 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class ObjectiveResult;
+class OptimumOptions;
+class OptimumParams;
+class OptimumResult;
+class OptimumSensitivity;
+class OptimumState;
+class OptimumStructure;
+
+/// Used to solve an optimization problem in the space of its non-basic variables, with an optimization solver of the reduced problem.
+/// The objective function of the reduced problem is evaluated with that of the original problem at the recovered variables.
+/// The basic variables are recovered along the iterations, and the multipliers of the equality constraints are determined
+/// from the last evaluated gradient of the objective function.
+/// @note A copy of an OptimumReducedSolver instance cannot be made between the calls to methods @ref begin and @ref finish.
+/// @see OptimumReducer, OptimumOptions::reduced_space
+class OptimumReducedSolver
+{
+public:
+    /// Construct an OptimumReducedSolver instance with given optimization structure.
+    OptimumReducedSolver(const OptimumStructure& structure);
+
+    /// Construct a copy of an OptimumReducedSolver instance.
+    OptimumReducedSolver(const OptimumReducedSolver& other);
+
+    /// Destroy this OptimumReducedSolver instance.
+    virtual ~OptimumReducedSolver();
+
+    /// Assign an OptimumReducedSolver instance to this.
+    auto operator=(OptimumReducedSolver other) -> OptimumReducedSolver&;
+
+    /// Set the options of the reduction and of the optimization calculations of the reduced problem.
+    auto setOptions(const OptimumOptions& options) -> void;
+
+    /// Return true if the optimization problem can be reduced (see OptimumReducer::reducible).
+    auto reducible() const -> bool;
+
+    /// Begin a step-by-step optimization calculation in the space of the non-basic variables.
+    /// @param params The parameters of the original optimization problem.
+    /// @param state[in,out] The initial guess and the current state of the original optimization problem.
+    auto begin(const OptimumParams& params, OptimumState& state) -> void;
+
+    /// Perform one iteration of the calculation of the reduced problem and return true if more iterations are needed.
+    auto step() -> bool;
+
+    /// Perform one iteration of the calculation of the reduced problem with the given evaluation of the objective function of the original problem at the current state.
+    auto step(const ObjectiveResult& f) -> bool;
+
+    /// Return true if the calculation has converged.
+    auto converged() const -> bool;
+
+    /// Finish the calculation and return its result, including the reduction and the recovery of the basic variables.
+    auto finish() -> OptimumResult;
+
+    /// Calculate the sensitivity derivatives of the solution of the original problem with respect to parameters \eq{p}.
+    /// @see OptimumSolver::sensitivities
+    auto sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> void;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -0,0 +1,371 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "OptimumReducer.hpp"
+
+// C++ includes
+#include <cmath>
+#include <vector>
+
+// Optima includes
+#include <Optima/Canonicalizer.hpp>
+#include <Optima/Exception.hpp>
+#include <Optima/Objective.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+#include <Optima/Utils.hpp>
+#include <Optima/VariantMatrix.hpp>
+
+namespace Optima {
+
+struct OptimumReducer::Impl
+{
+    /// The structure of the original optimization problem.
+    OptimumStructure structure;
+
+    /// The structure of the reduced optimization problem.
+    OptimumStructure reducedstructure;
+
+    /// The parameters of the reduced optimization problem.
+    OptimumParams reducedparams;
+
+    /// The options for the reduction.
+    OptimumOptions options;
+
+    /// The indices of the basic and non-basic variables.
+    Indices ibasic, inonbasic;
+
+    /// The matrix S in the canonical form of matrix A.
+    Matrix S;
+
+    /// The canonicalizer matrix R of matrix A, whose top rows correspond to the basic variables.
+    Matrix R;
+
+    /// The values of the basic variables when all non-basic variables are zero, i.e., R_b*b.
+    Vector xb0;
+
+    /// The lower and upper bounds, and the fixed values of all variables (-inf, +inf and zero for variables without them).
+    Vector xlower, xupper, xfixed;
+
+    /// The flag that indicates if the basic variables have no bounds and no fixed values.
+    bool isreducible = false;
+
+    /// The number of variables and equality constraints of the original problem.
+    Index n, m;
+
+    /// The number of basic and non-basic variables.
+    Index nb, nn;
+
+    /// Construct an OptimumReducer::Impl instance with given optimization structure.
+    Impl(const OptimumStructure& structure)
+    : structure(structure), reducedstructure(0, 0)
+    {
+        n = structure.numVariables();
+        m = structure.numEqualityConstraints();
+
+        IndicesConstRef ilower = structure.variablesWithLowerBounds();
+        IndicesConstRef iupper = structure.variablesWithUpperBounds();
+        IndicesConstRef ifixed = structure.variablesWithFixedValues();
+
+        // The priority weights that prevent the variables with bounds or fixed values from becoming basic variables
+        Vector weights = ones(n);
+        weights(ilower).fill(0.0);
+        weights(iupper).fill(0.0);
+        weights(ifixed).fill(0.0);
+
+        // Compute the canonical form of matrix A with the basic variables chosen among those without bounds and fixed values (if possible)
+        Canonicalizer canonicalizer(structure.A);
+        canonicalizer.updateWithPriorityWeights(weights);
+
+        nb = canonicalizer.numBasicVariables();
+        nn = n - nb;
+
+        ibasic = canonicalizer.indicesBasicVariables();
+        inonbasic = canonicalizer.indicesNonBasicVariables();
+        S = canonicalizer.S();
+        R = canonicalizer.R();
+
+        // The problem is reducible only if no basic variable has bounds or a fixed value (e.g., if a constraint has no variable without them)
+        isreducible = nb == 0 || weights(ibasic).minCoeff() > 0.0;
+
+        // Initialize the structure of the reduced problem with the bounds and fixed values of the non-basic variables
+        std::vector<bool> haslower(n, false), hasupper(n, false), hasfixed(n, false);
+        for(Index j : ilower) haslower[j] = true;
+        for(Index j : iupper) hasupper[j] = true;
+        for(Index j : ifixed) hasfixed[j] = true;
+
+        std::vector<bool> reducedlower(nn), reducedupper(nn), reducedfixed(nn);
+        for(Index k = 0; k < nn; ++k) reducedlower[k] = haslower[inonbasic[k]];
+        for(Index k = 0; k < nn; ++k) reducedupper[k] = hasupper[inonbasic[k]];
+        for(Index k = 0; k < nn; ++k) reducedfixed[k] = hasfixed[inonbasic[k]];
+
+        reducedstructure = OptimumStructure(nn, 0);
+        reducedstructure.A = zeros(0, nn);
+        reducedstructure.setVariablesWithLowerBounds(indicesOf(reducedlower));
+        reducedstructure.setVariablesWithUpperBounds(indicesOf(reducedupper));
+        reducedstructure.setVariablesWithFixedValues(indicesOf(reducedfixed));
+
+        // The constant Hessian matrix reduced to the non-basic variables, which is dense unless it is zero
+        if(structure.hasConstantHessian())
+        {
+            VariantMatrixConstRef H = structure.constantHessian();
+            if(H.structure == MatrixStructure::Zero)
+                reducedstructure.setConstantHessianZero();
+            else reducedstructure.setConstantHessianDense(reducedHessian(H));
+        }
+
+        // Allocate memory
+        xlower.resize(n);
+        xupper.resize(n);
+        xfixed.resize(n);
+    }
+
+    /// Return the indices of the entries with true value.
+    static auto indicesOf(const std::vector<bool>& flags) -> Indices
+    {
+        Indices inds(flags.size());
+        Index size = 0;
+        for(Index i = 0; i < Index(flags.size()); ++i)
+            if(flags[i]) inds[size++] = i;
+        inds.conservativeResize(size);
+        return inds;
+    }
+
+    /// Return the reduced Hessian matrix tr(P)*H*P, with P = [-S; I] the derivatives of [x_b; x_n] with respect to x_n.
+    auto reducedHessian(VariantMatrixConstRef H) const -> Matrix
+    {
+        switch(H.structure) {
+        case MatrixStructure::Dense:
+        {
+            const Matrix HP = H.dense(Eigen::all, inonbasic) - H.dense(Eigen::all, ibasic) * S;
+            return HP(inonbasic, Eigen::all) - tr(S) * HP(ibasic, Eigen::all);
+        }
+        case MatrixStructure::Diagonal:
+        {
+            const Vector Hbb = H.diagonal(ibasic);
+            Matrix Hr = tr(S) * Hbb.asDiagonal() * S;
+            Hr.diagonal() += H.diagonal(inonbasic);
+            return Hr;
+        }
+        default: return zeros(nn, nn);
+        }
+    }
+
+    /// Reduce the optimization problem with given parameters.
+    auto reduce(const OptimumParams& params) -> bool
+    {
+        // Assert the basic variables have no bounds and no fixed values
+        Assert(isreducible, "Could not reduce the optimization problem.",
+            "Its basic variables cannot be chosen among the variables without bounds and fixed values.");
+
+        // Check each row r of the canonicalizer matrix corresponding to a linearly dependent row of A, as in the calculation
+        const auto Rl = R.bottomRows(m - nb);
+        for(Index i = 0; i < Rl.rows(); ++i)
+            if(std::abs(Rl.row(i).dot(params.b)) > options.tolerance * Rl.row(i).lpNorm<1>())
+                return false;
+
+        // The values of the basic variables when all non-basic variables are zero
+        xb0 = R.topRows(nb) * params.b;
+
+        // Initialize the lower and upper bounds, and the fixed values of all variables
+        xlower.fill(-infinity());
+        xupper.fill(infinity());
+        xfixed.fill(0.0);
+        xlower(structure.variablesWithLowerBounds()) = params.xlower;
+        xupper(structure.variablesWithUpperBounds()) = params.xupper;
+        xfixed(structure.variablesWithFixedValues()) = params.xfixed;
+
+        // The parameters of the reduced problem, without equality constraints
+        const Indices ilower = inonbasic(reducedstructure.variablesWithLowerBounds());
+        const Indices iupper = inonbasic(reducedstructure.variablesWithUpperBounds());
+        const Indices ifixed = inonbasic(reducedstructure.variablesWithFixedValues());
+        reducedparams.b.resize(0);
+        reducedparams.xlower = xlower(ilower);
+        reducedparams.xupper = xupper(iupper);
+        reducedparams.xfixed = xfixed(ifixed);
+
+        return true;
+    }
+
+    /// Set the state of the reduced problem from a state of the original problem.
+    auto reduce(const OptimumState& state, OptimumState& reducedstate) const -> void
+    {
+        reducedstate.x = state.x.size() == n ? Vector(state.x(inonbasic)) : Vector();
+        reducedstate.y = Vector();
+        reducedstate.z = state.z.size() == n ? Vector(state.z(inonbasic)) : Vector();
+        reducedstate.w = state.w.size() == n ? Vector(state.w(inonbasic)) : Vector();
+    }
+
+    /// Set the evaluation of the objective function of the reduced problem (only the evaluated parts according to its requirements).
+    auto reduce(const ObjectiveResult& f, ObjectiveResult& reducedf) const -> void
+    {
+        reducedf.requires = f.requires;
+        reducedf.failed = f.failed;
+
+        if(f.requires.value)
+            reducedf.value = f.value;
+
+        if(f.requires.gradient)
+            reducedf.gradient = reducedGradient(f.gradient);
+
+        if(f.requires.hessian)
+        {
+            if(f.hessian.structure == MatrixStructure::Zero)
+                reducedf.hessian.setZero();
+            else
+            {
+                reducedf.hessian.setDense(nn);
+                reducedf.hessian.dense = reducedHessian(f.hessian);
+            }
+        }
+    }
+
+    /// Return the reduced gradient g_n - tr(S)*g_b for each column of the given matrix.
+    auto reducedGradient(MatrixConstRef g) const -> Matrix
+    {
+        return g(inonbasic, Eigen::all) - tr(S) * g(ibasic, Eigen::all);
+    }
+
+    /// Set the variables x of the original problem from those of the reduced problem.
+    auto recover(VectorConstRef reducedx, VectorRef x) const -> void
+    {
+        x(inonbasic) = reducedx;
+        x(ibasic) = xb0 - S * reducedx;
+    }
+
+    /// Set the state of the original problem, with the multipliers of the equality constraints determined from the gradient g (if not empty).
+    auto recover(const OptimumState& reducedstate, VectorConstRef g, OptimumState& state) const -> void
+    {
+        state.x.resize(n);
+        recover(reducedstate.x, state.x);
+
+        state.y = g.size() == n ? Vector(multipliers(g)) : Vector(zeros(m));
+        state.z = zeros(n);
+        state.w = zeros(n);
+
+        if(reducedstate.z.size()) state.z(inonbasic) = reducedstate.z;
+        if(reducedstate.w.size()) state.w(inonbasic) = reducedstate.w;
+    }
+
+    /// Return the derivatives of the variables x with respect to parameters from those of the non-basic variables.
+    auto derivatives(MatrixConstRef dxndp, MatrixConstRef dbdp) const -> Matrix
+    {
+        Matrix dxdp(n, dxndp.cols());
+        dxdp(inonbasic, Eigen::all) = dxndp;
+        dxdp(ibasic, Eigen::all) = -S * dxndp;
+        if(dbdp.size())
+            dxdp(ibasic, Eigen::all) += R.topRows(nb) * dbdp;
+        return dxdp;
+    }
+
+    /// Return the multipliers y = -tr(R_b)*g_b that satisfy the optimality conditions of the basic variables.
+    auto multipliers(MatrixConstRef g) const -> Matrix
+    {
+        return -tr(R.topRows(nb)) * g(ibasic, Eigen::all);
+    }
+};
+
+OptimumReducer::OptimumReducer(const OptimumStructure& structure)
+: pimpl(new Impl(structure))
+{}
+
+OptimumReducer::OptimumReducer(const OptimumReducer& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+OptimumReducer::~OptimumReducer()
+{}
+
+auto OptimumReducer::operator=(OptimumReducer other) -> OptimumReducer&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto OptimumReducer::setOptions(const OptimumOptions& options) -> void
+{
+    pimpl->options = options;
+}
+
+auto OptimumReducer::reducible() const -> bool
+{
+    return pimpl->isreducible;
+}
+
+auto OptimumReducer::reduce(const OptimumParams& params) -> bool
+{
+    return pimpl->reduce(params);
+}
+
+auto OptimumReducer::structure() const -> const OptimumStructure&
+{
+    return pimpl->reducedstructure;
+}
+
+auto OptimumReducer::params() const -> const OptimumParams&
+{
+    return pimpl->reducedparams;
+}
+
+auto OptimumReducer::basicVariables() const -> IndicesConstRef
+{
+    return pimpl->ibasic;
+}
+
+auto OptimumReducer::nonBasicVariables() const -> IndicesConstRef
+{
+    return pimpl->inonbasic;
+}
+
+auto OptimumReducer::reduce(const OptimumState& state, OptimumState& reducedstate) const -> void
+{
+    pimpl->reduce(state, reducedstate);
+}
+
+auto OptimumReducer::reduce(const ObjectiveResult& f, ObjectiveResult& reducedf) const -> void
+{
+    pimpl->reduce(f, reducedf);
+}
+
+auto OptimumReducer::reducedGradient(MatrixConstRef g) const -> Matrix
+{
+    return pimpl->reducedGradient(g);
+}
+
+auto OptimumReducer::recover(VectorConstRef reducedx, VectorRef x) const -> void
+{
+    pimpl->recover(reducedx, x);
+}
+
+auto OptimumReducer::recover(const OptimumState& reducedstate, VectorConstRef g, OptimumState& state) const -> void
+{
+    pimpl->recover(reducedstate, g, state);
+}
+
+auto OptimumReducer::derivatives(MatrixConstRef dxndp, MatrixConstRef dbdp) const -> Matrix
+{
+    return pimpl->derivatives(dxndp, dbdp);
+}
+
+auto OptimumReducer::multipliers(MatrixConstRef g) const -> Matrix
+{
+    return pimpl->multipliers(g);
+}
+
+} // namespace Optima
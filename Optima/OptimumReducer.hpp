@@ -0,0 +1,112 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class ObjectiveResult;
+class OptimumOptions;
+class OptimumParams;
+class OptimumState;
+class OptimumStructure;
+
+/// Used to reduce an optimization problem to the space of its non-basic variables, which eliminates its equality constraints.
+/// With the canonical form \eq{C = RAQ = [I\quad S]} of matrix \eq{A}, the basic variables are determined from the non-basic
+/// ones as \eq{x_b = R_b b - S x_n}, where \eq{R_b} are the rows of \eq{R} corresponding to the basic variables. The reduced
+/// problem has the non-basic variables only, with reduced gradient \eq{g_n - S^T g_b} and reduced Hessian matrix
+/// \eq{H_{nn} - H_{nb}S - S^T H_{bn} + S^T H_{bb} S}. The basic variables are chosen among the variables without bounds
+/// and fixed values, so that the reduced problem keeps the bounds of the non-basic variables only. The multipliers of
+/// the equality constraints are recovered from the optimality conditions of the basic variables, \eq{y = -R_b^T g_b}.
+/// @see OptimumOptions::reduced_space
+class OptimumReducer
+{
+public:
+    /// Construct an OptimumReducer instance with given optimization structure.
+    OptimumReducer(const OptimumStructure& structure);
+
+    /// Construct a copy of an OptimumReducer instance.
+    OptimumReducer(const OptimumReducer& other);
+
+    /// Destroy this OptimumReducer instance.
+    virtual ~OptimumReducer();
+
+    /// Assign an OptimumReducer instance to this.
+    auto operator=(OptimumReducer other) -> OptimumReducer&;
+
+    /// Set the options for the reduction.
+    auto setOptions(const OptimumOptions& options) -> void;
+
+    /// Return true if the basic variables have no bounds and no fixed values, so that the problem can be reduced.
+    auto reducible() const -> bool;
+
+    /// Reduce the optimization problem with given parameters.
+    /// @return `false` if vector \eq{b} is inconsistent with the linearly dependent rows of matrix \eq{A}.
+    auto reduce(const OptimumParams& params) -> bool;
+
+    /// Return the structure of the reduced problem, which has no equality constraints.
+    auto structure() const -> const OptimumStructure&;
+
+    /// Return the parameters of the reduced problem, without objective function.
+    auto params() const -> const OptimumParams&;
+
+    /// Return the indices of the basic variables, which are eliminated in the reduced problem.
+    auto basicVariables() const -> IndicesConstRef;
+
+    /// Return the indices of the non-basic variables, which are the variables of the reduced problem.
+    auto nonBasicVariables() const -> IndicesConstRef;
+
+    /// Set the state of the reduced problem from a state of the original problem (e.g., an initial guess).
+    /// The given state is ignored if its dimensions are inconsistent with those of the original problem.
+    auto reduce(const OptimumState& state, OptimumState& reducedstate) const -> void;
+
+    /// Set the evaluation of the objective function of the reduced problem from one of the original problem.
+    auto reduce(const ObjectiveResult& f, ObjectiveResult& reducedf) const -> void;
+
+    /// Return the reduced gradient \eq{g_n - S^T g_b} for the given gradient (or for each column of given derivatives of the gradient).
+    auto reducedGradient(MatrixConstRef g) const -> Matrix;
+
+    /// Set the variables \eq{x} of the original problem from those of the reduced problem.
+    auto recover(VectorConstRef reducedx, VectorRef x) const -> void;
+
+    /// Set the state of the original problem from that of the reduced problem, with the multipliers of the equality
+    /// constraints determined from the given gradient of the objective function (zero if the gradient is empty).
+    auto recover(const OptimumState& reducedstate, VectorConstRef g, OptimumState& state) const -> void;
+
+    /// Return the derivatives of the variables \eq{x} with respect to parameters from those of the non-basic variables.
+    /// @param dxndp The derivatives of the non-basic variables with respect to the parameters.
+    /// @param dbdp The derivatives of vector \eq{b} with respect to the parameters (empty if \eq{b} does not depend on them).
+    auto derivatives(MatrixConstRef dxndp, MatrixConstRef dbdp) const -> Matrix;
+
+    /// Return the multipliers \eq{y = -R_b^T g_b} for the given gradient (or for each column of given derivatives of the gradient).
+    auto multipliers(MatrixConstRef g) const -> Matrix;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
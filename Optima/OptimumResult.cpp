@@ -22,6 +22,7 @@ namespace Optima {
 auto OptimumResult::operator+=(const OptimumResult& other) -> OptimumResult&
 {
     succeeded              = other.succeeded;
+    status                 = other.status;
     iterations            += other.iterations;
     num_objective_evals   += other.num_objective_evals;
     convergence_rate       = other.convergence_rate;
@@ -30,8 +31,21 @@ auto OptimumResult::operator+=(const OptimumResult& other) -> OptimumResult&
     time_objective_evals  += other.time_objective_evals;
     time_constraint_evals += other.time_constraint_evals;
     time_linear_systems   += other.time_linear_systems;
+    num_hessian_evals        += other.num_hessian_evals;
+    num_factorizations       += other.num_factorizations;
+    num_factorizations_saved += other.num_factorizations_saved;
+    predicted                  = other.predicted;
+    num_prediction_attempts   += other.num_prediction_attempts;
+    num_prediction_hits       += other.num_prediction_hits;
+    time_predictions          += other.time_predictions;
+    time_saved_by_predictions += other.time_saved_by_predictions;
 
     return *this;
 }
 
+auto OptimumResult::predictionHitRate() const -> double
+{
+    return num_prediction_attempts ? double(num_prediction_hits)/num_prediction_attempts : 0.0;
+}
+
 } // namespace Optima
@@ -22,6 +22,41 @@
 
 namespace Optima {
 
+/// The reasons for the termination of an optimization calculation.
+enum class OptimumStatus
+{
+    /// The calculation has not finished yet.
+    Unfinished,
+
+    /// The residual error of the optimality conditions is below OptimumOptions::tolerance.
+    Converged,
+
+    /// The variation of the primal variables x is below OptimumOptions::tolerancex.
+    SmallStep,
+
+    /// The variation of the objective value is below OptimumOptions::tolerancef.
+    SmallObjectiveChange,
+
+    /// The residual error has not decreased sufficiently for OptimumTerminationOptions::stagnation_iterations iterations.
+    Stagnated,
+
+    /// The residual error has grown far above the smallest one found (see OptimumTerminationOptions::divergence_ratio) or it is not finite.
+    Diverged,
+
+    /// The equality constraints and the bounds have no solution, as indicated by vector b being inconsistent with the linearly
+    /// dependent rows of matrix A, or by the multipliers growing without bound while the feasibility error does not decrease.
+    Infeasible,
+
+    /// The maximum number of iterations has been reached.
+    MaxIterations,
+
+    /// The maximum wall time of the calculation has been exceeded (see OptimumOptions::max_time).
+    TimeLimit,
+
+    /// The calculation has been cancelled (see OptimumOptions::cancellation).
+    Cancelled,
+};
+
 /// A type that describes the result of an optimization calculation.
 class OptimumResult
 {
@@ -29,12 +64,24 @@ public:
     /// The flag that indicates if the optimization calculation converged.
     bool succeeded = false;
 
+    /// The reason for the termination of the optimization calculation.
+    OptimumStatus status = OptimumStatus::Unfinished;
+
     /// The number of iterations in the optimization calculation.
     Index iterations = 0;
 
     /// The number of evaluations of the objective function in the optimization calculation.
     Index num_objective_evals = 0;
 
+    /// The number of evaluations of the Hessian matrix of the objective function in the optimization calculation.
+    Index num_hessian_evals = 0;
+
+    /// The number of decompositions of the saddle point matrix in the optimization calculation.
+    Index num_factorizations = 0;
+
+    /// The number of iterations that reused the last decomposition of the saddle point matrix instead of computing a new one.
+    Index num_factorizations_saved = 0;
+
     /// The convergence rate of the optimization calculation near the solution.
     double convergence_rate = 0;
 
@@ -65,6 +112,24 @@ public:
     /// The wall time spent for all linear system solutions (in units of s).
     double time_linear_systems = 0;
 
+    /// The flag that indicates if the solution was predicted from a previously calculated one.
+    bool predicted = false;
+
+    /// The number of attempts to predict the solution from a previously calculated one (at most one per calculation, see OptimumSolver::accumulatedResult).
+    Index num_prediction_attempts = 0;
+
+    /// The number of successful predictions of the solution from a previously calculated one (at most one per calculation, see OptimumSolver::accumulatedResult).
+    Index num_prediction_hits = 0;
+
+    /// The wall time spent for all predictions of the solution, successful or not (in units of s).
+    double time_predictions = 0;
+
+    /// The estimated wall time saved with successful predictions of the solution (in units of s).
+    double time_saved_by_predictions = 0;
+
+    /// Return the ratio between the number of successful predictions and the number of prediction attempts.
+    auto predictionHitRate() const -> double;
+
     /// Update this OptimumResult instance with another by addition.
     auto operator+=(const OptimumResult& other) -> OptimumResult&;
 };
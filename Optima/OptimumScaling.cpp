@@ -0,0 +1,328 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "OptimumScaling.hpp"
+
+// C++ includes
+#include <cmath>
+
+// Optima includes
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumSensitivity.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+#include <Optima/Utils.hpp>
+#include <Optima/VariantMatrix.hpp>
+
+namespace Optima {
+
+struct OptimumScaling::Impl
+{
+    /// The boolean flag that indicates if the optimization problem is scaled.
+    bool active = false;
+
+    /// The scaling factors of the variables, the diagonal entries of \eq{D}.
+    Vector colscale;
+
+    /// The scaling factors of the equality constraints, the diagonal entries of \eq{R}.
+    Vector rowscale;
+
+    /// The scaling factor of the objective function.
+    double sigma = 1.0;
+
+    /// The boolean flag that indicates if the scaling factor of the objective function still needs to be determined.
+    bool undetermined = false;
+
+    /// The options for the scaling of the optimization problem.
+    OptimumScalingOptions options;
+
+    /// The evaluation of the objective function at the unscaled variables.
+    ObjectiveResult funscaled;
+
+    /// Initialize the scaling factors of the variables and equality constraints by equilibrating the rows and columns of matrix A.
+    /// @see Ruiz, D. (2001). A scaling algorithm to equilibrate both rows and columns norms in matrices. Technical Report RAL-TR-2001-034.
+    auto initialize(const OptimumStructure& structure, const OptimumScalingOptions& scalingoptions) -> void
+    {
+        options = scalingoptions;
+
+        const Index n = structure.numVariables();
+        const Index m = structure.numEqualityConstraints();
+
+        active = options.active && n > 0;
+        colscale = ones(n);
+        rowscale = ones(m);
+        sigma = 1.0;
+        undetermined = active && options.max_gradient > 0.0;
+
+        // Skip if the problem is not scaled or there is no equality constraint to equilibrate
+        if(!active || m == 0)
+            return;
+
+        Matrix A = structure.A;
+
+        for(unsigned pass = 0; pass < options.passes; ++pass)
+        {
+            // The largest entries in absolute value in each row and column of the scaled matrix A
+            const Vector rowmax = A.cwiseAbs().rowwise().maxCoeff();
+            const Vector colmax = tr(A.cwiseAbs().colwise().maxCoeff());
+
+            // Stop once the largest entries are closer to one than the precision of scaling factors that are powers of two
+            auto equilibrated = [](VectorConstRef v) { return (v.array() == 0.0 || (v.array() > 0.5 && v.array() < 2.0)).all(); };
+            if(equilibrated(rowmax) && equilibrated(colmax))
+                break;
+
+            // Scale each row and column with the inverse square root of its largest entry (except those with zero entries only)
+            const Vector r = (rowmax.array() > 0.0).select(rowmax.array().sqrt().inverse(), 1.0);
+            const Vector c = (colmax.array() > 0.0).select(colmax.array().sqrt().inverse(), 1.0);
+
+            A = r.asDiagonal() * A * c.asDiagonal();
+
+            rowscale.array() *= r.array();
+            colscale.array() *= c.array();
+        }
+
+        // Round the scaling factors to powers of two
+        auto power2 = [](double s) { return std::exp2(std::round(std::log2(s))); };
+        rowscale = rowscale.unaryExpr(power2);
+        colscale = colscale.unaryExpr(power2);
+    }
+
+    /// Determine the scaling factor of the objective function from its evaluation at the initial guess of the scaled variables (evaluated with unit scaling factor).
+    /// The objective function is scaled down, never up, so that the largest entry of its scaled gradient does not exceed OptimumScalingOptions::max_gradient.
+    auto determine(const ObjectiveResult& f) -> void
+    {
+        const double gmax = norminf(f.gradient);
+
+        sigma = gmax > options.max_gradient ? std::exp2(std::floor(std::log2(options.max_gradient / gmax))) : 1.0;
+    }
+
+    /// Return the scaled structure of the optimization problem.
+    auto scaled(const OptimumStructure& structure) const -> OptimumStructure
+    {
+        OptimumStructure scaledstructure = structure;
+
+        scaledstructure.A = rowscale.asDiagonal() * structure.A * colscale.asDiagonal();
+
+        // Scale the constant Hessian matrix of the objective function, if any
+        if(structure.hasConstantHessian())
+        {
+            VariantMatrixConstRef H = structure.constantHessian();
+            switch(H.structure) {
+            case MatrixStructure::Dense: scaledstructure.setConstantHessianDense(sigma * colscale.asDiagonal() * H.dense * colscale.asDiagonal()); break;
+            case MatrixStructure::Diagonal: scaledstructure.setConstantHessianDiagonal(sigma * colscale.cwiseAbs2().cwiseProduct(H.diagonal)); break;
+            case MatrixStructure::Zero: scaledstructure.setConstantHessianZero(); break;
+            }
+        }
+
+        return scaledstructure;
+    }
+
+    /// Set the scaled parameters of the optimization problem, except its objective function.
+    auto scale(const OptimumStructure& structure, const OptimumParams& params, OptimumParams& scaledparams) const -> void
+    {
+        IndicesConstRef ilower = structure.variablesWithLowerBounds();
+        IndicesConstRef iupper = structure.variablesWithUpperBounds();
+        IndicesConstRef ifixed = structure.variablesWithFixedValues();
+
+        scaledparams.b = rowscale.cwiseProduct(params.b);
+        scaledparams.xlower = params.xlower.cwiseQuotient(colscale(ilower));
+        scaledparams.xupper = params.xupper.cwiseQuotient(colscale(iupper));
+        scaledparams.xfixed = params.xfixed.cwiseQuotient(colscale(ifixed));
+    }
+
+    /// Set the scaled state of the optimization problem (the given state must have proper dimensions, or none at all).
+    auto scale(const OptimumState& state, OptimumState& scaledstate) const -> void
+    {
+        scaledstate.x = state.x.size() == colscale.size() ? Vector(state.x.cwiseQuotient(colscale)) : Vector();
+        scaledstate.y = state.y.size() == rowscale.size() ? Vector(sigma * state.y.cwiseQuotient(rowscale)) : Vector();
+        scaledstate.z = state.z.size() == colscale.size() ? Vector(sigma * state.z.cwiseProduct(colscale)) : Vector();
+        scaledstate.w = state.w.size() == colscale.size() ? Vector(sigma * state.w.cwiseProduct(colscale)) : Vector();
+    }
+
+    /// Set the unscaled state of the optimization problem.
+    auto unscale(const OptimumState& scaledstate, OptimumState& state) const -> void
+    {
+        state.x = scaledstate.x.cwiseProduct(colscale);
+        state.y = scaledstate.y.cwiseProduct(rowscale) / sigma;
+        state.z = scaledstate.z.cwiseQuotient(colscale) / sigma;
+        state.w = scaledstate.w.cwiseQuotient(colscale) / sigma;
+    }
+
+    /// Set the scaled evaluation of the objective function (only the evaluated parts according to its requirements).
+    auto scale(const ObjectiveResult& f, ObjectiveResult& scaledf) const -> void
+    {
+        scaledf.requires = f.requires;
+        scaledf.failed = f.failed;
+
+        if(f.requires.value)
+            scaledf.value = sigma * f.value;
+
+        if(f.requires.gradient)
+            scaledf.gradient = sigma * colscale.cwiseProduct(f.gradient);
+
+        if(f.requires.hessian)
+        {
+            const Index n = colscale.size();
+            switch(f.hessian.structure) {
+            case MatrixStructure::Dense: scaledf.hessian.setDense(n); scaledf.hessian.dense = sigma * colscale.asDiagonal() * f.hessian.dense * colscale.asDiagonal(); break;
+            case MatrixStructure::Diagonal: scaledf.hessian.setDiagonal(n); scaledf.hessian.diagonal = sigma * colscale.cwiseAbs2().cwiseProduct(f.hessian.diagonal); break;
+            case MatrixStructure::Zero: scaledf.hessian.setZero(); break;
+            }
+        }
+    }
+
+    /// Evaluate the scaled objective function at given scaled variables.
+    auto evaluate(const ObjectiveFunction& objective, VectorConstRef x, ObjectiveResult& scaledf) -> void
+    {
+        const Index n = colscale.size();
+
+        // Evaluate the objective function at the unscaled variables with the same requirements
+        funscaled.requires = scaledf.requires;
+        funscaled.gradient.resize(n);
+        if(scaledf.requires.hessian) funscaled.hessian.diagonal.resize(n);
+        if(scaledf.requires.hessian) funscaled.hessian.dense.resize(n, n);
+        objective(x.cwiseProduct(colscale), funscaled);
+
+        scale(funscaled, scaledf);
+    }
+
+    /// Return the scaled derivatives of the gradient of the objective function with respect to parameters.
+    auto scaledGradientDerivatives(MatrixConstRef dgdp) const -> Matrix
+    {
+        return dgdp.size() ? Matrix(sigma * colscale.asDiagonal() * dgdp) : Matrix();
+    }
+
+    /// Return the scaled derivatives of vector b with respect to parameters.
+    auto scaledVectorDerivatives(MatrixConstRef dbdp) const -> Matrix
+    {
+        return dbdp.size() ? Matrix(rowscale.asDiagonal() * dbdp) : Matrix();
+    }
+
+    /// Unscale the sensitivity derivatives of the solution of the scaled problem.
+    auto unscale(OptimumSensitivity& sensitivity) const -> void
+    {
+        sensitivity.dxdp = colscale.asDiagonal() * sensitivity.dxdp;
+        sensitivity.dydp = rowscale.asDiagonal() * sensitivity.dydp / sigma;
+        sensitivity.dzdp = colscale.cwiseInverse().asDiagonal() * sensitivity.dzdp / sigma;
+        sensitivity.dwdp = colscale.cwiseInverse().asDiagonal() * sensitivity.dwdp / sigma;
+    }
+};
+
+OptimumScaling::OptimumScaling()
+: pimpl(new Impl())
+{}
+
+OptimumScaling::OptimumScaling(const OptimumScaling& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+OptimumScaling::~OptimumScaling()
+{}
+
+auto OptimumScaling::operator=(OptimumScaling other) -> OptimumScaling&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto OptimumScaling::initialize(const OptimumStructure& structure, const OptimumScalingOptions& options) -> void
+{
+    pimpl->initialize(structure, options);
+}
+
+auto OptimumScaling::determine(const ObjectiveResult& f) -> void
+{
+    pimpl->determine(f);
+}
+
+auto OptimumScaling::fixObjectiveScaling() -> void
+{
+    pimpl->undetermined = false;
+}
+
+auto OptimumScaling::active() const -> bool
+{
+    return pimpl->active;
+}
+
+auto OptimumScaling::undetermined() const -> bool
+{
+    return pimpl->undetermined;
+}
+
+auto OptimumScaling::colScaling() const -> VectorConstRef
+{
+    return pimpl->colscale;
+}
+
+auto OptimumScaling::rowScaling() const -> VectorConstRef
+{
+    return pimpl->rowscale;
+}
+
+auto OptimumScaling::objectiveScaling() const -> double
+{
+    return pimpl->sigma;
+}
+
+auto OptimumScaling::scaled(const OptimumStructure& structure) const -> OptimumStructure
+{
+    return pimpl->scaled(structure);
+}
+
+auto OptimumScaling::scale(const OptimumStructure& structure, const OptimumParams& params, OptimumParams& scaledparams) const -> void
+{
+    pimpl->scale(structure, params, scaledparams);
+}
+
+auto OptimumScaling::scale(const OptimumState& state, OptimumState& scaledstate) const -> void
+{
+    pimpl->scale(state, scaledstate);
+}
+
+auto OptimumScaling::scale(const ObjectiveResult& f, ObjectiveResult& scaledf) const -> void
+{
+    pimpl->scale(f, scaledf);
+}
+
+auto OptimumScaling::unscale(const OptimumState& scaledstate, OptimumState& state) const -> void
+{
+    pimpl->unscale(scaledstate, state);
+}
+
+auto OptimumScaling::unscale(OptimumSensitivity& sensitivity) const -> void
+{
+    pimpl->unscale(sensitivity);
+}
+
+auto OptimumScaling::evaluate(const ObjectiveFunction& objective, VectorConstRef x, ObjectiveResult& scaledf) -> void
+{
+    pimpl->evaluate(objective, x, scaledf);
+}
+
+auto OptimumScaling::scaledGradientDerivatives(MatrixConstRef dgdp) const -> Matrix
+{
+    return pimpl->scaledGradientDerivatives(dgdp);
+}
+
+auto OptimumScaling::scaledVectorDerivatives(MatrixConstRef dbdp) const -> Matrix
+{
+    return pimpl->scaledVectorDerivatives(dbdp);
+}
+
+} // namespace Optima
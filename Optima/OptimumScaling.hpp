@@ -0,0 +1,118 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+#include <Optima/Objective.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class OptimumParams;
+class OptimumSensitivity;
+class OptimumState;
+class OptimumStructure;
+struct OptimumScalingOptions;
+
+/// Used to scale an optimization problem, and to unscale the solution of the scaled problem.
+/// The scaled problem has variables \eq{\tilde{x}=D^{-1}x}, equality constraints \eq{RAD\tilde{x}=Rb} and
+/// objective function \eq{\tilde{f}(\tilde{x})=\sigma f(D\tilde{x})}, where \eq{D} and \eq{R} are diagonal
+/// matrices. Its Lagrange multipliers are then \eq{\tilde{y}=\sigma R^{-1}y}, \eq{\tilde{z}=\sigma Dz} and \eq{\tilde{w}=\sigma Dw}.
+/// All scaling factors are powers of two, so that scaling and unscaling introduce no round-off errors.
+/// @see OptimumScalingOptions
+class OptimumScaling
+{
+public:
+    /// Construct a default OptimumScaling instance, which does not scale the optimization problem.
+    OptimumScaling();
+
+    /// Construct a copy of an OptimumScaling instance.
+    OptimumScaling(const OptimumScaling& other);
+
+    /// Destroy this OptimumScaling instance.
+    virtual ~OptimumScaling();
+
+    /// Assign an OptimumScaling instance to this.
+    auto operator=(OptimumScaling other) -> OptimumScaling&;
+
+    /// Initialize the scaling factors of the variables and equality constraints by equilibrating the rows and columns of matrix A.
+    /// The scaling factor of the objective function is reset to one, and it still needs to be determined if
+    /// OptimumScalingOptions::max_gradient is positive (see @ref determine).
+    auto initialize(const OptimumStructure& structure, const OptimumScalingOptions& options) -> void;
+
+    /// Determine the scaling factor of the objective function from its evaluation at the initial guess of the scaled variables (evaluated with unit scaling factor).
+    /// The objective function is scaled down, never up, so that the largest entry of its scaled gradient does not exceed OptimumScalingOptions::max_gradient.
+    auto determine(const ObjectiveResult& f) -> void;
+
+    /// Keep the current scaling factor of the objective function in subsequent calculations.
+    auto fixObjectiveScaling() -> void;
+
+    /// Return true if the optimization problem is scaled.
+    auto active() const -> bool;
+
+    /// Return true if the scaling factor of the objective function still needs to be determined.
+    auto undetermined() const -> bool;
+
+    /// Return the scaling factors of the variables, the diagonal entries of \eq{D}.
+    auto colScaling() const -> VectorConstRef;
+
+    /// Return the scaling factors of the equality constraints, the diagonal entries of \eq{R}.
+    auto rowScaling() const -> VectorConstRef;
+
+    /// Return the scaling factor \eq{\sigma} of the objective function.
+    auto objectiveScaling() const -> double;
+
+    /// Return the scaled structure of the optimization problem.
+    auto scaled(const OptimumStructure& structure) const -> OptimumStructure;
+
+    /// Set the scaled parameters of the optimization problem, except its objective function.
+    auto scale(const OptimumStructure& structure, const OptimumParams& params, OptimumParams& scaledparams) const -> void;
+
+    /// Set the scaled state of the optimization problem (the given state must have proper dimensions, or none at all).
+    auto scale(const OptimumState& state, OptimumState& scaledstate) const -> void;
+
+    /// Set the scaled evaluation of the objective function (only the evaluated parts according to its requirements).
+    auto scale(const ObjectiveResult& f, ObjectiveResult& scaledf) const -> void;
+
+    /// Set the unscaled state of the optimization problem.
+    auto unscale(const OptimumState& scaledstate, OptimumState& state) const -> void;
+
+    /// Unscale the sensitivity derivatives of the solution of the scaled problem.
+    auto unscale(OptimumSensitivity& sensitivity) const -> void;
+
+    /// Evaluate the scaled objective function at given scaled variables.
+    auto evaluate(const ObjectiveFunction& objective, VectorConstRef x, ObjectiveResult& scaledf) -> void;
+
+    /// Return the scaled derivatives of the gradient of the objective function with respect to parameters.
+    auto scaledGradientDerivatives(MatrixConstRef dgdp) const -> Matrix;
+
+    /// Return the scaled derivatives of vector b with respect to parameters.
+    auto scaledVectorDerivatives(MatrixConstRef dbdp) const -> Matrix;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
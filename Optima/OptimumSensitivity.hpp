@@ -0,0 +1,43 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Optima includes
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+/// Used to describe the sensitivity derivatives of the solution of an optimization problem with respect to parameters \eq{p}.
+/// Each column in the matrices below corresponds to a parameter in \eq{p}.
+class OptimumSensitivity
+{
+public:
+    /// The derivatives of the primal solution \eq{x} with respect to the parameters \eq{p}.
+    Matrix dxdp;
+
+    /// The derivatives of the dual solution \eq{y} with respect to the parameters \eq{p}.
+    Matrix dydp;
+
+    /// The derivatives of the dual solution \eq{z} with respect to the parameters \eq{p}.
+    Matrix dzdp;
+
+    /// The derivatives of the dual solution \eq{w} with respect to the parameters \eq{p}.
+    Matrix dwdp;
+};
+
+} // namespace Optima
@@ -17,17 +17,33 @@
 
 #include "OptimumSolver.hpp"
 
+// C++ includes
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <vector>
+
+// Eigen includes
+#include <Optima/deps/eigen3/Eigen/Dense>
+
 // Optima includes
+#include <Optima/Canonicalizer.hpp>
 #include <Optima/Exception.hpp>
 #include <Optima/IpSaddlePointMatrix.hpp>
+#include <Optima/KdTree.hpp>
 #include <Optima/Objective.hpp>
 #include <Optima/OptimumOptions.hpp>
 #include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumPresolvedSolver.hpp>
+#include <Optima/OptimumReducedSolver.hpp>
 #include <Optima/OptimumResult.hpp>
+#include <Optima/OptimumScaling.hpp>
+#include <Optima/OptimumSensitivity.hpp>
 #include <Optima/OptimumState.hpp>
 #include <Optima/OptimumStepper.hpp>
 #include <Optima/OptimumStructure.hpp>
 #include <Optima/Outputter.hpp>
+#include <Optima/QuasiNewtonHessian.hpp>
 #include <Optima/Result.hpp>
 #include <Optima/SaddlePointMatrix.hpp>
 #include <Optima/Timing.hpp>
@@ -41,33 +57,15 @@ auto isfinite(const ObjectiveResult& res) -> bool
     return std::isfinite(res.value) && res.gradient.allFinite();
 }
 
-//auto xStepLength(VectorConstRef x, VectorConstRef dx, VectorConstRef l, VectorConstRef u, double tau) -> double
-//{
-//    double alpha = 1.0;
-//    const Index size = x.size();
-//    for(Index i = 0; i < size; ++i)
-//        alpha = (dx[i] < 0.0) ? std::min(alpha, tau*(l[i] - x[i])/dx[i]) :
-//                (dx[i] > 0.0) ? std::min(alpha, tau*(u[i] - x[i])/dx[i]) : alpha;
-//    return alpha;
-//}
-//
-//auto zStepLength(VectorConstRef z, VectorConstRef dz, double tau) -> double
-//{
-//    double alpha = 1.0;
-//    const Index size = z.size();
-//    for(Index i = 0; i < size; ++i)
-//        if(dz[i] < 0.0) alpha = std::min(alpha, -tau*z[i]/dz[i]);
-//    return alpha;
-//}
-//
-//auto wStepLength(VectorConstRef w, VectorConstRef dw, double tau) -> double
-//{
-//    double alpha = 1.0;
-//    const Index size = w.size();
-//    for(Index i = 0; i < size; ++i)
-//        if(dw[i] > 0.0) alpha = std::min(alpha, -tau*w[i]/dw[i]);
-//    return alpha;
-//}
+/// Used to store a calculated solution together with its sensitivity derivatives with respect to b.
+struct OptimumRecord
+{
+    /// The calculated solution of the optimization problem.
+    OptimumState state;
+
+    /// The sensitivity derivatives of the solution with respect to b.
+    OptimumSensitivity sensitivity;
+};
 
 } // namespace
 
@@ -79,18 +77,33 @@ struct OptimumSolver::Impl
     /// The calculator of the Newton step (dx, dy, dz, dw)
     OptimumStepper stepper;
 
+    /// The coefficient matrix A of the equality constraints in the calculation (scaled if the problem is scaled).
+    Matrix A;
+
     /// The evaluated result of the objective function.
     ObjectiveResult f;
 
     /// The result of the optimization problem
     OptimumResult result;
 
+    /// The results of all optimization calculations performed with this solver, accumulated with OptimumResult::operator+=.
+    OptimumResult accumulated;
+
     /// The trial iterate x(trial)
     Vector xtrial;
 
     /// The trial Newton step dx(trial)
     Vector dxtrial;
 
+    /// The trial Newton steps dz(trial) and dw(trial)
+    Vector dztrial, dwtrial;
+
+    /// The evaluated result of the objective function at trial iterates in the line search.
+    ObjectiveResult ftrial;
+
+    /// The approximation of the Hessian matrix of the objective function in the quasi-Newton modes.
+    QuasiNewtonHessian quasinewton;
+
     /// The lower bounds for each variable x (-inf with no lower bound)
     Vector xlower;
 
@@ -103,6 +116,110 @@ struct OptimumSolver::Impl
     /// The options for the optimization calculation
     OptimumOptions options;
 
+    /// The kd-tree of the vectors b of the stored solutions used for predictions.
+    KdTree records_b;
+
+    /// The stored solutions used for predictions, in the same order as in `records_b`.
+    std::vector<OptimumRecord> records;
+
+    /// The predicted state of the optimization calculation.
+    OptimumState predicted;
+
+    /// The index of the stored solution from which the solution of the last calculation was predicted (-1 if it was not predicted).
+    Index irecord = -1;
+
+    /// The total wall time of the full calculations of the stored solutions (in units of s).
+    double time_records = 0.0;
+
+    /// The solution of the last successful calculation, used for warm-starting.
+    OptimumState laststate;
+
+    /// The parameters of the current step-by-step calculation.
+    const OptimumParams* pparams = nullptr;
+
+    /// The state of the current step-by-step calculation.
+    OptimumState* pstate = nullptr;
+
+    /// The time point at which the current calculation began.
+    Time timestart;
+
+    /// The flag that indicates whether the iterations of the current calculation began.
+    bool initialized = false;
+
+    /// The flag that indicates whether more iterations are needed in the current calculation.
+    bool iterating = false;
+
+    /// The flag that indicates whether the first Newton step of the current calculation can reuse the last decomposition.
+    bool reusedecomposition = false;
+
+    /// The number of consecutive iterations that reused the last decomposition.
+    Index numreuses = 0;
+
+    /// The bound at which each variable is fixed along the iterations (0 if not fixed, 1 for lower and 2 for upper bound, 3 if released).
+    Indices activebounds;
+
+    /// The number of consecutive iterations of each variable at its lower or upper bound with negligible slack.
+    Indices numatbounds;
+
+    /// The indices of the variables fixed at their lower and upper bounds along the iterations.
+    Indices iactivelower, iactiveupper;
+
+    /// The flag that indicates whether the variables fixed at their bounds changed since the last decomposition.
+    bool activechanged = false;
+
+    /// The objective values at the current and previous iterates.
+    double fcurrent = 0.0, fprevious = 0.0;
+
+    /// The smallest residual error found so far in the current calculation.
+    double errorbest = infinity();
+
+    /// The number of consecutive iterations without progress in either the residual error or the objective value.
+    Index numstagnated = 0;
+
+    /// The smallest feasibility error found so far in the current calculation.
+    double feasibilitybest = infinity();
+
+    /// The number of consecutive iterations with diverging multipliers and without progress in the feasibility error.
+    Index numinfeasible = 0;
+
+    /// The length of the last Newton step accepted by the line search (one if the line search is not active).
+    double steplength = 1.0;
+
+    /// The largest multiplier (in y, z and w) of the last iteration.
+    double multiplierlast = 0.0;
+
+    /// The iterate with the smallest residual error in the current calculation (kept only if it can be cut off).
+    OptimumState bestiterate;
+
+    /// The result of the current calculation at the iterate with the smallest residual error.
+    OptimumResult bestresult;
+
+    /// The scaling of the optimization problem.
+    OptimumScaling scaling;
+
+    /// The scaled parameters and state of the current calculation, used instead of the given ones if the problem is scaled.
+    OptimumParams scaledparams;
+    OptimumState scaledstate;
+
+    /// The given parameters and state of the current calculation if the problem is scaled.
+    const OptimumParams* punscaledparams = nullptr;
+    OptimumState* punscaledstate = nullptr;
+
+    /// The scaled evaluation of the objective function given to the current step of the calculation.
+    ObjectiveResult fscaled;
+
+    /// The solver of the optimization problem through its presolved problem.
+    OptimumPresolvedSolver presolvedsolver;
+
+    /// The flag that indicates if the current calculation is performed with the presolved problem.
+    bool presolving = false;
+
+    /// The solver of the optimization problem in the space of its non-basic variables, created in the first calculation that needs it.
+    std::optional<OptimumReducedSolver> reducedsolver;
+
+    /// The flag that indicates if the current calculation is performed in the space of the non-basic variables.
+    bool reducing = false;
+
     /// The number of variables
     Index n;
 
@@ -117,7 +234,7 @@ struct OptimumSolver::Impl
 
     /// Initialize the optimization solver with the structure of the problem.
     Impl(const OptimumStructure& structure)
-    : structure(structure), stepper(structure)
+    : structure(structure), stepper(structure), A(structure.A), presolvedsolver(structure)
     {
         // Initialize the members related to number of variables and constraints
         n = structure.numVariables();
@@ -130,6 +247,10 @@ struct OptimumSolver::Impl
         // Allocate memory
         xtrial.resize(n);
 
+        // Initialize the variables fixed at their bounds along the iterations (none)
+        activebounds = zeros<Index>(n);
+        numatbounds = zeros<Index>(n);
+
         // Initialize xlower and xupper with -inf and +inf
         xlower = constants(n, -infinity());
         xupper = constants(n,  infinity());
@@ -141,9 +262,31 @@ struct OptimumSolver::Impl
     	// Set member options
     	options = _options;
 
+        // Scale the problem (or undo its last scaling), and forget the stored solutions of the previously scaled or unscaled problem
+        if(options.scaling.active || scaling.active())
+        {
+            scaling.initialize(structure, options.scaling);
+            stepper = OptimumStepper(scaling.active() ? scaling.scaled(structure) : structure);
+            A = scaling.active() ? scaling.scaled(structure).A : structure.A;
+            records.clear();
+            records_b = KdTree();
+            time_records = 0.0;
+            irecord = -1;
+            laststate = OptimumState();
+        }
+
         // Set the options of the optimization stepper
         stepper.setOptions(options);
 
+        // Set the options of the solver of the presolved problem
+        presolvedsolver.setOptions(options);
+
+        // Set the options of the solver in the space of the non-basic variables (created in the first calculation that needs it)
+        if(options.reduced_space && m > 0 && !reducedsolver)
+            reducedsolver = OptimumReducedSolver(structure);
+        if(reducedsolver)
+            reducedsolver->setOptions(options);
+
         // Set the options of the outputter
         outputter.setOptions(options.output);
     }
@@ -217,6 +360,9 @@ struct OptimumSolver::Impl
         xlower(ilower) = params.xlower;
         xupper(iupper) = params.xupper;
 
+        // Check if the calculation can be warm-started with the given z and w
+        const bool warmstart = options.warmstart && state.z.size() == n && state.w.size() == n;
+
         // Ensure the initial guesses for x, y, z, w have proper dimensions
         if(state.x.size() != n) state.x = zeros(n);
         if(state.y.size() != m) state.y = zeros(m);
@@ -227,55 +373,126 @@ struct OptimumSolver::Impl
         for(Index i : ilower) state.x[i] = std::max(state.x[i], xlower[i] + options.mu);
         for(Index i : iupper) state.x[i] = std::min(state.x[i], xupper[i] - options.mu);
 
-        // Ensure z = mu/(x - xlower) for variables with lower bounds
+        // Ensure z = mu/(x - xlower) for variables with lower bounds (only those with z <= 0 if warm-starting)
         for(Index i : ilower)
-        	state.z[i] = state.x[i] == xlower[i] ?
-        		+1.0 : options.mu / (state.x[i] - xlower[i]);
+            if(!warmstart || state.z[i] <= 0.0)
+        	    state.z[i] = state.x[i] == xlower[i] ?
+        		    +1.0 : options.mu / (state.x[i] - xlower[i]);
 
-        // Ensure w = mu/(xupper - x) for variables with upper bounds
+        // Ensure w = mu/(xupper - x) for variables with upper bounds (only those with w >= 0 if warm-starting)
         for(Index i : iupper)
-        	state.w[i] = state.x[i] == xupper[i] ?
-        		-1.0 : options.mu / (state.x[i] - xupper[i]);
+            if(!warmstart || state.w[i] >= 0.0)
+        	    state.w[i] = state.x[i] == xupper[i] ?
+        		    -1.0 : options.mu / (state.x[i] - xupper[i]);
 
         // Set the values of x, z, w corresponding to fixed variables
         state.x(ifixed) = params.xfixed;
         state.z(ifixed).fill(0.0);
         state.w(ifixed).fill(0.0);
 
-        // Evaluate the objective function
-        evaluateObjectiveFunction(params, state);
+        // Check if the first Newton step can reuse the last decomposition (when warm-starting from the last solution)
+        reusedecomposition = warmstart && isLastState(state);
+	}
 
-        // Assert the objective function produces finite numbers at this point
-        Assert(isfinite(f),
-			"Failure evaluating the objective function.", "The evaluation of "
-			"the objective function at the entry point of the optimization "
-			"calculation produced non-finite numbers, "
-			"such as `nan` and/or `inf`.");
+    /// Return true if the given state is the solution of the last successful calculation.
+    auto isLastState(const OptimumState& state) const -> bool
+    {
+        return laststate.x.size() == n &&
+            state.x == laststate.x && state.y == laststate.y &&
+            state.z == laststate.z && state.w == laststate.w;
+    }
 
-        // Compute the Newton step for the current state
-        computeNewtonStep(params, state);
+    /// Return true if the Hessian matrix of the objective function is approximated with a quasi-Newton mode.
+    auto quasiNewton() const -> bool
+    {
+        return options.hessian.mode != HessianMode::Exact && !structure.hasConstantHessian();
+    }
 
-        // Update the optimality, feasibility and complementarity errors
-        updateResultErrors();
-	}
+    /// Return true if the Hessian matrix of the objective function needs to be evaluated together with its gradient.
+    /// This is not needed if the Hessian matrix is constant (e.g., in quadratic and linear programming problems),
+    /// approximated, or if the current iteration is expected to reuse the last decomposition.
+    auto needsHessian() const -> bool
+    {
+        return !structure.hasConstantHessian() && !quasiNewton() && needsDecomposition();
+    }
+
+    /// Return true if the current iteration needs a new decomposition according to the reuse policy.
+    auto needsDecomposition() const -> bool
+    {
+        // Compute a new decomposition if the variables fixed at their bounds changed
+        if(activechanged)
+            return true;
 
-    // Evaluate the objective function
+        // Reuse the last decomposition in the first iteration only when warm-starting from the last solution
+        if(result.iterations == 0)
+            return !reusedecomposition;
+
+        // Compute a new decomposition once the last one has been used for the given number of iterations
+        return numreuses + 1 >= options.reuse.period;
+    }
+
+    // Evaluate the objective function (with its Hessian matrix only if needed in the current iteration)
     auto evaluateObjectiveFunction(const OptimumParams& params, OptimumState& state) -> void
+    {
+        evaluateObjectiveFunction(params, state, needsHessian());
+    }
+
+    // Evaluate the objective function (with its Hessian matrix only if `hessian` is true)
+    auto evaluateObjectiveFunction(const OptimumParams& params, OptimumState& state, bool hessian) -> void
 	{
         // Establish the current needs for the objective function evaluation
         f.requires.value = true;
         f.requires.gradient = true;
-        f.requires.hessian = true;
+        f.requires.hessian = hessian;
 
         // Evaluate the objective function
+        Timer timer;
         f.gradient.resize(n);
+        if(hessian) f.hessian.diagonal.resize(n);
+        if(hessian) f.hessian.dense.resize(n, n);
+        params.objective(state.x, f);
+
+        // Update the number of evaluations and the time spent in them
+        result.num_objective_evals += 1;
+        result.num_hessian_evals += hessian;
+        result.time_objective_evals += timer.elapsed();
+	}
+
+    /// Return the given evaluation of the objective function if it has the Hessian matrix, or evaluate it otherwise.
+    auto evaluateHessian(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& fx) -> const ObjectiveResult&
+    {
+        // Skip if the Hessian matrix is constant, approximated or already evaluated
+        if(structure.hasConstantHessian() || quasiNewton() || fx.requires.hessian)
+            return fx;
+
+        // Assert the Hessian matrix can be evaluated
+        Assert(params.objective, "Could not compute a Newton step.",
+            "The Hessian matrix was not evaluated and there is no objective function to evaluate it.");
+
+        // Copy the evaluated value and gradient of the objective function (if not already in f)
+        if(&fx != &f) f = fx;
+
+        // Establish the current needs for the objective function evaluation
+        f.requires.value = false;
+        f.requires.gradient = false;
+        f.requires.hessian = true;
+
+        // Evaluate only the Hessian matrix of the objective function
+        Timer timer;
         f.hessian.diagonal.resize(n);
         f.hessian.dense.resize(n, n);
         params.objective(state.x, f);
-	}
+
+        // Update the number of evaluations and the time spent in them
+        result.num_objective_evals += 1;
+        result.num_hessian_evals += 1;
+        result.time_objective_evals += timer.elapsed();
+
+        return f;
+    }
 
     // The function that computes the Newton step
-    auto computeNewtonStep(const OptimumParams& params, OptimumState& state) -> void
+    auto computeNewtonStep(const OptimumParams& params, OptimumState& state, const ObjectiveResult& f) -> void
     {
     	Timer timer;
 
@@ -294,10 +511,194 @@ struct OptimumSolver::Impl
 			"The decomposition of the Jacobian matrix succeeded, but the "
 			"step calculation failed.");
 
+        // Update the number of decompositions and the time spent in linear systems
+        result.num_factorizations += 1;
+		result.time_linear_systems += timer.elapsed();
+
+        // The new decomposition accounts for the current variables fixed at their bounds
+        activechanged = false;
+    };
+
+    /// Release all variables fixed at their bounds, so that a new calculation starts with all variables free.
+    auto resetActiveSet() -> void
+    {
+        // Reset the bounds and counters of all variables, including those released in the last calculation
+        activebounds.fill(0);
+        numatbounds.fill(0);
+
+        // Skip if no variable is fixed at its bounds
+        if(iactivelower.size() + iactiveupper.size() == 0)
+            return;
+
+        iactivelower.resize(0);
+        iactiveupper.resize(0);
+        stepper.fixVariablesAtBounds(iactivelower, iactiveupper);
+        activechanged = true;
+    }
+
+    /// Update the variables fixed at their bounds after the current iteration. The variables whose multipliers
+    /// would change sign in the last step are released, and those that remained at their bounds with negligible
+    /// slack for OptimumActiveSetOptions::iterations consecutive feasible iterations are fixed at their bounds.
+    /// A released variable is not fixed again in the current calculation, which prevents the active set from cycling.
+    /// Infeasible iterations are not counted, since the variables may be at their bounds only because the
+    /// iterations did not progress yet (e.g., when starting from an initial guess at the bounds).
+    auto updateActiveSet() -> void
+    {
+        // Skip if the variables at their bounds are not fixed along the iterations
+        if(!options.activeset.active)
+            return;
+
+        // The indices of the variables at their lower and upper bounds with negligible slack in the last decomposition
+        IndicesConstRef jz = stepper.variablesAtLowerBounds();
+        IndicesConstRef jw = stepper.variablesAtUpperBounds();
+
+        // Release the variables whose multipliers would change sign, which are not fixed again in the current calculation to avoid cycling
+        for(Index i : stepper.releasedVariables())
+            activebounds[i] = 3;
+
+        bool changed = stepper.releasedVariables().size() > 0;
+
+        // Update the number of consecutive feasible iterations at the bounds of the free variables (zero for those not in jz and jw)
+        const Indices numatboundsprev = numatbounds;
+        const bool feasible = result.error_feasibility <= options.tolerance || result.error_feasibility < feasibilitybest;
+        numatbounds.fill(0);
+        for(Index i : jz) numatbounds[i] = feasible ? numatboundsprev[i] + 1 : 0;
+        for(Index i : jw) numatbounds[i] = feasible ? numatboundsprev[i] + 1 : 0;
+
+        // Fix the free variables that remained at their bounds for the given number of consecutive iterations
+        for(Index i : jz) if(activebounds[i] == 0 && numatbounds[i] >= options.activeset.iterations) { activebounds[i] = 1; changed = true; }
+        for(Index i : jw) if(activebounds[i] == 0 && numatbounds[i] >= options.activeset.iterations) { activebounds[i] = 2; changed = true; }
+
+        // Skip if the variables fixed at their bounds are the same
+        if(!changed)
+            return;
+
+        // Collect the indices of the variables fixed at their lower and upper bounds
+        iactivelower.resize(n);
+        iactiveupper.resize(n);
+        Index nlower = 0, nupper = 0;
+        for(Index i = 0; i < n; ++i)
+        {
+            if(activebounds[i] == 1) iactivelower[nlower++] = i;
+            if(activebounds[i] == 2) iactiveupper[nupper++] = i;
+        }
+        iactivelower.conservativeResize(nlower);
+        iactiveupper.conservativeResize(nupper);
+
+        stepper.fixVariablesAtBounds(iactivelower, iactiveupper);
+        activechanged = true;
+    }
+
+    // The function that computes the Newton step using the last decomposition of the Jacobian matrix
+    auto computeNewtonStepWithLastDecomposition(const OptimumParams& params, OptimumState& state, const ObjectiveResult& f) -> void
+    {
+        Timer timer;
+
+        // Update the residual vector for the current state, without decomposing the Jacobian matrix
+        stepper.residual(params, state, f);
+
+        // Calculate the Newton step using the last decomposition of the Jacobian matrix
+        Result res = stepper.solve(params, state, f);
+
+        // Assert the calculation of the Newton step succeeded
+        Assert(res.success(), "Could not compute a Newton step.",
+			"The calculation of the step using the last decomposition failed.");
+
         // Update the time spent in linear systems
 		result.time_linear_systems += timer.elapsed();
     };
 
+    // The function that computes the Newton step according to the policy for reusing the last decomposition of the Jacobian matrix
+    auto computeNewtonStepWithReusePolicy(const OptimumParams& params, OptimumState& state, const ObjectiveResult& f) -> void
+    {
+        // The residual error of the previous iteration
+        const double errorprev = result.error;
+
+        // Try the last decomposition first, if permitted in the current iteration
+        if(!needsDecomposition())
+        {
+            computeNewtonStepWithLastDecomposition(params, state, f);
+            updateResultErrors();
+
+            // Accept the Newton step if the residual error contracted sufficiently (or if warm-starting in the first iteration)
+            if(result.iterations == 0 || result.error <= options.reuse.contraction * errorprev)
+            {
+                numreuses += 1;
+                result.num_factorizations_saved += 1;
+                return;
+            }
+        }
+
+        // Compute the Newton step with a new decomposition, evaluating the Hessian matrix first if needed
+        computeNewtonStep(params, state, evaluateHessian(params, state, f));
+        updateResultErrors();
+
+        numreuses = 0;
+    }
+
+    /// Update the barrier parameter of the interior-point method for the current state.
+    auto updateBarrier(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> void
+    {
+        switch(options.barrier.mode)
+        {
+        case BarrierMode::Monotone: updateBarrierMonotone(params, state, f); break;
+        case BarrierMode::LOQO: updateBarrierLOQO(state); break;
+        default: break;
+        }
+    }
+
+    /// Update the barrier parameter with the monotone Fiacco-McCormick strategy.
+    auto updateBarrierMonotone(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> void
+    {
+        // The current barrier parameter
+        double mu = stepper.barrier();
+
+        // Decrease the barrier parameter while the current state solves the barrier problem with sufficient accuracy
+        while(mu > options.mu)
+        {
+            // The residual of the barrier problem for the current barrier parameter (without decomposing the Jacobian matrix)
+            const auto r = stepper.residual(params, state, f);
+            const double error = std::max({norminf(r.a), norminf(r.b), norminf(r.c), norminf(r.d)});
+
+            if(error > options.barrier.kappa_epsilon * mu)
+                break;
+
+            // Decrease the barrier parameter linearly at first and then superlinearly
+            mu = std::max(options.mu, std::min(options.barrier.kappa * mu, std::pow(mu, options.barrier.theta)));
+            stepper.setBarrier(mu);
+        }
+    }
+
+    /// Update the barrier parameter with the LOQO rule based on the complementarity of the current state.
+    auto updateBarrierLOQO(const OptimumState& state) -> void
+    {
+        // The indices of the variables with lower and upper bounds
+        IndicesConstRef ilower = structure.variablesWithLowerBounds();
+        IndicesConstRef iupper = structure.variablesWithUpperBounds();
+
+        // The number of complementarity products
+        const Index nb = ilower.size() + iupper.size();
+
+        if(nb == 0)
+            return;
+
+        // Calculate the average and the smallest complementarity products
+        double sum = 0.0, smallest = infinity();
+        for(Index i : ilower) { const double p = (state.x[i] - xlower[i]) * state.z[i]; sum += p; smallest = std::min(smallest, p); }
+        for(Index i : iupper) { const double p = (state.x[i] - xupper[i]) * state.w[i]; sum += p; smallest = std::min(smallest, p); }
+        const double average = sum/nb;
+
+        // The deviation of the smallest complementarity product from the average one (zero when all products are equal)
+        const double xi = average > 0.0 ? smallest/average : 1.0;
+        const double spread = xi > 0.0 ? std::min(0.05 * (1.0 - xi)/xi, 2.0) : 2.0;
+
+        // The barrier parameter as a fraction of the average complementarity, larger for more uneven products
+        const double mu = 0.1 * std::pow(spread, 3) * average;
+
+        // Set the barrier parameter, bounded above to prevent it from growing together with diverging complementarity products
+        stepper.setBarrier(std::max(options.mu, std::min(mu, options.barrier.initial)));
+    }
+
 	// Update the optimality, feasibility and complementarity errors
 	auto updateResultErrors() -> void
 	{
@@ -317,98 +718,172 @@ struct OptimumSolver::Impl
 	}
 
     // Update the variables (x, y, z, w) with a Newton stepping scheme
-    auto applyNewtonStepping(const OptimumParams& params, OptimumState& state) -> void
+    auto applyNewtonStepping(const OptimumParams& params, OptimumState& state, const ObjectiveResult& f) -> void
     {
+		// Aliases to variables x, y, z, w
+		VectorRef x = state.x;
+		VectorRef y = state.y;
+		VectorRef z = state.z;
+		VectorRef w = state.w;
+
+		// Alias to the Newton step of the y-Lagrange multipliers
+		VectorConstRef dy = stepper.step().y;
+
+        // The indices of variables with fixed values
+        IndicesConstRef ifixed = structure.variablesWithFixedValues();
+
+        // Calculate the trial Newton steps (dxtrial, dztrial, dwtrial) and the trial iterate xtrial
         switch(options.step) {
-        case Aggressive: return applyNewtonSteppingAggressive(params, state);
-        default: return applyNewtonSteppingConservative(params, state);
+        case Aggressive: computeTrialStepAggressive(state); break;
+        default: computeTrialStepConservative(state); break;
+        }
+
+        // Ensure the trial iterate does not change the values of fixed variables
+        xtrial(ifixed) = params.xfixed;
+        dxtrial(ifixed).fill(0.0);
+
+        // Calculate the length of the trial Newton steps with a backtracking line search, if active
+        const double alpha = options.linesearch.active ?
+            applyBacktrackingLineSearch(params, state, f) : 1.0;
+
+        steplength = alpha;
+
+        // Update the x variables with the accepted trial iterate
+        x = xtrial;
+
+        // Update the Lagrange multipliers y, z, w
+        if(alpha == 1.0)
+        {
+            y += dy;
+            z += dztrial;
+            w += dwtrial;
         }
+        else
+        {
+            y += alpha * dy;
+            z += alpha * dztrial;
+            w += alpha * dwtrial;
+        }
+
+		// Set the values of z, w corresponding to fixed variables
+		z(ifixed).fill(0.0);
+		w(ifixed).fill(0.0);
     };
 
-    /// Perform a backtracking line search algorithm to check if a shorter
-    /// Newton step results in better residuals.
-    auto applyBacktrackingLineSeach() -> void
+    /// Return the merit function used in the line search, combining the objective value and a penalty on the infeasibility of \eq{Ax = b}.
+    /// The bounds are not part of the merit function, since the trial iterates are always kept strictly within them.
+    auto meritFunction(const OptimumParams& params, VectorConstRef x, double fvalue, double penalty) const -> double
+    {
+        return m ? fvalue + penalty * (A * x - params.b).lpNorm<1>() : fvalue;
+    }
+
+    /// Return the directional derivative of the merit function along the trial step dxtrial.
+    /// For the penalty on the infeasibility, an upper bound of its directional derivative is used.
+    auto meritDirectionalDerivative(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f, double penalty) const -> double
+    {
+        double dphi = f.gradient.dot(dxtrial);
+        if(m)
+        {
+            const Vector r = A * state.x - params.b;
+            dphi += penalty * ((r + A * dxtrial).lpNorm<1>() - r.lpNorm<1>());
+        }
+        return dphi;
+    }
+
+    /// Perform a backtracking line search along the trial Newton step and return the accepted step length.
+    /// The objective function is evaluated at the trial iterates with only its value required, so that
+    /// no gradient or Hessian is computed. The trial iterate xtrial is updated with the accepted one.
+    auto applyBacktrackingLineSearch(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> double
 	{
-    	// Skip if first iteration
+        // Skip if there is no objective function for evaluating trial iterates (e.g., in a step-by-step calculation with evaluations given to step)
+        if(!params.objective)
+            return 1.0;
 
-    	// TODO Use dxtrial to calculate alpha step length to decrease the stepping
+        // Aliases to variables x and to the Newton step of y
+        VectorConstRef x = state.x;
+        VectorConstRef dy = stepper.step().y;
 
-//		// Establish the current needs for the objective function evaluation at the trial iterate
-//		f.requires.f = true;
-//		f.requires.g = false;
-//		f.requires.H = false;
-//
-//		// Evaluate the objective function at the trial iterate
-//		f = params.objective(xtrial);
-//
-//		state.f = f.f;
-//		state.g = f.g;
-//		state.H = f.H;
-//
-//		// Initialize the step length factor
-//		double alpha = fractionToTheBoundary(x, dx, options.tau);
-//
-//		// The number of tentatives to find a trial iterate that results in finite objective result
-//		unsigned tentatives = 0;
-//
-//		// Repeat until f(xtrial) is finite
-//		while(!isfinite(f) && ++tentatives < 10)
-//		{
-//			// Calculate a new trial iterate using a smaller step length
-//			xtrial = x + alpha * dx;
-//
-//			// Evaluate the objective function at the new trial iterate
-//			f.requires.f = true;
-//			f.requires.g = false;
-//			f.requires.H = false;
-//			f = params.objective(xtrial);
-//
-//			state.f = f.f;
-//			state.g = f.g;
-//			state.H = f.H;
-//
-//			// Decrease the current step length
-//			alpha *= 0.5;
-//		}
-//
-//		// Return false if xtrial could not be found s.t. f(xtrial) is finite
-//		if(tentatives == 10)
-//			return false;
-//
-//		// Update the iterate x from xtrial
-//		x = xtrial;
-//
-//		// Update the gradient and Hessian at x
-//		f.requires.f = false;
-//		f.requires.g = true;
-//		f.requires.H = true;
-//		f = params.objective(x);
-//
-//		state.f = f.f;
-//		state.g = f.g;
-//		state.H = f.H;
+        // The indices of variables with fixed values
+        IndicesConstRef ifixed = structure.variablesWithFixedValues();
 
+        // The penalty parameter for the infeasibility, which must exceed the magnitude of the y-Lagrange multipliers
+        const double penalty = m ? norminf(state.y + dy) + 1.0 : 0.0;
+
+        // The merit function at the current iterate
+        const double phi = meritFunction(params, x, f.value, penalty);
+
+        // The directional derivative (or an upper bound of it) of the merit function along the trial step
+        double dphi = meritDirectionalDerivative(params, state, f, penalty);
+
+        // The tolerance for round-off errors in the comparison of merit function values, which scales with the magnitude of their terms
+        double magnitude = std::abs(f.value);
+        if(m) magnitude += penalty * (A.cwiseAbs() * x.cwiseAbs() + params.b.cwiseAbs()).sum();
+        const double roundoff = 100.0 * std::numeric_limits<double>::epsilon() * std::max(magnitude, 1.0);
+
+        // The boolean flag that indicates if the trial step still needs to be replaced by one that preserves the direction of the Newton step
+        bool aggressive = options.step == Aggressive;
+
+        // Establish the current needs for the objective function evaluation at the trial iterates
+        ftrial.requires.value = true;
+        ftrial.requires.gradient = false;
+        ftrial.requires.hessian = false;
+
+		// Initialize the step length factor
+        double alpha = 1.0;
+
+        for(unsigned k = 0; ; ++k)
+        {
+            // Calculate the trial iterate for the current step length (the full step is already in xtrial)
+            if(k > 0) xtrial = x + alpha * dxtrial;
+
+            // Evaluate only the value of the objective function at the trial iterate
+            Timer timer;
+            ftrial.gradient.resize(n);
+            params.objective(xtrial, ftrial);
+            result.num_objective_evals += 1;
+            result.time_objective_evals += timer.elapsed();
+
+            // Accept the trial iterate if the merit function decreases sufficiently (or simply decreases, if not a descent direction)
+            const double decrease = dphi < 0.0 ? options.linesearch.armijo * alpha * dphi : 0.0;
+            if(std::isfinite(ftrial.value) && meritFunction(params, xtrial, ftrial.value, penalty) <= phi + decrease + roundoff)
+                return alpha;
+
+            // Accept the last trial iterate if the maximum number of backtracking steps has been reached
+            if(k == options.linesearch.max_backtracks)
+                return alpha;
+
+            // Replace a rejected aggressive step, clipped at the bounds, by one that preserves the direction of the Newton step
+            if(aggressive)
+            {
+                aggressive = false;
+                computeTrialStepConservative(state);
+                xtrial(ifixed) = params.xfixed;
+                dxtrial(ifixed).fill(0.0);
+                dphi = meritDirectionalDerivative(params, state, f, penalty);
+                continue;
+            }
+
+            // Decrease the step length
+            alpha *= options.linesearch.backtrack;
+        }
 	}
 
-	// Update the variables (x, y, z, w) with an aggressive Newton stepping scheme
-	auto applyNewtonSteppingAggressive(const OptimumParams& params, OptimumState& state) -> void
+	// Calculate the trial Newton step with an aggressive stepping scheme
+	auto computeTrialStepAggressive(const OptimumState& state) -> void
 	{
-		// Aliases to variables x, y, z, w
-		VectorRef x = state.x;
-		VectorRef y = state.y;
-		VectorRef z = state.z;
-		VectorRef w = state.w;
+		// Aliases to variables x, z, w
+		VectorConstRef x = state.x;
+		VectorConstRef z = state.z;
+		VectorConstRef w = state.w;
 
 		// Aliases to Newton steps calculated before
 		VectorConstRef dx = stepper.step().x;
-		VectorConstRef dy = stepper.step().y;
 		VectorConstRef dz = stepper.step().z;
 		VectorConstRef dw = stepper.step().w;
 
-        // The indices of variables with lower/upper bounds and fixed values
+        // The indices of variables with lower/upper bounds
         IndicesConstRef ilower = structure.variablesWithLowerBounds();
         IndicesConstRef iupper = structure.variablesWithUpperBounds();
-        IndicesConstRef ifixed = structure.variablesWithFixedValues();
 
 		// Update xtrial with the calculated Newton step
 		xtrial = x + dx;
@@ -426,185 +901,736 @@ struct OptimumSolver::Impl
 		// Calculate the trial Newton step for the aggressive mode
 		dxtrial = xtrial - x;
 
-		// Update the z-Lagrange multipliers for variables with lower bounds
+		// Calculate the trial step of the z-Lagrange multipliers for variables with lower bounds
+		dztrial.setZero(n);
 		for(Index i : ilower)
-			z[i] += (z[i] + dz[i] > 0.0) ?
+			dztrial[i] = (z[i] + dz[i] > 0.0) ?
 				dz[i] : -options.tau * z[i];
 
-		// Update the w-Lagrange multipliers for variables with upper bounds
+		// Calculate the trial step of the w-Lagrange multipliers for variables with upper bounds
+		dwtrial.setZero(n);
 		for(Index i : iupper)
-			w[i] += (w[i] + dw[i] < 0.0) ?
+			dwtrial[i] = (w[i] + dw[i] < 0.0) ?
 				dw[i] : -options.tau * w[i];
+	};
 
-		// Update the x variables
-		x = xtrial;
+	// Calculate the trial Newton step with a conservative stepping scheme, which preserves the direction of the steps
+	auto computeTrialStepConservative(const OptimumState& state) -> void
+	{
+		// Aliases to variables x, z, w
+		VectorConstRef x = state.x;
+		VectorConstRef z = state.z;
+		VectorConstRef w = state.w;
 
-		// Update the y-Lagrange multipliers
-		y += dy;
+		// Aliases to Newton steps calculated before
+		VectorConstRef dx = stepper.step().x;
+		VectorConstRef dz = stepper.step().z;
+		VectorConstRef dw = stepper.step().w;
 
-		// Set the values of x, z, w corresponding to fixed variables
-		x(ifixed) = params.xfixed;
-		z(ifixed).fill(0.0);
-		w(ifixed).fill(0.0);
-	};
+        // The indices of variables with lower/upper bounds
+        IndicesConstRef ilower = structure.variablesWithLowerBounds();
+        IndicesConstRef iupper = structure.variablesWithUpperBounds();
 
-	// Update the variables (x, y, z, w) with a conservative Newton stepping scheme
-	auto applyNewtonSteppingConservative(const OptimumParams& params, OptimumState& state) -> void
-	{
-//		// Aliases to variables x, y, z, w
-//		VectorRef x = state.x;
-//		VectorRef y = state.y;
-//		VectorRef z = state.z;
-//		VectorRef w = state.w;
-//
-//		// Aliases to Newton steps calculated before
-//		VectorConstRef dx = stepper.step().x;
-//		VectorConstRef dy = stepper.step().y;
-//		VectorConstRef dz = stepper.step().z;
-//		VectorConstRef dw = stepper.step().w;
-//
-//		// The indices of variables with lower/upper bounds and fixed values
-//		IndicesConstRef ilower = structure.variablesWithLowerBounds();
-//		IndicesConstRef iupper = structure.variablesWithUpperBounds();
-//		IndicesConstRef ifixed = structure.variablesWithFixedValues();
-//
-//		// Initialize the step length factor
-//		double alphax = xStepLength(x, dx, xlower, xupper, tau);
-//		double alphaz = zStepLength(z, dz, tau);
-//		double alphaw = wStepLength(w, dw, tau);
-//		double alpha = alphax;
-//
-//		// The number of tentatives to find a trial iterate that results in finite objective result
-//		unsigned tentatives = 0;
-//
-//		// Repeat until a suitable xtrial iterate if found such that f(xtrial) is finite
-//		for(; tentatives < 10; ++tentatives)
-//		{
-//			// Calculate the current trial iterate for x
-//			xtrial = x + alpha * dx;
-//
-//			// Evaluate the objective function at the trial iterate
-//			f.requires.f = true;
-//			f.requires.g = false;
-//			f.requires.H = false;
-//			f = params.objective(xtrial);
-//
-//			state.f = f.f;
-//			state.g = f.g;
-//			state.H = f.H;
-//
-//			// Leave the loop if f(xtrial) is finite
-//			if(isfinite(f))
-//				break;
-//
-//			// Decrease alpha in a hope that a shorter step results f(xtrial) finite
-//			alpha *= 0.01;
-//		}
-//
-//		// Return false if xtrial could not be found s.t. f(xtrial) is finite
-//		if(tentatives == 10)
-//			return false;
-//
-//		// Update the iterate x from xtrial
-//		x = xtrial;
-//
-//		// Update the z-Lagrange multipliers
-//		z += alphaz * dz;
-//
-//		// Update the w-Lagrange multipliers
-//		w += alphaw * dw;
-//
-//		// Update the y-Lagrange multipliers
-//		y += dy;
-//
-//		// Update the gradient and Hessian at x
-//		f.requires.f = false;
-//		f.requires.g = true;
-//		f.requires.H = true;
-//		f = params.objective(x);
-//
-//		state.f = f.f;
-//		state.g = f.g;
-//		state.H = f.H;
-//
-//		// Return true as found xtrial results in finite f(xtrial)
-//		return true;
+		// The step lengths of x, z, w that keep them strictly within their bounds
+		const Vector xl = x(ilower) - xlower(ilower);
+		const Vector xu = xupper(iupper) - x(iupper);
+		const double alphax = std::min(
+			fractionToTheBoundary(xl, dx(ilower), options.tau),
+			fractionToTheBoundary(xu, -dx(iupper), options.tau));
+		const double alphaz = fractionToTheBoundary(z(ilower), dz(ilower), options.tau);
+		const double alphaw = fractionToTheBoundary(-w(iupper), -dw(iupper), options.tau);
+
+		// Calculate the trial Newton steps along the directions of the Newton steps
+		dxtrial = alphax * dx;
+		xtrial = x + dxtrial;
+
+		dztrial.setZero(n);
+		dztrial(ilower) = alphaz * dz(ilower);
+
+		dwtrial.setZero(n);
+		dwtrial(iupper) = alphaw * dw(iupper);
 	};
 
-	/// Return true if the calculation converged.
-    auto converged() const -> bool
+    /// Return true if vector b is consistent with the linearly dependent rows of matrix A within the tolerance of the feasibility error.
+    auto consistent(VectorConstRef b) const -> bool
     {
+        const Canonicalizer& canonicalizer = stepper.canonicalizer();
+
+        // The rows of the canonicalizer matrix R corresponding to linearly dependent rows of A (i.e., with zero rows in RA)
+        const Index nl = m - canonicalizer.numBasicVariables();
+        const auto Rl = canonicalizer.R().bottomRows(nl);
+
+        // Check each row r of Rl, since no x satisfies max(abs(Ax - b)) < tolerance if abs(r*b) > tolerance * sum(abs(r))
+        for(Index i = 0; i < nl; ++i)
+            if(std::abs(Rl.row(i).dot(b)) > options.tolerance * Rl.row(i).lpNorm<1>())
+                return false;
+
+        return true;
+    }
+
+    /// Return true if the multipliers y, z and w of the current state are diverging, i.e., if they are very large
+    /// with respect to the given gradient and did not decrease sufficiently since the last iteration.
+    auto divergingMultipliers(const OptimumState& state, const ObjectiveResult& f) -> bool
+    {
+        // The largest multiplier of the current state
+        double largest = 0.0;
+        if(state.y.size()) largest = std::max(largest, norminf(state.y));
+        if(state.z.size()) largest = std::max(largest, norminf(state.z));
+        if(state.w.size()) largest = std::max(largest, norminf(state.w));
+
+        const bool diverging = largest > options.termination.infeasibility_multiplier * (1.0 + norminf(f.gradient))
+            && largest > (1.0 - options.termination.stagnation_decrease) * multiplierlast;
+
+        multiplierlast = largest;
+
+        return diverging;
+    }
+
+    /// Return the status of the calculation after the current iteration (OptimumStatus::Unfinished if more iterations are needed).
+    auto status(const OptimumState& state, const ObjectiveResult& f) -> OptimumStatus
+    {
+        // Check if the residual error is not finite, which no further iteration can fix
+        const auto r = stepper.residual();
+        if(!(r.a.allFinite() && r.b.allFinite() && r.c.allFinite() && r.d.allFinite()))
+            return OptimumStatus::Diverged;
+
+        // Check if the calculation should stop based on optimality condititions
+        if(result.error < options.tolerance)
+            return OptimumStatus::Converged;
+
         // Check if the calculation should stop based on max variation of x
         if(options.tolerancex && max(abs(stepper.step().x)) < options.tolerancex)
-            return true;
+            return OptimumStatus::SmallStep;
 
-        // todo you want to make sure the test for convergence should consider the residual of
-        // unstable variables in a special way!
+        // Check if the calculation should stop based on the variation of the objective value
+        if(options.tolerancef && result.iterations > 1 && std::abs(fcurrent - fprevious) < options.tolerancef)
+            return OptimumStatus::SmallObjectiveChange;
 
-        // Check if the calculation should stop based on optimality condititions
-        return result.error < options.tolerance;
+        // Check if the residual error has grown far above the smallest one found so far
+        const auto& termination = options.termination;
+        if(termination.divergence_ratio && result.error > termination.divergence_ratio * errorbest)
+            return OptimumStatus::Diverged;
+
+        // Update the smallest feasibility error found so far, only if it decreased sufficiently
+        const bool feasibilitydecreased = result.error_feasibility < (1.0 - termination.stagnation_decrease) * feasibilitybest;
+        if(feasibilitydecreased)
+            feasibilitybest = result.error_feasibility;
+
+        // Update the number of consecutive iterations in which the multipliers diverge while the feasibility error does not decrease.
+        // Iterations whose step was shortened by the line search are not counted, since the feasibility error then decreases slowly even in feasible problems.
+        const bool diverging = divergingMultipliers(state, f);
+        const bool infeasible = diverging && !feasibilitydecreased && result.error_feasibility > options.tolerance;
+        if(steplength == 1.0)
+            numinfeasible = infeasible ? numinfeasible + 1 : 0;
+
+        // Check if the equality constraints and the bounds seem to have no solution
+        if(termination.infeasibility_iterations && numinfeasible >= termination.infeasibility_iterations)
+            return OptimumStatus::Infeasible;
+
+        // Update the smallest residual error found so far, only if it decreased sufficiently
+        const bool errordecreased = result.error < (1.0 - termination.stagnation_decrease) * errorbest;
+        if(errordecreased)
+            errorbest = result.error;
+
+        // Check if the objective value has changed, which indicates progress even with a non-decreasing residual error
+        const bool objectivechanged = std::abs(fcurrent - fprevious) > termination.stagnation_objective * (1.0 + std::abs(fcurrent));
+
+        // Update the number of consecutive iterations without progress in either the residual error or the objective value
+        numstagnated = (errordecreased || objectivechanged || result.iterations == 1) ? 0 : numstagnated + 1;
+
+        // Check if the calculation has stagnated, which happens if the dual variables cycle while the primal ones are frozen
+        if(termination.stagnation_iterations && numstagnated >= termination.stagnation_iterations)
+            return OptimumStatus::Stagnated;
+
+        // Check if the maximum number of iterations has been reached
+        if(result.iterations >= options.max_iterations)
+            return OptimumStatus::MaxIterations;
+
+        return OptimumStatus::Unfinished;
     };
 
-    auto solve(const OptimumParams& params, OptimumState& state) -> OptimumResult
+    /// Return true if the calculation can be cut off by a time limit or a cancellation request.
+    auto cancellable() const -> bool
+    {
+        return options.max_time > 0.0 || options.cancellation;
+    }
+
+    /// Return the reason for cutting off the calculation (OptimumStatus::Unfinished if it should continue).
+    auto cutoff() const -> OptimumStatus
+    {
+        // Check if the calculation has exceeded its maximum wall time
+        if(options.max_time > 0.0 && elapsed(timestart) > options.max_time)
+            return OptimumStatus::TimeLimit;
+
+        // Check if the cancellation of the calculation has been requested
+        if(options.cancellation && options.cancellation())
+            return OptimumStatus::Cancelled;
+
+        return OptimumStatus::Unfinished;
+    }
+
+    /// Keep the given state if its residual error, already in the result, is the smallest one found so far.
+    auto updateBestIterate(const OptimumState& state) -> void
+    {
+        if(cancellable() && result.error < bestresult.error)
+        {
+            bestiterate = state;
+            bestresult = result;
+        }
+    }
+
+    /// Stop the cut off calculation with the iterate of smallest residual error found so far and return false.
+    auto stopWithBestIterate(OptimumState& state, OptimumStatus status) -> bool
+    {
+        // Restore the best iterate and its residual errors (if any iterate had a finite residual error)
+        if(bestresult.error < infinity())
+        {
+            state = bestiterate;
+            result.error                       = bestresult.error;
+            result.error_optimality            = bestresult.error_optimality;
+            result.error_feasibility           = bestresult.error_feasibility;
+            result.error_complementarity_lower = bestresult.error_complementarity_lower;
+            result.error_complementarity_upper = bestresult.error_complementarity_upper;
+        }
+
+        result.status = status;
+        result.succeeded = false;
+
+        return iterating = false;
+    }
+
+    /// Set the scaled parameters and state of the calculation, which are then used instead of the given ones.
+    auto scaleProblem(const OptimumParams& params, OptimumState& state) -> void
+    {
+        punscaledparams = &params;
+        punscaledstate = &state;
+
+        // Set the scaled parameters, with the scaled objective function evaluated from the given one (if any)
+        scaling.scale(structure, params, scaledparams);
+        scaledparams.objective = nullptr;
+        if(params.objective)
+            scaledparams.objective = [this](VectorConstRef x, ObjectiveResult& fx) { scaling.evaluate(punscaledparams->objective, x, fx); };
+
+        // Determine the scaling factor of the objective function in the first calculation
+        if(scaling.undetermined())
+        {
+            if(params.objective)
+                determineObjectiveScaling(state);
+            scaling.fixObjectiveScaling();
+        }
+
+        scaling.scale(state, scaledstate);
+
+        pparams = &scaledparams;
+        pstate = &scaledstate;
+    }
+
+    /// Determine the scaling factor of the objective function from its gradient at the initial guess.
+    auto determineObjectiveScaling(const OptimumState& state) -> void
+    {
+        // The initial guess of the scaled variables, strictly within the bounds
+        OptimumState initial;
+        scaling.scale(state, initial);
+        initialize(scaledparams, initial);
+
+        // Evaluate the value and gradient of the objective function, not yet scaled, at the initial guess
+        ObjectiveResult finitial;
+        finitial.requires.hessian = false;
+        scaledparams.objective(initial.x, finitial);
+        result.num_objective_evals += 1;
+
+        if(!isfinite(finitial))
+            return;
+
+        scaling.determine(finitial);
+
+        // Scale also the constant Hessian matrix of the objective function used by the optimization stepper
+        if(scaling.objectiveScaling() != 1.0 && structure.hasConstantHessian())
+        {
+            stepper = OptimumStepper(scaling.scaled(structure));
+            stepper.setOptions(options);
+        }
+    }
+
+    /// Update the given state of the calculation with the unscaled state of the scaled problem (if the problem is scaled).
+    auto unscaleState() -> void
+    {
+        if(scaling.active())
+            scaling.unscale(scaledstate, *punscaledstate);
+    }
+
+    /// Begin a step-by-step optimization calculation.
+    auto begin(const OptimumParams& params, OptimumState& state) -> void
     {
         // Start timing the calculation
-        Timer timer;
+        timestart = timenow();
+
+        // Store the parameters and the state of the calculation for the next steps
+        pparams = &params;
+        pstate = &state;
+
+        // Reset the flags of the calculation
+        iterating = false;
+        initialized = false;
+        presolving = false;
+        reducing = false;
+
+        // Auxiliary references to some result variables
+        auto& iterations = result.iterations = 0;
+        auto& succeeded = result.succeeded = false;
+        auto& status = result.status = OptimumStatus::Unfinished;
 
         // Finish the calculation if the problem has no variable
         if(n == 0)
         {
-            result.succeeded = true;
-            result.time = timer.elapsed();
-            return result;
+            succeeded = true;
+            status = OptimumStatus::Converged;
+            return;
         }
 
-        const auto maxiters = options.max_iterations;
+        // Reset the evaluation statistics of the calculation
+        result.num_objective_evals = 0;
+        result.num_hessian_evals = 0;
+        result.num_factorizations = 0;
+        result.num_factorizations_saved = 0;
+        result.time_objective_evals = 0.0;
+        result.time_linear_systems = 0.0;
+
+        // Reset the prediction statistics of the calculation
+        irecord = -1;
+        result.predicted = false;
+        result.num_prediction_attempts = 0;
+        result.num_prediction_hits = 0;
+        result.time_predictions = 0.0;
+        result.time_saved_by_predictions = 0.0;
+
+        // Perform the calculation with the presolved problem if presolve is active (the given state is then updated along the calculation)
+        presolving = options.presolve.active;
+        if(presolving)
+            return presolvedsolver.begin(params, state);
+
+        // Perform the calculation in the space of the non-basic variables if possible (the given state is then updated along the calculation)
+        reducing = options.reduced_space && reducedsolver && reducedsolver->reducible();
+        if(reducing)
+            return reducedsolver->begin(params, state);
+
+        // Perform the calculation with the scaled problem if scaling is active (the given state is then updated along the calculation)
+        if(scaling.active())
+            scaleProblem(params, state);
+
+        // Finish the calculation if vector b is inconsistent with the linearly dependent rows of matrix A
+        if(!consistent(pparams->b))
+        {
+            status = OptimumStatus::Infeasible;
+            return;
+        }
 
-        // Auxiliary references to some result variables
-        auto& iterations = result.iterations;
-        auto& succeeded = result.succeeded = false;
+        // Release the variables fixed at their bounds in the last calculation
+        resetActiveSet();
 
-        initialize(params, state);
-        outputInitialState(state);
+        // Reset the barrier parameter, so that predicted solutions are checked against the unperturbed residual
+        stepper.setBarrier(options.mu);
 
-        for(iterations = 1; iterations <= maxiters && !succeeded; ++iterations)
+        // Finish the calculation if the solution can be predicted from a previously calculated one
+        if(options.prediction.active && predict(*pparams, *pstate))
         {
-            applyNewtonStepping(params, state);
-            outputCurrentState(state);
+            unscaleState();
+            return;
+        }
 
-            if((succeeded = converged()))
-                break;
+        initialize(*pparams, *pstate);
+        unscaleState();
+
+        // Start with a larger barrier parameter in the monotone strategy
+        if(options.barrier.mode == BarrierMode::Monotone)
+            stepper.setBarrier(std::max(options.barrier.initial, options.mu));
+
+        // Reset the number of consecutive iterations that reused the last decomposition
+        numreuses = 0;
+
+        // Reset the history of residual errors used to detect stagnation, divergence and infeasibility
+        errorbest = infinity();
+        numstagnated = 0;
+        feasibilitybest = infinity();
+        numinfeasible = 0;
+        steplength = 1.0;
+        multiplierlast = 0.0;
+
+        // Reset the best iterate kept for calculations that can be cut off
+        bestresult.error = infinity();
+
+        // Initialize the Hessian approximation if a quasi-Newton mode is used
+        if(quasiNewton())
+            quasinewton.initialize(options.hessian, n);
+
+        initialized = true;
+        iterating = iterations < options.max_iterations;
+
+        // Finish the calculation if no iteration is allowed
+        if(!iterating)
+            status = OptimumStatus::MaxIterations;
+    }
+
+    /// Perform one iteration of the optimization calculation and return true if more iterations are needed.
+    auto step() -> bool
+    {
+        // Perform the iteration with the presolved problem if presolve is active
+        if(presolving)
+            return presolvedsolver.step();
+
+        // Perform the iteration in the space of the non-basic variables if the calculation is reduced
+        if(reducing)
+            return reducedsolver->step();
+
+        // Skip if the calculation has converged or the maximum number of iterations has been reached
+        if(!iterating)
+            return false;
+
+        // Evaluate the objective function at the current state
+        evaluateObjectiveFunction(*pparams, *pstate);
+
+        return advance(f);
+    }
+
+    /// Perform one iteration of the optimization calculation with the given evaluation of the objective function at the current state.
+    auto step(const ObjectiveResult& fx) -> bool
+    {
+        // Perform the iteration with the presolved problem if presolve is active
+        if(presolving)
+            return presolvedsolver.step(fx);
+
+        // Perform the iteration in the space of the non-basic variables if the calculation is reduced
+        if(reducing)
+            return reducedsolver->step(fx);
+
+        // Skip if the calculation has converged or the maximum number of iterations has been reached
+        if(!iterating)
+            return false;
+
+        // Scale the given evaluation of the objective function at the unscaled state if the problem is scaled
+        if(scaling.active())
+            scaling.scale(fx, fscaled);
+
+        return advance(scaling.active() ? fscaled : fx);
+    }
+
+    /// Perform one iteration with the given evaluation of the objective function, and update the unscaled state if the problem is scaled.
+    auto advance(const ObjectiveResult& fx) -> bool
+    {
+        const bool more = iterate(fx);
+        unscaleState();
+        return more;
+    }
+
+    /// Perform one iteration of the optimization calculation (of the scaled problem if it is scaled).
+    auto iterate(const ObjectiveResult& fx) -> bool
+    {
+        const auto& params = *pparams;
+        auto& state = *pstate;
 
-            evaluateObjectiveFunction(params, state);
-			computeNewtonStep(params, state);
-			updateResultErrors();
+        // Auxiliary references to some result variables
+        auto& iterations = result.iterations;
+        auto& succeeded = result.succeeded;
+
+        // Assert the objective function produces finite numbers at the entry point of the calculation
+        if(iterations == 0)
+            Assert(isfinite(fx),
+                "Failure evaluating the objective function.", "The evaluation of "
+                "the objective function at the entry point of the optimization "
+                "calculation produced non-finite numbers, "
+                "such as `nan` and/or `inf`.");
+
+        // Stop the calculation if it was cut off after the evaluation of the objective function (the current state is also a candidate for the best iterate)
+        OptimumStatus reason = cutoff();
+        if(reason != OptimumStatus::Unfinished)
+        {
+            stepper.residual(params, state, fx);
+            updateResultErrors();
+            updateBestIterate(state);
+            return stopWithBestIterate(state, reason);
         }
 
+        // Update the objective values at the current and previous iterates
+        fprevious = fcurrent;
+        fcurrent = fx.value;
+
+        // The evaluated objective function, with its Hessian matrix approximated if a quasi-Newton mode is used
+        const ObjectiveResult& f = quasiNewton() ? quasinewton.update(state.x, fx) : fx;
+
+        // Update the barrier parameter for the current state
+        updateBarrier(params, state, f);
+
+        // Compute the Newton step for the current state and update the optimality, feasibility and complementarity errors
+        computeNewtonStepWithReusePolicy(params, state, f);
+
+        // Keep the current state if it has the smallest residual error found so far
+        updateBestIterate(state);
+
+        // Stop the calculation if it was cut off after the decomposition of the saddle point matrix
+        if((reason = cutoff()) != OptimumStatus::Unfinished)
+            return stopWithBestIterate(state, reason);
+
+        if(iterations == 0)
+            outputInitialState(state);
+
+        ++iterations;
+
+        applyNewtonStepping(params, state, f);
+        outputCurrentState(state);
+
+        // Update the variables fixed at their bounds for the next iterations
+        updateActiveSet();
+
+        // Check if the calculation should stop, with success only if a convergence criterion is satisfied
+        result.status = status(state, f);
+        succeeded = result.status == OptimumStatus::Converged
+            || result.status == OptimumStatus::SmallStep
+            || result.status == OptimumStatus::SmallObjectiveChange;
+
+        // Stop the calculation if it was cut off after the update of the iterate
+        if(result.status == OptimumStatus::Unfinished && (reason = cutoff()) != OptimumStatus::Unfinished)
+            return stopWithBestIterate(state, reason);
+
+        return iterating = result.status == OptimumStatus::Unfinished;
+    }
+
+    /// Return true if the calculation has converged.
+    auto converged() const -> bool
+    {
+        if(presolving) return presolvedsolver.converged();
+        if(reducing) return reducedsolver->converged();
+        return result.succeeded;
+    }
+
+    /// Finish the step-by-step optimization calculation and return its result, which is also accumulated in `accumulated`.
+    auto finish() -> OptimumResult
+    {
+        const OptimumResult res = finishCalculation();
+        accumulated += res;
+        return res;
+    }
+
+    /// Finish the step-by-step optimization calculation and return its result.
+    auto finishCalculation() -> OptimumResult
+    {
+        // No more iterations can be performed after the calculation has finished
+        iterating = false;
+
+        // Finish the calculation with the presolved problem if presolve is active
+        if(presolving)
+            return result = presolvedsolver.finish();
+
+        // Finish the calculation in the space of the non-basic variables if the calculation is reduced
+        if(reducing)
+            return result = reducedsolver->finish();
+
+        // Finish timing the calculation
+        result.time = elapsed(timestart);
+
+        // Skip if the calculation finished before the iterations began (e.g., with a predicted solution)
+        if(!initialized)
+            return result;
+
+        initialized = false;
+
         // Output a final header
         outputter.outputHeader();
 
-        // Finish timing the calculation
-        result.time = timer.elapsed();
+        const auto& succeeded = result.succeeded;
+
+        // The flag that indicates if the calculation was cut off, in which case the errors of the best iterate are already known
+        const bool wascutoff = result.status == OptimumStatus::TimeLimit || result.status == OptimumStatus::Cancelled;
+
+        // Update the errors at the final state of a calculation that did not converge (if an objective function is available)
+        if(!succeeded && !wascutoff && result.iterations > 0 && pparams->objective)
+        {
+            evaluateObjectiveFunction(*pparams, *pstate, false);
+            if(isfinite(f))
+            {
+                stepper.residual(*pparams, *pstate, f);
+                updateResultErrors();
+            }
+        }
+
+        // Store the calculated solution for future predictions
+        if(options.prediction.active && succeeded)
+            learn(*pparams, *pstate);
+
+        // Store the calculated solution for warm-starting the next calculation
+        if(options.warmstart && succeeded)
+            laststate = *pstate;
 
         return result;
     }
 
-    /// Calculate the sensitivity of the optimal solution with respect to parameters.
-    auto dxdp(VectorConstRef dgdp, VectorConstRef dbdp) -> Matrix
+    /// Solve the optimization problem by iterating until convergence or the maximum number of iterations.
+    auto solve(const OptimumParams& params, OptimumState& state) -> OptimumResult
     {
-    	// TODO Implement the calculation of sensitivity derivatives
-//        // Initialize the right-hand side of the KKT equations
-//        rhs.rx.noalias() = -dgdp;
-//        rhs.ry.noalias() =  dbdp;
-//        rhs.rz.fill(0.0);
-//
-//        // Solve the KKT equations to get the derivatives
-//        kkt.solve(rhs, sol);
+        begin(params, state);
+        while(step()) {}
+        return finish();
+    }
+
+    /// Predict the solution from the stored one with nearest b and return true if the prediction is accepted.
+    auto predict(const OptimumParams& params, OptimumState& state) -> bool
+    {
+        // Skip if there is no stored solution, no equality constraint, or no objective function to check the prediction
+        if(records.empty() || m == 0 || !params.objective)
+            return false;
+
+        Timer timer;
+
+        result.num_prediction_attempts = 1;
+
+        // The stored solution with b nearest to the given one
+        const Index k = records_b.nearest(params.b);
+        const OptimumRecord& record = records[k];
+
+        // The variation of b with respect to the stored solution
+        const Vector db = params.b - records_b.point(k);
+
+        // Predict the solution using a first-order Taylor extrapolation
+        predicted.x = record.state.x + record.sensitivity.dxdp * db;
+        predicted.y = record.state.y + record.sensitivity.dydp * db;
+        predicted.z = record.state.z + record.sensitivity.dzdp * db;
+        predicted.w = record.state.w + record.sensitivity.dwdp * db;
+
+        // The indices of variables with lower/upper bounds and fixed values
+        IndicesConstRef ilower = structure.variablesWithLowerBounds();
+        IndicesConstRef iupper = structure.variablesWithUpperBounds();
+        IndicesConstRef ifixed = structure.variablesWithFixedValues();
+
+        // Set the values of x corresponding to fixed variables
+        predicted.x(ifixed) = params.xfixed;
+
+        // Check if the predicted solution is strictly within the bounds, and with proper signs for z and w
+        bool accepted =
+            ((predicted.x(ilower) - params.xlower).array() > 0.0).all() &&
+            ((predicted.x(iupper) - params.xupper).array() < 0.0).all() &&
+            (predicted.z(ilower).array() >= 0.0).all() &&
+            (predicted.w(iupper).array() <= 0.0).all();
+
+        // Check if the residual error of the predicted solution is small enough (the Hessian matrix is not needed for this)
+        if(accepted)
+        {
+            evaluateObjectiveFunction(params, predicted, false);
+
+            if((accepted = isfinite(f)))
+            {
+                stepper.residual(params, predicted, f);
+                updateResultErrors();
+                accepted = result.error < options.prediction.tolerance;
+            }
+        }
+
+        result.time_predictions = timer.elapsed();
+
+        // Skip if the predicted solution was not accepted
+        if(!accepted)
+            return false;
+
+        // Update the state and the result of the calculation with the predicted solution
+        state = predicted;
+        irecord = k;
+
+        result.succeeded = true;
+        result.status = OptimumStatus::Converged;
+        result.iterations = 0;
+        result.predicted = true;
+        result.num_prediction_hits = 1;
+        result.time_saved_by_predictions = std::max(time_records/records.size() - result.time_predictions, 0.0);
+
+        return true;
+    }
+
+    /// Store the calculated solution, together with its sensitivity derivatives with respect to b, for future predictions.
+    auto learn(const OptimumParams& params, const OptimumState& state) -> void
+    {
+        // Skip if the maximum number of stored solutions has been reached or there is no equality constraint
+        if(records.size() >= options.prediction.max_records || m == 0)
+            return;
 
-        assert(false);
+        // Calculate the sensitivity derivatives with respect to b using the last decomposition
+        OptimumRecord record;
+        record.state = state;
+        stepper.sensitivities(Matrix(), identity(m, m), record.sensitivity);
+
+        // Store the calculated solution
+        records.push_back(record);
+        records_b.insert(params.b);
+
+        // Update the total wall time of the full calculations of the stored solutions
+        time_records += result.time;
+    }
+
+    /// Calculate the sensitivity derivatives of a predicted solution, with the derivatives with respect to b of the stored solution from which it was predicted.
+    auto sensitivitiesPredicted(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> void
+    {
+        // The number of parameters
+        const Index np = std::max(dgdp.cols(), dbdp.cols());
+
+        // Solve the KKT equations for the derivatives of the gradient with the last decomposition, that of the last calculation not predicted,
+        // since only the derivatives with respect to b are stored (with scaled derivatives if the problem is scaled)
+        Result res = stepper.sensitivities(scaling.active() ? scaling.scaledGradientDerivatives(dgdp) : Matrix(dgdp), zeros(m, np), sensitivity);
+
+        // Assert the calculation of the sensitivity derivatives succeeded
+        Assert(res.success(), "Could not compute the sensitivity derivatives.",
+            "The solution of the KKT equations with the last decomposition failed.");
+
+        // Add the contributions of the derivatives of b using the stored derivatives with respect to b (scaled if the problem is scaled)
+        const Matrix dbdps = scaling.active() ? scaling.scaledVectorDerivatives(dbdp) : Matrix(dbdp);
+        if(dbdps.size())
+        {
+            const OptimumSensitivity& recorded = records[irecord].sensitivity;
+            sensitivity.dxdp += recorded.dxdp * dbdps;
+            sensitivity.dydp += recorded.dydp * dbdps;
+            sensitivity.dzdp += recorded.dzdp * dbdps;
+            sensitivity.dwdp += recorded.dwdp * dbdps;
+        }
+
+        // Unscale the sensitivity derivatives if the problem is scaled
+        if(scaling.active())
+            scaling.unscale(sensitivity);
+    }
+
+    /// Calculate the sensitivity derivatives of the solution with respect to parameters p.
+    auto sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> void
+    {
+        // Calculate the sensitivity derivatives with the presolved problem if the last calculation was presolved
+        if(presolving)
+            return presolvedsolver.sensitivities(dgdp, dbdp, sensitivity);
+
+        // Calculate the sensitivity derivatives with the reduced problem if the last calculation was reduced
+        if(reducing)
+            return reducedsolver->sensitivities(dgdp, dbdp, sensitivity);
+
+        // Calculate the sensitivity derivatives with respect to b with those of the stored solution if the last solution was predicted
+        if(irecord >= 0)
+            return sensitivitiesPredicted(dgdp, dbdp, sensitivity);
+
+        // Solve the KKT equations using the decomposition of the last iteration (with scaled derivatives if the problem is scaled)
+        Result res = scaling.active() ?
+            stepper.sensitivities(scaling.scaledGradientDerivatives(dgdp), scaling.scaledVectorDerivatives(dbdp), sensitivity) :
+            stepper.sensitivities(dgdp, dbdp, sensitivity);
+
+        // Assert the calculation of the sensitivity derivatives succeeded
+        Assert(res.success(), "Could not compute the sensitivity derivatives.",
+            "The solution of the KKT equations with the last decomposition failed.");
+
+        // Unscale the sensitivity derivatives if the problem is scaled
+        if(scaling.active())
+            scaling.unscale(sensitivity);
+    }
+
+    /// Return the sensitivity dx/dp of the solution x with respect to a parameter p.
+    auto dxdp(VectorConstRef dgdp, VectorConstRef dbdp) -> Vector
+    {
+        // Calculate the sensitivity derivatives for the single parameter p
+        OptimumSensitivity sensitivity;
+        sensitivities(dgdp, dbdp, sensitivity);
 
         // Return the calculated sensitivity vector
-        return {};
+        return sensitivity.dxdp.col(0);
     }
 };
 
@@ -613,8 +1639,13 @@ OptimumSolver::OptimumSolver(const OptimumStructure& structure)
 {}
 
 OptimumSolver::OptimumSolver(const OptimumSolver& other)
-: pimpl(new Impl(*other.pimpl))
-{}
+{
+    // Assert the copy is not made during a calculation, whose scaled objective function and parameters refer to the copied instance
+    Assert(!other.pimpl->initialized, "Could not copy the optimization solver.",
+        "A copy cannot be made between the calls to methods begin and finish.");
+
+    pimpl.reset(new Impl(*other.pimpl));
+}
 
 OptimumSolver::~OptimumSolver()
 {}
@@ -635,6 +1666,41 @@ auto OptimumSolver::solve(const OptimumParams& params, OptimumState& state) -> O
     return pimpl->solve(params, state);
 }
 
+auto OptimumSolver::begin(const OptimumParams& params, OptimumState& state) -> void
+{
+    pimpl->begin(params, state);
+}
+
+auto OptimumSolver::step() -> bool
+{
+    return pimpl->step();
+}
+
+auto OptimumSolver::step(const ObjectiveResult& f) -> bool
+{
+    return pimpl->step(f);
+}
+
+auto OptimumSolver::converged() const -> bool
+{
+    return pimpl->converged();
+}
+
+auto OptimumSolver::finish() -> OptimumResult
+{
+    return pimpl->finish();
+}
+
+auto OptimumSolver::accumulatedResult() const -> const OptimumResult&
+{
+    return pimpl->accumulated;
+}
+
+auto OptimumSolver::sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> void
+{
+    pimpl->sensitivities(dgdp, dbdp, sensitivity);
+}
+
 auto OptimumSolver::dxdp(VectorConstRef dgdp, VectorConstRef dbdp) -> Vector
 {
     return pimpl->dxdp(dgdp, dbdp);
@@ -31,10 +31,13 @@ class OptimumOptions;
 class OptimumParams;
 class OptimumProblem;
 class OptimumResult;
+class OptimumSensitivity;
 class OptimumState;
 class OptimumStructure;
 
 /// The class that implements the IpNewton algorithm using an interior-point method.
+/// @note A copy of an OptimumSolver instance cannot be made between the calls to methods @ref begin and @ref finish.
+/// @see OptimumPresolvedSolver, OptimumReducedSolver
 class OptimumSolver
 {
 public:
@@ -62,9 +65,66 @@ public:
     /// @param state[in,out] The initial guess and the final state of the optimization calculation.
     auto solve(const OptimumParams& params, OptimumState& state) -> OptimumResult;
 
-    /// Return the sensitivity \eq{dx/dp} of the solution \eq{x} with respect to a vector of parameters \eq{p}.
-    /// @param dgdp The derivatives \eq{dg/dp} of the gradient vector \eq{g = \nabla f} with respect to the parameters \eq{p}.
-    /// @param dbdp The derivatives \eq{db/dp} of the vector \eq{b} with respect to the parameters \eq{p}.
+    /// Begin a step-by-step optimization calculation.
+    /// This method, together with methods @ref step, @ref converged and @ref finish, permits
+    /// the iterations of the calculation to be performed one at a time, so that they can be
+    /// interleaved with the iterations of other calculations or stopped at any moment.
+    /// The initial guess is prepared here, and the objective function is first evaluated in method @ref step.
+    /// Method @ref solve is equivalent to `begin(params, state); while(step()) {} return finish();`.
+    /// @note The given parameters and state must remain valid until method @ref finish is called.
+    /// @param params The parameters for the optimization calculation.
+    /// @param state[in,out] The initial guess and the final state of the optimization calculation.
+    auto begin(const OptimumParams& params, OptimumState& state) -> void;
+
+    /// Perform one iteration of the step-by-step optimization calculation.
+    /// The objective function is evaluated at the current state, the Newton step is computed
+    /// and applied to the state, and the convergence of the calculation is checked. Thus, the
+    /// objective function is always evaluated at the value of `state.x` before the call.
+    /// @return True if more iterations are needed, false if the calculation has converged or
+    /// the maximum number of iterations has been reached.
+    auto step() -> bool;
+
+    /// Perform one iteration of the step-by-step optimization calculation with a given evaluation of the objective function.
+    /// This method is equivalent to @ref step, except that the objective function in the parameters
+    /// given to @ref begin is not called during the iteration. Instead, the given result must contain
+    /// the evaluation of the objective function at the current value of `state.x`.
+    /// @note The objective function in the parameters, if not empty, is still used to check predicted
+    /// @note solutions, to evaluate the trial iterates of the line search (see OptimumOptions::linesearch),
+    /// @note and to update the errors of a calculation that did not converge. If it is empty, the line
+    /// @note search is not performed and the full trial step is always taken.
+    /// @param f The result of the objective function evaluated at the current value of `state.x`.
+    /// @return True if more iterations are needed, false otherwise.
+    /// @see OptimumSolverT
+    auto step(const ObjectiveResult& f) -> bool;
+
+    /// Return true if the step-by-step optimization calculation has converged.
+    auto converged() const -> bool;
+
+    /// Finish the step-by-step optimization calculation and return its result.
+    auto finish() -> OptimumResult;
+
+    /// Return the results of all optimization calculations performed with this solver, accumulated with OptimumResult::operator+=.
+    /// The result of each calculation has at most one prediction attempt and one prediction hit. Use this method to
+    /// get the total numbers of prediction attempts and hits (see OptimumResult::predictionHitRate) across calculations.
+    auto accumulatedResult() const -> const OptimumResult&;
+
+    /// Calculate the sensitivity derivatives of the solution with respect to parameters \eq{p}.
+    /// The decomposition of the interior-point saddle point matrix computed in the last iteration
+    /// of the last call to @ref solve is reused, so that no additional decomposition is needed.
+    /// @note This method expects that a call to method @ref solve has already been performed.
+    /// @note If the solution of the last calculation was predicted (see OptimumPredictionOptions), no decomposition
+    /// @note was computed for it. The derivatives with respect to \eq{b} are then those stored with the solution from
+    /// @note which it was predicted, and those with respect to \eq{g} use the decomposition of the last calculation
+    /// @note that was not predicted. Both are thus lagged, the latter possibly by much if that calculation had a distant \eq{b}.
+    /// @param dgdp The derivatives \eq{dg/dp} of the gradient vector \eq{g = \nabla f} with respect to the parameters \eq{p} (an empty matrix denotes zero).
+    /// @param dbdp The derivatives \eq{db/dp} of the vector \eq{b} with respect to the parameters \eq{p} (an empty matrix denotes zero).
+    /// @param[out] sensitivity The calculated derivatives \eq{dx/dp}, \eq{dy/dp}, \eq{dz/dp} and \eq{dw/dp}.
+    auto sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> void;
+
+    /// Return the sensitivity \eq{dx/dp} of the solution \eq{x} with respect to a parameter \eq{p}.
+    /// @param dgdp The derivatives \eq{dg/dp} of the gradient vector \eq{g = \nabla f} with respect to the parameter \eq{p}.
+    /// @param dbdp The derivatives \eq{db/dp} of the vector \eq{b} with respect to the parameter \eq{p}.
+    /// @see sensitivities
     auto dxdp(VectorConstRef dgdp, VectorConstRef dbdp) -> Vector;
 
 private:
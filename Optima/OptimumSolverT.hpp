@@ -0,0 +1,149 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// Optima includes
+#include <Optima/Objective.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumResult.hpp>
+#include <Optima/OptimumSensitivity.hpp>
+#include <Optima/OptimumSolver.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+
+namespace Optima {
+
+/// The class that implements the IpNewton algorithm with an objective function known at compile time.
+/// The objective function is a functor of type `Objective`, called as `objective(x, f)` with the same
+/// arguments of an ObjectiveFunction. Because its type is known at compile time, the call is not
+/// type-erased and can be inlined into the iterations, which matters for very small problems. The
+/// rest of the calculation is performed by an OptimumSolver, driven through its step-by-step
+/// methods, and the result of the objective function is allocated once and reused.
+/// @note If the objective function in the parameters of method @ref solve is empty, the functor is also
+/// @note used (type-erased) for the evaluations outside the iterations, i.e., the trial iterates of the
+/// @note line search, the check of predicted solutions, and the errors of a calculation that did not converge.
+template<typename Objective>
+class OptimumSolverT
+{
+public:
+    /// Construct an OptimumSolverT instance with given optimization structure and objective function.
+    OptimumSolverT(const OptimumStructure& structure, const Objective& objective = Objective())
+    : solver(structure), obj(objective)
+    {
+        // The Hessian matrix is not evaluated if it is constant (e.g., in quadratic and linear programming problems)
+        hessian = !structure.hasConstantHessian();
+
+        // Establish the needs for the objective function evaluation, which are the same in every iteration
+        f.requires.value = true;
+        f.requires.gradient = true;
+        f.requires.hessian = hessian;
+
+        // Allocate memory for the result of the objective function
+        const Index n = structure.numVariables();
+        f.gradient.resize(n);
+        if(hessian) f.hessian.diagonal.resize(n);
+        if(hessian) f.hessian.dense.resize(n, n);
+    }
+
+    /// Set the options of the optimization solver.
+    auto setOptions(const OptimumOptions& options) -> void
+    {
+        solver.setOptions(options);
+
+        // The Hessian matrix is not evaluated if it is approximated with a quasi-Newton mode
+        f.requires.hessian = hessian && options.hessian.mode == HessianMode::Exact;
+    }
+
+    /// Return a reference to the objective function.
+    auto objective() -> Objective&
+    {
+        return obj;
+    }
+
+    /// Solve an optimization problem with the objective function of this solver.
+    /// The parameters are used as given if they have an objective function. Otherwise, their vectors are
+    /// copied into parameters kept by this solver, whose memory is reused in subsequent calculations.
+    /// @param params The parameters for the optimization calculation.
+    /// @param state[in,out] The initial guess and the final state of the optimization calculation.
+    auto solve(const OptimumParams& params, OptimumState& state) -> OptimumResult
+    {
+        // Use the objective function of this solver for the evaluations outside the iterations if none is given
+        solver.begin(params.objective ? params : withObjective(params), state);
+
+        // Iterate until convergence, evaluating the objective function at the current state before each iteration
+        for(bool iterating = !solver.converged(); iterating; )
+        {
+            obj(state.x, f);
+            iterating = solver.step(f);
+        }
+
+        return solver.finish();
+    }
+
+    /// Return the results of all optimization calculations performed with this solver (see OptimumSolver::accumulatedResult).
+    auto accumulatedResult() const -> const OptimumResult&
+    {
+        return solver.accumulatedResult();
+    }
+
+    /// Calculate the sensitivity derivatives of the solution with respect to parameters \eq{p} (see OptimumSolver::sensitivities).
+    auto sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> void
+    {
+        solver.sensitivities(dgdp, dbdp, sensitivity);
+    }
+
+    /// Return the sensitivity \eq{dx/dp} of the solution \eq{x} with respect to a parameter \eq{p} (see OptimumSolver::dxdp).
+    auto dxdp(VectorConstRef dgdp, VectorConstRef dbdp) -> Vector
+    {
+        return solver.dxdp(dgdp, dbdp);
+    }
+
+private:
+    /// Return the given parameters with the objective function of this solver.
+    auto withObjective(const OptimumParams& params) -> const OptimumParams&
+    {
+        // Copy the vectors, whose memory is not reallocated if their dimensions are the same as in the previous calculation
+        objparams.b = params.b;
+        objparams.xlower = params.xlower;
+        objparams.xupper = params.xupper;
+        objparams.xfixed = params.xfixed;
+
+        // Set the objective function at every call, so that it refers to this instance even if it is a copy of another
+        objparams.objective = [this](VectorConstRef x, ObjectiveResult& fx) { obj(x, fx); };
+
+        return objparams;
+    }
+
+    /// The optimization solver that performs the calculation.
+    OptimumSolver solver;
+
+    /// The objective function of the optimization problem.
+    Objective obj;
+
+    /// The parameters of the current calculation, with the objective function of this solver, used if none was given.
+    OptimumParams objparams;
+
+    /// The evaluated result of the objective function.
+    ObjectiveResult f;
+
+    /// The boolean flag that indicates if the Hessian matrix is not constant.
+    bool hessian;
+};
+
+} // namespace Optima
@@ -17,6 +17,9 @@
 
 #include "OptimumStepper.hpp"
 
+// C++ includes
+#include <cmath>
+
 // Optima includes
 #include <Optima/Exception.hpp>
 #include <Optima/IpSaddlePointMatrix.hpp>
@@ -24,6 +27,7 @@
 #include <Optima/Objective.hpp>
 #include <Optima/OptimumOptions.hpp>
 #include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumSensitivity.hpp>
 #include <Optima/OptimumState.hpp>
 #include <Optima/OptimumStructure.hpp>
 #include <Optima/Result.hpp>
@@ -45,6 +49,18 @@ struct OptimumStepper::Impl
     /// The right-hand side residual vector `r = [rx ry rz rw]`.
     Vector r;
 
+    /// The right-hand side vector r with the steps of the variables fixed at their bounds.
+    Vector ra;
+
+    /// The right-hand side vector of the predictor and corrector problems.
+    Vector rpc;
+
+    /// The solution vector of the predictor problem.
+    Vector spred;
+
+    /// The barrier parameter used as the target of the complementarity conditions.
+    double mu;
+
     /// The matrices Z, W, L, U assuming the ordering x = [x(free) x(fixed)].
     Vector Z, W, L, U;
 
@@ -63,6 +79,24 @@ struct OptimumStepper::Impl
     /// The interior-point saddle point solver.
     IpSaddlePointSolver solver;
 
+    /// The number of variables fixed at their lower bounds along the steps (the first ones in `iactive`).
+    Index nactivelower = 0;
+
+    /// The indices of the variables fixed at their lower and upper bounds along the steps.
+    Indices iactive;
+
+    /// The indices of the variables with fixed values and of those fixed at their bounds.
+    Indices ifixed;
+
+    /// The rows of the dense Hessian matrix corresponding to the variables fixed at their bounds.
+    Matrix Hactive;
+
+    /// The indices of the variables fixed at their bounds whose multipliers would change sign in the last step.
+    Indices ireleased;
+
+    /// The number of variables fixed at their bounds whose multipliers would change sign in the last step.
+    Index nreleased = 0;
+
     /// Construct a OptimumStepper::Impl instance with given optimization problem structure.
     Impl(const OptimumStructure& structure)
     : structure(structure)
@@ -74,6 +108,9 @@ struct OptimumStepper::Impl
         nx = n - nf;
         t  = 3*n + m;
 
+        // Initialize the barrier parameter with its default value
+        mu = options.mu;
+
         // Initialize Z and W with zeros (the dafault value for variables
         // with fixed values or no lower/upper bounds).
         Z = zeros(n);
@@ -90,18 +127,46 @@ struct OptimumStepper::Impl
 
         // Initialize the saddle point solver
         solver.initialize(structure.A);
+
+        // Let the saddle point solver know if the Hessian matrix is constant
+        solver.setConstantHessian(structure.hasConstantHessian());
+
+        // Initialize the indices of the fixed variables with those with fixed values only
+        ifixed = structure.variablesWithFixedValues();
     }
 
-    /// Decompose the interior-point saddle point matrix for diagonal Hessian matrices.
-    auto decompose(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> Result
+    /// Fix the given variables at their lower and upper bounds along the next steps.
+    auto fixVariablesAtBounds(IndicesConstRef ilower, IndicesConstRef iupper) -> void
     {
-        // The result of this method call
-        Result res;
+        // The indices of the variables with fixed values
+        IndicesConstRef ivalues = structure.variablesWithFixedValues();
+
+        // Set the indices of the variables fixed at their bounds, the lower ones first
+        nactivelower = ilower.size();
+        iactive.resize(ilower.size() + iupper.size());
+        iactive << ilower, iupper;
+
+        // Set the indices of all fixed variables
+        ifixed.resize(ivalues.size() + iactive.size());
+        ifixed << ivalues, iactive;
+
+        // Initialize the indices of the variables whose multipliers would change sign
+        ireleased.resize(iactive.size());
+        nreleased = 0;
+    }
+
+    /// Return the Hessian matrix of the objective function, which is either constant or evaluated in `f`.
+    auto hessian(const ObjectiveResult& f) const -> VariantMatrixConstRef
+    {
+        return structure.hasConstantHessian() ? structure.constantHessian() : VariantMatrixConstRef(f.hessian);
+    }
 
-        // The indices of the variables with lower and upper bounds and fixed values
+    /// Update the diagonal matrices Z, W, L, U for the given optimum state.
+    auto updateDiagonalMatrices(const OptimumParams& params, const OptimumState& state) -> void
+    {
+        // The indices of the variables with lower and upper bounds
         IndicesConstRef ilower = structure.variablesWithLowerBounds();
         IndicesConstRef iupper = structure.variablesWithUpperBounds();
-        IndicesConstRef ifixed = structure.variablesWithFixedValues();
 
         // Update Z and L for the variables with lower bounds
         Z(ilower) = state.z(ilower);
@@ -116,9 +181,27 @@ struct OptimumStepper::Impl
 
         // Ensure entries in U are negative in case x[i] == upperbound[i]
 		for(Index i : iupper) U[i] = U[i] < 0.0 ? U[i] : -options.mu;
+    }
 
-        // Define the interior-point saddle point matrix
-        IpSaddlePointMatrix spm(f.hessian, structure.A, Z, W, L, U, ifixed);
+    /// Decompose the interior-point saddle point matrix for diagonal Hessian matrices.
+    auto decompose(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> Result
+    {
+        // The result of this method call
+        Result res;
+
+        // Update the diagonal matrices Z, W, L, U
+        updateDiagonalMatrices(params, state);
+
+        // The Hessian matrix of the objective function
+        VariantMatrixConstRef H = hessian(f);
+
+        // Keep the rows of a dense Hessian matrix needed for the sensitivities of the multipliers of the variables fixed at their bounds
+        if(H.structure == MatrixStructure::Dense && iactive.size())
+            Hactive = H.dense(iactive, Eigen::all);
+        else Hactive.resize(0, n);
+
+        // Define the interior-point saddle point matrix, with the variables fixed at their bounds as fixed variables
+        IpSaddlePointMatrix spm(H, structure.A, Z, W, L, U, ifixed);
 
         // Decompose the interior-point saddle point matrix
         solver.decompose(spm);
@@ -126,12 +209,9 @@ struct OptimumStepper::Impl
         return res.stop();
     }
 
-    /// Solve the interior-point saddle point matrix.
-    auto solve(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> Result
+    /// Update the residual vector of the KKT equations for the given optimum state.
+    auto updateResidual(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> void
     {
-        // The result of this method call
-        Result res;
-
         // Alias to state variables
         VectorConstRef x = state.x;
         VectorConstRef y = state.y;
@@ -144,10 +224,9 @@ struct OptimumStepper::Impl
         // Alias to structure variables
         MatrixConstRef A = structure.A;
 
-        // The indices of the variables with lower and upper bounds and fixed values
+        // The indices of the variables with lower and upper bounds
         IndicesConstRef ilower = structure.variablesWithLowerBounds();
         IndicesConstRef iupper = structure.variablesWithUpperBounds();
-        IndicesConstRef ifixed = structure.variablesWithFixedValues();
 
         // Views to the sub-vectors in r = [a b c d]
         auto a = r.head(n);
@@ -158,27 +237,241 @@ struct OptimumStepper::Impl
         // Calculate the optimality residual vector a
         a.noalias() = -(g + tr(A) * y - z - w);
 
-        // Set a to zero for fixed variables
-        a(ifixed).fill(0.0);
+        // Set a to zero for variables with fixed values (not for those fixed at their bounds, whose residuals measure the optimality of their multipliers)
+        a(structure.variablesWithFixedValues()).fill(0.0);
 
         // Calculate the feasibility residual vector b
         b.noalias() = -(A * x - params.b);
 
         // Calculate the centrality residual vectors c and d
-        for(Index i : ilower) c[i] = options.mu - L[i] * z[i]; // TODO Check if mu is still needed. Maybe this algorithm no longer needs perturbation.
-        for(Index i : iupper) d[i] = options.mu - U[i] * w[i];
+        for(Index i : ilower) c[i] = mu - L[i] * z[i];
+        for(Index i : iupper) d[i] = mu - U[i] * w[i];
+    }
+
+    /// Solve the interior-point saddle point matrix.
+    auto solve(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> Result
+    {
+        // The result of this method call
+        Result res;
+
+        // Calculate the residual vector r = [a b c d]
+        updateResidual(params, state, f);
+
+        // Calculate the right-hand side vector with the steps of the variables fixed at their bounds
+        updateActiveRightHandSide();
+
+        // Calculate the step with predictor-corrector steps if there are variables with bounds
+        if(options.predictor_corrector && numBoundedVariables())
+            res += solvePredictorCorrector(state);
+        else res += solver.solve(IpSaddlePointVector(ra, n, m), IpSaddlePointSolution(s, n, m));
+
+        // Calculate the steps of the multipliers of the variables fixed at their bounds
+        updateActiveStep(state);
+
+        return res.stop();
+    }
+
+    /// Update the right-hand side vector `ra`, which is the residual vector `r` with the steps of the variables
+    /// fixed at their bounds in place of their optimality residuals. These steps bring the variables onto
+    /// their bounds, with the complementarity conditions \eq{(x - x_l)z = \mu} and \eq{(x - x_u)w = \mu}
+    /// satisfied, in the same way the saddle point solver moves the variables in its partitions z and w.
+    auto updateActiveRightHandSide() -> void
+    {
+        ra = r;
+        for(Index k = 0; k < iactive.size(); ++k)
+        {
+            const Index i = iactive[k];
+            ra[i] = k < nactivelower ? mu/Z[i] - L[i] : mu/W[i] - U[i];
+        }
+    }
+
+    /// Update the steps of the multipliers of the variables fixed at their bounds. The multiplier of the opposite
+    /// bound follows from the linearized complementarity condition, as in the saddle point solver, and the one of
+    /// the active bound from the optimality conditions \eq{g + A^Ty - z - w = 0} after the step. The multipliers
+    /// of the active bounds that would change sign are kept instead, and their variables are registered as released.
+    auto updateActiveStep(const OptimumState& state) -> void
+    {
+        // Views to the sub-vectors in r = [a b c d] and in s = [dx dy dz dw]
+        auto a = r.head(n);
+        auto c = r.segment(n + m, n);
+        auto d = r.tail(n);
+        auto dx = s.head(n);
+        auto dy = s.segment(n, m);
+        auto dz = s.segment(n + m, n);
+        auto dw = s.tail(n);
+
+        nreleased = 0;
+
+        for(Index k = 0; k < iactive.size(); ++k)
+        {
+            const Index i = iactive[k];
+            const bool lower = k < nactivelower;
+
+            // Calculate the step of the multiplier of the opposite bound (zero if the variable has no such bound)
+            if(lower) dw[i] = (d[i] - W[i]*dx[i])/U[i];
+            else dz[i] = (c[i] - Z[i]*dx[i])/L[i];
+
+            // Calculate the step of the multiplier of the active bound
+            double dm = -a[i] + structure.A.col(i).dot(dy) - (lower ? dw[i] : dz[i]);
+
+            // Keep the multiplier if it would change sign (z > 0 and w < 0) and release the variable
+            if(lower ? state.z[i] + dm <= 0.0 : state.w[i] + dm >= 0.0)
+            {
+                dm = 0.0;
+                ireleased[nreleased++] = i;
+            }
+
+            if(lower) dz[i] = dm;
+            else dw[i] = dm;
+        }
+    }
+
+    /// Return the number of variables with lower and upper bounds (counting twice those with both).
+    auto numBoundedVariables() const -> Index
+    {
+        return structure.variablesWithLowerBounds().size() + structure.variablesWithUpperBounds().size();
+    }
+
+    /// Solve the interior-point saddle point problem with Mehrotra's predictor-corrector steps.
+    /// @see Mehrotra, S. (1992). On the implementation of a primal-dual interior point method. SIAM Journal on Optimization, 2(4), 575–601.
+    auto solvePredictorCorrector(const OptimumState& state) -> Result
+    {
+        // The result of this method call
+        Result res;
+
+        // Alias to state variables
+        VectorConstRef z = state.z;
+        VectorConstRef w = state.w;
+
+        // The indices of the variables with lower and upper bounds
+        IndicesConstRef ilower = structure.variablesWithLowerBounds();
+        IndicesConstRef iupper = structure.variablesWithUpperBounds();
+
+        // The right-hand side vector rpc = [a b c d] of the predictor and corrector problems, with the same a and b of ra
+        rpc = ra;
+
+        // Views to the sub-vectors in rpc = [a b c d] and in s = [dx dy dz dw]
+        auto c = rpc.segment(n + m, n);
+        auto d = rpc.tail(n);
+        auto dx = s.head(n);
+        auto dz = s.segment(n + m, n);
+        auto dw = s.tail(n);
+
+        // Calculate the affine-scaling predictor step, which targets zero complementarity
+        for(Index i : ilower) c[i] = -L[i] * z[i];
+        for(Index i : iupper) d[i] = -U[i] * w[i];
+
+        solver.solve(IpSaddlePointVector(rpc, n, m), IpSaddlePointSolution(s, n, m));
+
+        // Calculate the primal and dual step lengths to the boundary along the predictor step
+        double alphax = 1.0, alphaz = 1.0;
+        for(Index i : ilower) if(dx[i] < 0.0) alphax = std::min(alphax, -L[i]/dx[i]);
+        for(Index i : iupper) if(dx[i] > 0.0) alphax = std::min(alphax, -U[i]/dx[i]);
+        for(Index i : ilower) if(dz[i] < 0.0) alphaz = std::min(alphaz, -z[i]/dz[i]);
+        for(Index i : iupper) if(dw[i] > 0.0) alphaz = std::min(alphaz, -w[i]/dw[i]);
 
-//        c.fill(0.0); // TODO For example, there is no mu here and this seems to work
-//        d.fill(0.0);
+        // Calculate the current complementarity measure and the one after the predictor step
+        double mucur = 0.0, muaff = 0.0;
+        for(Index i : ilower) mucur += L[i] * z[i];
+        for(Index i : iupper) mucur += U[i] * w[i];
+        for(Index i : ilower) muaff += (L[i] + alphax*dx[i]) * (z[i] + alphaz*dz[i]);
+        for(Index i : iupper) muaff += (U[i] + alphax*dx[i]) * (w[i] + alphaz*dw[i]);
+        mucur /= numBoundedVariables();
+        muaff /= numBoundedVariables();
 
-        // The right-hand side vector of the interior-point saddle point problem
-        IpSaddlePointVector rhs(r, n, m);
+        // Calculate the adaptive centering parameter and the centrality target (not below the barrier parameter),
+        // unless the barrier parameter is updated along the iterations, in which case it is the centrality target
+        const double sigma = mucur > 0.0 ? std::min(std::pow(std::max(muaff, 0.0)/mucur, 3), 1.0) : 0.0;
+        const double target = options.barrier.mode == BarrierMode::Fixed ? std::max(sigma * mucur, mu) : mu;
 
-        // The solution vector of the interior-point saddle point problem
-        IpSaddlePointSolution sol(s, n, m);
+        // Calculate the corrector step, which accounts for the centrality target and the second-order term of the predictor step
+        for(Index i : ilower) c[i] = target - L[i] * z[i] - alphax*dx[i] * alphaz*dz[i];
+        for(Index i : iupper) d[i] = target - U[i] * w[i] - alphax*dx[i] * alphaz*dw[i];
 
-        // Solve the saddle point problem
-        solver.solve(rhs, sol);
+        // Keep the predictor step in case the corrector step needs to be rejected
+        spred = s;
+
+        solver.solve(IpSaddlePointVector(rpc, n, m), IpSaddlePointSolution(s, n, m));
+
+        // Reject the corrector step if it is not finite or if it is more restricted by the bounds than the predictor step
+        if(!s.allFinite() || stepLength(state) < std::min(alphax, alphaz))
+            s = spred;
+
+        return res.stop();
+    }
+
+    /// Return the minimum of the primal and dual step lengths to the boundary along the current step.
+    auto stepLength(const OptimumState& state) const -> double
+    {
+        // The indices of the variables with lower and upper bounds
+        IndicesConstRef ilower = structure.variablesWithLowerBounds();
+        IndicesConstRef iupper = structure.variablesWithUpperBounds();
+
+        // Views to the sub-vectors in s = [dx dy dz dw]
+        auto dx = s.head(n);
+        auto dz = s.segment(n + m, n);
+        auto dw = s.tail(n);
+
+        double alpha = 1.0;
+        for(Index i : ilower) if(dx[i] < 0.0) alpha = std::min(alpha, -L[i]/dx[i]);
+        for(Index i : iupper) if(dx[i] > 0.0) alpha = std::min(alpha, -U[i]/dx[i]);
+        for(Index i : ilower) if(dz[i] < 0.0) alpha = std::min(alpha, -state.z[i]/dz[i]);
+        for(Index i : iupper) if(dw[i] > 0.0) alpha = std::min(alpha, -state.w[i]/dw[i]);
+        return alpha;
+    }
+
+    /// Calculate the sensitivity derivatives of the solution with respect to parameters p.
+    auto sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> Result
+    {
+        // The result of this method call
+        Result res;
+
+        // The number of parameters
+        const Index np = std::max(dgdp.cols(), dbdp.cols());
+
+        Assert(dgdp.size() == 0 || (dgdp.rows() == n && dgdp.cols() == np),
+            "Could not calculate the sensitivity derivatives.",
+                "Matrix dg/dp must be empty or have dimensions n x np.");
+
+        Assert(dbdp.size() == 0 || (dbdp.rows() == m && dbdp.cols() == np),
+            "Could not calculate the sensitivity derivatives.",
+                "Matrix db/dp must be empty or have dimensions m x np.");
+
+        // The right-hand side vectors rp = [ap bp cp dp] and the solution vectors sp = [xp yp zp wp], one column per parameter
+        Matrix rp = zeros(t, np);
+        Matrix sp = zeros(t, np);
+
+        // Views to the sub-matrices in rp = [ap bp cp dp] (cp and dp remain zero)
+        auto ap = rp.topRows(n);
+        auto bp = rp.middleRows(n, m);
+
+        // Calculate the right-hand side vectors ap = -dg/dp and bp = db/dp
+        if(dgdp.size()) ap.noalias() = -dgdp;
+        if(dbdp.size()) bp.noalias() = dbdp;
+
+        // Set ap to zero for fixed variables
+        ap(ifixed, all).fill(0.0);
+
+        // Solve the interior-point saddle point problem for all parameters at once using the last decomposition
+        res += solver.solve(rp, sp);
+
+        // Set the sensitivity derivatives for all parameters
+        sensitivity.dxdp = sp.topRows(n);
+        sensitivity.dydp = sp.middleRows(n, m);
+        sensitivity.dzdp = sp.middleRows(n + m, n);
+        sensitivity.dwdp = sp.bottomRows(n);
+
+        // The derivatives of the multipliers of the variables fixed at their bounds follow from the optimality conditions
+        for(Index k = 0; k < iactive.size(); ++k)
+        {
+            const Index i = iactive[k];
+            auto dmdp = k < nactivelower ? sensitivity.dzdp.row(i) : sensitivity.dwdp.row(i);
+            sensitivity.dzdp.row(i).fill(0.0);
+            sensitivity.dwdp.row(i).fill(0.0);
+            dmdp.noalias() = tr(structure.A.col(i)) * sensitivity.dydp;
+            if(dgdp.size()) dmdp += dgdp.row(i);
+            if(Hactive.rows() == iactive.size()) dmdp.noalias() += Hactive.row(k) * sensitivity.dxdp;
+        }
 
         return res.stop();
     }
@@ -195,14 +488,21 @@ struct OptimumStepper::Impl
         return IpSaddlePointVector(r, n, m);
     }
 
+    /// Calculate the residual vector for a given optimum state without decomposing the saddle point matrix.
+    auto residual(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> IpSaddlePointVector
+    {
+        // Update the diagonal matrices Z, W, L, U and the residual vector r = [a b c d]
+        updateDiagonalMatrices(params, state);
+        updateResidual(params, state, f);
+
+        return residual();
+    }
+
     /// Return the assembled interior-point saddle point matrix.
     auto matrix(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> IpSaddlePointMatrix
     {
-        // The indices of the variables with fixed values
-        IndicesConstRef ifixed = structure.variablesWithFixedValues();
-
         // Define the interior-point saddle point matrix
-        return IpSaddlePointMatrix(f.hessian, structure.A, Z, W, L, U, ifixed);
+        return IpSaddlePointMatrix(hessian(f), structure.A, Z, W, L, U, ifixed);
     }
 };
 
@@ -225,8 +525,45 @@ auto OptimumStepper::operator=(OptimumStepper other) -> OptimumStepper&
 
 auto OptimumStepper::setOptions(const OptimumOptions& options) -> void
 {
+    // Check if the saddle point solver needs to canonicalize matrix A again
+    const bool reinitialize = options.kkt.exact != pimpl->options.kkt.exact;
+
     pimpl->options = options;
+    pimpl->mu = options.mu;
     pimpl->solver.setOptions(options.kkt);
+
+    if(reinitialize)
+        pimpl->solver.initialize(pimpl->structure.A);
+}
+
+auto OptimumStepper::setBarrier(double mu) -> void
+{
+    pimpl->mu = mu;
+}
+
+auto OptimumStepper::barrier() const -> double
+{
+    return pimpl->mu;
+}
+
+auto OptimumStepper::fixVariablesAtBounds(IndicesConstRef ilower, IndicesConstRef iupper) -> void
+{
+    pimpl->fixVariablesAtBounds(ilower, iupper);
+}
+
+auto OptimumStepper::releasedVariables() const -> IndicesConstRef
+{
+    return pimpl->ireleased.head(pimpl->nreleased);
+}
+
+auto OptimumStepper::variablesAtLowerBounds() const -> IndicesConstRef
+{
+    return pimpl->solver.variablesAtLowerBounds();
+}
+
+auto OptimumStepper::variablesAtUpperBounds() const -> IndicesConstRef
+{
+    return pimpl->solver.variablesAtUpperBounds();
 }
 
 auto OptimumStepper::decompose(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> Result
@@ -244,6 +581,16 @@ auto OptimumStepper::matrix(const OptimumParams& params, const OptimumState& sta
     return pimpl->matrix(params, state, f);
 }
 
+auto OptimumStepper::canonicalizer() const -> const Canonicalizer&
+{
+    return pimpl->solver.canonicalizer();
+}
+
+auto OptimumStepper::sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> Result
+{
+    return pimpl->sensitivities(dgdp, dbdp, sensitivity);
+}
+
 auto OptimumStepper::step() const -> IpSaddlePointVector
 {
     return pimpl->step();
@@ -254,4 +601,9 @@ auto OptimumStepper::residual() const -> IpSaddlePointVector
     return pimpl->residual();
 }
 
+auto OptimumStepper::residual(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> IpSaddlePointVector
+{
+    return pimpl->residual(params, state, f);
+}
+
 } // namespace Optima
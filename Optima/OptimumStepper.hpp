@@ -21,16 +21,19 @@
 #include <memory>
 
 // Optima includes
+#include <Optima/Index.hpp>
 #include <Optima/Matrix.hpp>
 
 namespace Optima {
 
 // Forward declarations
+class Canonicalizer;
 class IpSaddlePointMatrix;
 class IpSaddlePointVector;
 class ObjectiveResult;
 class OptimumOptions;
 class OptimumParams;
+class OptimumSensitivity;
 class OptimumState;
 class OptimumStructure;
 class Result;
@@ -54,6 +57,32 @@ public:
     /// Set the options for the step calculation.
     auto setOptions(const OptimumOptions& options) -> void;
 
+    /// Set the barrier parameter used as the target of the complementarity conditions (initially OptimumOptions::mu).
+    auto setBarrier(double mu) -> void;
+
+    /// Return the barrier parameter used as the target of the complementarity conditions.
+    auto barrier() const -> double;
+
+    /// Fix the given variables at their lower or upper bounds along the next steps, besides those with fixed values.
+    /// These variables are removed from the saddle point problem and step onto their bounds (within the barrier
+    /// parameter), and the steps of the multipliers of their bounds are determined from the optimality conditions.
+    /// The saddle point matrix needs to be decomposed again afterwards.
+    /// @param ilower The indices of the variables fixed at their lower bounds.
+    /// @param iupper The indices of the variables fixed at their upper bounds.
+    auto fixVariablesAtBounds(IndicesConstRef ilower, IndicesConstRef iupper) -> void;
+
+    /// Return the indices of the variables fixed at their bounds whose multipliers would change sign in the last step.
+    /// These variables keep their multipliers in the step, and they should be released in the next ones.
+    auto releasedVariables() const -> IndicesConstRef;
+
+    /// Return the indices of the free variables at their lower bounds with negligible slack in the last decomposition.
+    /// @see IpSaddlePointSolver::variablesAtLowerBounds
+    auto variablesAtLowerBounds() const -> IndicesConstRef;
+
+    /// Return the indices of the free variables at their upper bounds with negligible slack in the last decomposition.
+    /// @see IpSaddlePointSolver::variablesAtUpperBounds
+    auto variablesAtUpperBounds() const -> IndicesConstRef;
+
     /// Decompose the interior-point saddle point matrix used to compute the step vectors.
     auto decompose(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> Result;
 
@@ -61,6 +90,13 @@ public:
     /// @note Method OptimumStepper::decompose needs to be called first.
     auto solve(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> Result;
 
+    /// Calculate the sensitivity derivatives of the solution with respect to parameters \eq{p}.
+    /// @note Method OptimumStepper::decompose needs to be called first.
+    /// @param dgdp The derivatives \eq{dg/dp} of the gradient vector \eq{g = \nabla f} with respect to the parameters \eq{p} (an empty matrix denotes zero).
+    /// @param dbdp The derivatives \eq{db/dp} of the vector \eq{b} with respect to the parameters \eq{p} (an empty matrix denotes zero).
+    /// @param[out] sensitivity The calculated derivatives \eq{dx/dp}, \eq{dy/dp}, \eq{dz/dp} and \eq{dw/dp}.
+    auto sensitivities(MatrixConstRef dgdp, MatrixConstRef dbdp, OptimumSensitivity& sensitivity) -> Result;
+
     /// Return the calculated Newton step vector.
     /// @note Method OptimumStepper::solve needs to be called first.
     auto step() const -> IpSaddlePointVector;
@@ -69,10 +105,18 @@ public:
     /// @note Method OptimumStepper::solve needs to be called first.
     auto residual() const -> IpSaddlePointVector;
 
+    /// Calculate the residual vector for a given optimum state without decomposing the saddle point matrix.
+    /// This is a cheaper alternative to methods OptimumStepper::decompose and OptimumStepper::solve when only
+    /// the residual of the optimality conditions is needed (e.g., to check if a given state is a solution).
+    auto residual(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> IpSaddlePointVector;
+
     /// Return the assembled interior-point saddle point matrix.
     /// @note Method OptimumStepper::decompose needs to be called first.
     auto matrix(const OptimumParams& params, const OptimumState& state, const ObjectiveResult& f) -> IpSaddlePointMatrix;
 
+    /// Return the canonical form of the coefficient matrix \eq{A} of the equality constraints.
+    auto canonicalizer() const -> const Canonicalizer&;
+
 private:
     struct Impl;
 
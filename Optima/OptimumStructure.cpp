@@ -27,7 +27,8 @@ OptimumStructure::OptimumStructure(Index n, Index m)
 : n(n), nlower(0), nupper(0), nfixed(0),
   lowerpartition(indices(n)),
   upperpartition(indices(n)),
-  fixedpartition(indices(n))
+  fixedpartition(indices(n)),
+  hessianconstant(false)
 {}
 
 auto OptimumStructure::setVariablesWithLowerBounds(IndicesConstRef inds) -> void
@@ -60,6 +61,28 @@ auto OptimumStructure::setVariablesWithFixedValues(IndicesConstRef inds) -> void
     partitionRightStable(fixedpartition, inds);
 }
 
+auto OptimumStructure::setConstantHessianDense(MatrixConstRef H) -> void
+{
+    Assert(H.rows() == n && H.cols() == n, "Could not set the constant Hessian matrix.",
+        "The given dense Hessian matrix has dimensions inconsistent with the number of variables.");
+    hessian = H;
+    hessianconstant = true;
+}
+
+auto OptimumStructure::setConstantHessianDiagonal(VectorConstRef H) -> void
+{
+    Assert(H.size() == n, "Could not set the constant Hessian matrix.",
+        "The given diagonal Hessian matrix has dimension inconsistent with the number of variables.");
+    hessian = H;
+    hessianconstant = true;
+}
+
+auto OptimumStructure::setConstantHessianZero() -> void
+{
+    hessian.setZero();
+    hessianconstant = true;
+}
+
 auto OptimumStructure::numVariables() const -> Index
 {
     return n;
@@ -100,6 +123,16 @@ auto OptimumStructure::variablesWithoutFixedValues() const -> IndicesConstRef
     return fixedpartition.head(n - nfixed);
 }
 
+auto OptimumStructure::hasConstantHessian() const -> bool
+{
+    return hessianconstant;
+}
+
+auto OptimumStructure::constantHessian() const -> VariantMatrixConstRef
+{
+    return hessian;
+}
+
 auto OptimumStructure::orderingLowerBounds() const -> IndicesConstRef
 {
     return lowerpartition;
@@ -20,6 +20,7 @@
 // Optima includes
 #include <Optima/Index.hpp>
 #include <Optima/Matrix.hpp>
+#include <Optima/VariantMatrix.hpp>
 
 namespace Optima {
 
@@ -51,6 +52,18 @@ public:
     /// Set the indices of the variables in \eq{x} with fixed values.
     auto setVariablesWithFixedValues(IndicesConstRef indices) -> void;
 
+    /// Set a constant dense Hessian matrix for the objective function (e.g., in quadratic programming problems).
+    /// The objective function then only needs to evaluate its value and gradient.
+    auto setConstantHessianDense(MatrixConstRef H) -> void;
+
+    /// Set a constant diagonal Hessian matrix for the objective function (e.g., in separable quadratic programming problems).
+    /// The objective function then only needs to evaluate its value and gradient.
+    auto setConstantHessianDiagonal(VectorConstRef H) -> void;
+
+    /// Set a constant zero Hessian matrix for the objective function (e.g., in linear programming problems).
+    /// The objective function then only needs to evaluate its value and gradient.
+    auto setConstantHessianZero() -> void;
+
     /// Return the number of variables.
     auto numVariables() const -> Index;
 
@@ -75,6 +88,16 @@ public:
     /// Return the indices of the variables without fixed values.
     auto variablesWithoutFixedValues() const -> IndicesConstRef;
 
+    /// Return true if the Hessian matrix of the objective function is constant.
+    /// In this case, the objective function is evaluated without its Hessian matrix and the entries of the
+    /// constant one are gathered by the saddle point solver only when the partition of the variables changes.
+    /// The saddle point matrix is still decomposed in every iteration, since its diagonal block
+    /// \eq{H + L^{-1}Z + U^{-1}W} changes with the barrier terms.
+    auto hasConstantHessian() const -> bool;
+
+    /// Return the constant Hessian matrix of the objective function.
+    auto constantHessian() const -> VariantMatrixConstRef;
+
     /// Return the indices of the variables partitioned in [without, with] lower bounds.
     auto orderingLowerBounds() const -> IndicesConstRef;
 
@@ -105,6 +128,12 @@ private:
 
     /// The indices of the variables partitioned in [with, without] fixed values.
     Indices fixedpartition;
+
+    /// The constant Hessian matrix of the objective function.
+    VariantMatrix hessian;
+
+    /// The boolean flag that indicates if the Hessian matrix of the objective function is constant.
+    bool hessianconstant;
 };
 
 } // namespace Optima
@@ -0,0 +1,248 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "QuasiNewtonHessian.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Eigen includes
+#include <Optima/deps/eigen3/Eigen/Dense>
+
+// Optima includes
+#include <Optima/Objective.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/Utils.hpp>
+#include <Optima/VariantMatrix.hpp>
+
+namespace Optima {
+
+struct QuasiNewtonHessian::Impl
+{
+    /// The options for the Hessian approximation.
+    OptimumHessianOptions options;
+
+    /// The last iterate and the gradient at it.
+    Vector x0, g0;
+
+    /// The current variations of x and of the gradient, the damped variation of the gradient, and the product B*s.
+    Vector s, y, r, Bs;
+
+    /// The stored pairs of damped variations of x and of the gradient, in the HessianMode::LBFGS mode (oldest first).
+    Matrix S, Y;
+
+    /// The number of stored pairs in the HessianMode::LBFGS mode.
+    Index numpairs = 0;
+
+    /// The scaling factor of the identity matrix in the initial Hessian approximation.
+    double sigma = 1.0;
+
+    /// The objective result with the approximated Hessian matrix.
+    ObjectiveResult result;
+
+    /// The LU decomposition of the middle matrix of the compact representation.
+    Eigen::PartialPivLU<Matrix> lu;
+
+    /// Initialize the Hessian approximation for a new calculation.
+    auto initialize(const OptimumHessianOptions& hessianoptions, Index n) -> void
+    {
+        options = hessianoptions;
+        numpairs = 0;
+        sigma = 1.0;
+        x0.resize(0);
+        g0.resize(0);
+        S.resize(n, options.mode == HessianMode::LBFGS ? options.memory : 0);
+        Y.resizeLike(S);
+        result.hessian = options.mode == HessianMode::DiagonalSecant ?
+            VariantMatrix(VectorConstRef(ones(n))) : VariantMatrix(MatrixConstRef(identity(n, n)));
+    }
+
+    /// Update the Hessian approximation with the gradient at a new iterate and return the objective result with it.
+    auto update(VectorConstRef x, const ObjectiveResult& f) -> const ObjectiveResult&
+    {
+        // Copy the evaluated value and gradient of the objective function
+        result.value = f.value;
+        result.gradient = f.gradient;
+
+        // Update the Hessian approximation with the variations of x and of the gradient since the last iterate.
+        // Variations of x comparable to round-off errors are skipped, since the variation of the gradient is then meaningless.
+        if(x0.size())
+        {
+            s = x - x0;
+            y = f.gradient - g0;
+            if(s.norm() > std::sqrt(std::numeric_limits<double>::epsilon()) * x.norm())
+                updateWithPair();
+        }
+
+        x0 = x;
+        g0 = f.gradient;
+
+        return result;
+    }
+
+    /// Update the Hessian approximation with the current pair of variations s and y.
+    auto updateWithPair() -> void
+    {
+        // Scale the initial approximation in the first update, as in Nocedal and Wright (2006), Eq. 6.20
+        const double sy = s.dot(y);
+        if(numpairs == 0 && sy > 0.0)
+        {
+            sigma = y.squaredNorm() / sy;
+            if(options.mode == HessianMode::BFGS) result.hessian.dense = sigma * identity(s.size(), s.size());
+            if(options.mode == HessianMode::DiagonalSecant) result.hessian.diagonal.fill(sigma);
+        }
+
+        // Calculate the product B*s with the current approximation
+        switch(options.mode) {
+        case HessianMode::BFGS: Bs = result.hessian.dense * s; break;
+        case HessianMode::LBFGS: Bs = compact(s); break;
+        default: Bs = result.hessian.diagonal.cwiseProduct(s); break;
+        }
+
+        // Skip the update if the current approximation is not positive along s (possible only with round-off errors)
+        const double sBs = s.dot(Bs);
+        if(!(sBs > 0.0))
+            return;
+
+        // Calculate the damped variation of the gradient r = theta*y + (1 - theta)*B*s
+        const double delta = options.damping;
+        const double theta = sy >= delta * sBs ? 1.0 : (1.0 - delta) * sBs / (sBs - sy);
+        r = theta * y + (1.0 - theta) * Bs;
+        const double sr = s.dot(r);
+
+        // Update the approximation of the Hessian matrix
+        switch(options.mode) {
+        case HessianMode::BFGS: updateDense(sBs, sr); break;
+        case HessianMode::LBFGS: updateCompact(sr); break;
+        default: updateDiagonal(sBs, sr); break;
+        }
+
+        ++numpairs;
+    }
+
+    /// Update the dense Hessian approximation with the BFGS formula.
+    auto updateDense(double sBs, double sr) -> void
+    {
+        Matrix& B = result.hessian.dense;
+        B.noalias() -= (Bs/sBs) * tr(Bs);
+        B.noalias() += (r/sr) * tr(r);
+    }
+
+    /// Update the diagonal Hessian approximation so that it satisfies the weak secant condition \eq{s^TBs = s^Tr}.
+    auto updateDiagonal(double sBs, double sr) -> void
+    {
+        Vector& D = result.hessian.diagonal;
+        const Vector s2 = s.cwiseProduct(s);
+        D += ((sr - sBs) / s2.squaredNorm()) * s2;
+
+        // Ensure the diagonal entries remain positive
+        D = D.cwiseMax(1.0e-8 * D.maxCoeff());
+    }
+
+    /// Store the current pair of variations and assemble the Hessian approximation from its compact representation.
+    /// @see Byrd, R. H., Nocedal, J., Schnabel, R. B. (1994). Representations of quasi-Newton matrices and their use in limited memory methods. Mathematical Programming, 63, 129–156.
+    auto updateCompact(double sr) -> void
+    {
+        const Index n = s.size();
+        const Index memory = S.cols();
+
+        // Skip if no pair can be stored
+        if(memory == 0)
+            return;
+
+        // Discard the oldest pair if the memory is full
+        const Index k = std::min<Index>(numpairs, memory - 1);
+        if(numpairs >= memory)
+        {
+            S.leftCols(k) = S.rightCols(k).eval();
+            Y.leftCols(k) = Y.rightCols(k).eval();
+        }
+
+        // Store the new pair at the end
+        S.col(k) = s;
+        Y.col(k) = r;
+
+        // Update the scaling factor of the initial approximation with the new pair
+        sigma = r.squaredNorm() / sr;
+
+        // Assemble the dense matrix B = sigma*I - W*inv(M)*tr(W), with W = [sigma*S Y]
+        const Index p = k + 1;
+        factorizeCompact(p);
+        Matrix W(n, 2*p);
+        W.leftCols(p) = sigma * S.leftCols(p);
+        W.rightCols(p) = Y.leftCols(p);
+        result.hessian.dense = sigma * identity(n, n);
+        result.hessian.dense.noalias() -= W * lu.solve(tr(W));
+    }
+
+    /// Return the product of the Hessian approximation in compact representation with a vector.
+    auto compact(VectorConstRef v) -> Vector
+    {
+        const Index p = std::min<Index>(numpairs, S.cols());
+        if(p == 0)
+            return sigma * v;
+        factorizeCompact(p);
+        Vector Wv(2*p);
+        Wv.head(p) = sigma * tr(S.leftCols(p)) * v;
+        Wv.tail(p) = tr(Y.leftCols(p)) * v;
+        const Vector u = lu.solve(Wv);
+        return sigma * v - sigma * S.leftCols(p) * u.head(p) - Y.leftCols(p) * u.tail(p);
+    }
+
+    /// Factorize the middle matrix M of the compact representation with the first p stored pairs.
+    auto factorizeCompact(Index p) -> void
+    {
+        const Matrix SY = tr(S.leftCols(p)) * Y.leftCols(p);
+        Matrix M(2*p, 2*p);
+        M.topLeftCorner(p, p) = sigma * tr(S.leftCols(p)) * S.leftCols(p);
+        M.topRightCorner(p, p) = SY.triangularView<Eigen::StrictlyLower>();
+        M.bottomLeftCorner(p, p) = tr(M.topRightCorner(p, p));
+        M.bottomRightCorner(p, p) = -Matrix(SY.diagonal().asDiagonal());
+        lu.compute(M);
+    }
+};
+
+QuasiNewtonHessian::QuasiNewtonHessian()
+: pimpl(new Impl())
+{}
+
+QuasiNewtonHessian::QuasiNewtonHessian(const QuasiNewtonHessian& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+QuasiNewtonHessian::~QuasiNewtonHessian()
+{}
+
+auto QuasiNewtonHessian::operator=(QuasiNewtonHessian other) -> QuasiNewtonHessian&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto QuasiNewtonHessian::initialize(const OptimumHessianOptions& options, Index n) -> void
+{
+    pimpl->initialize(options, n);
+}
+
+auto QuasiNewtonHessian::update(VectorConstRef x, const ObjectiveResult& f) -> const ObjectiveResult&
+{
+    return pimpl->update(x, f);
+}
+
+} // namespace Optima
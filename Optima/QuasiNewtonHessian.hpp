@@ -0,0 +1,68 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class ObjectiveResult;
+struct OptimumHessianOptions;
+
+/// Used to approximate the Hessian matrix of the objective function from the variation of its gradient along the iterations.
+/// The pairs of variations of x and of the gradient, \eq{s} and \eq{y}, are damped as proposed by Powell, so that
+/// \eq{s^Tr\geq\delta s^TBs} with \eq{r} replacing \eq{y}, which keeps the approximation \eq{B} positive definite.
+/// @see OptimumHessianOptions
+class QuasiNewtonHessian
+{
+public:
+    /// Construct a default QuasiNewtonHessian instance.
+    QuasiNewtonHessian();
+
+    /// Construct a copy of a QuasiNewtonHessian instance.
+    QuasiNewtonHessian(const QuasiNewtonHessian& other);
+
+    /// Destroy this QuasiNewtonHessian instance.
+    virtual ~QuasiNewtonHessian();
+
+    /// Assign a QuasiNewtonHessian instance to this.
+    auto operator=(QuasiNewtonHessian other) -> QuasiNewtonHessian&;
+
+    /// Initialize the Hessian approximation for a new calculation.
+    /// @param options The options for the Hessian approximation.
+    /// @param n The number of variables.
+    auto initialize(const OptimumHessianOptions& options, Index n) -> void;
+
+    /// Update the Hessian approximation with the gradient at a new iterate and return the objective result with it.
+    /// @param x The new iterate.
+    /// @param f The evaluated value and gradient of the objective function at the new iterate.
+    auto update(VectorConstRef x, const ObjectiveResult& f) -> const ObjectiveResult&;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -30,9 +30,9 @@ SaddlePointMatrix::SaddlePointMatrix(VariantMatrixConstRef H, VectorConstRef D,
 SaddlePointMatrix::SaddlePointMatrix(VariantMatrixConstRef H, VectorConstRef D, MatrixConstRef A, VariantMatrixConstRef G, IndicesConstRef jf)
 : H(H), D(D), A(A), G(G), jf(jf)
 {
-    Assert(H.dense.rows() == A.cols() || H.diagonal.rows() == A.cols(),
+    Assert(H.dense.rows() == A.cols() || H.diagonal.rows() == A.cols() || H.structure == MatrixStructure::Zero,
         "Could not create a SaddlePointMatrix object.",
-            "Matrix A must have the same number of columns as there are rows in H.");
+            "Matrix A must have the same number of columns as there are rows in H, when non-zero.");
 
     Assert(D.rows() == 0 || D.rows() == A.cols(),
         "Could not create a SaddlePointMatrix object.",
@@ -66,6 +66,14 @@ public:
     /// @see maxdenominator
     bool rationalize = false;
 
+    /// The option to canonicalize the coefficient matrix \eq{A} using exact integer arithmetic.
+    /// This option should be turned on if the entries in the coefficient matrix \eq{A} of the
+    /// saddle point problem are integers (e.g., formula matrices of chemical species). In this case,
+    /// the canonical form is computed with a fraction-free elimination and is free of round-off
+    /// errors. If the entries in \eq{A} are not integers, the floating-point algorithm is used.
+    /// @see Canonicalizer::computeExact
+    bool exact = false;
+
     /// The value of the maximum denominator to be used in a rationalize operation.
     /// This option should be used in conjunction with option @ref rationalize.
     /// @see rationalize
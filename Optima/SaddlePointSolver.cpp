@@ -73,14 +73,21 @@ struct SaddlePointSolver::Impl
     /// The 'G' matrix in the saddle point matrix.
     VariantMatrix G;
 
-    /// The workspace for the right-hand side vectors a and b
-    Vector a, b;
+    /// The workspace for the right-hand sides a and b and for the system of linear equations in the solve method.
+    template<typename T>
+    struct Workspace
+    {
+        T a, b, vec;
+    };
 
-    /// The matrix used as a workspace for the decompose and solve methods.
+    /// The matrix used as a workspace for the decompose method.
     Matrix mat;
 
-    /// The vector used as a workspace for the decompose and solve methods.
-    Vector vec;
+    /// The workspace for the solve method with a single right-hand side vector.
+    Workspace<Vector> wvector;
+
+    /// The workspace for the solve method with several right-hand side vectors, one per column.
+    Workspace<Matrix> wmatrix;
 
     /// The ordering of the variables as (free-basic, free-non-basic, fixed-basic, fixed-non-basic)
     Indices iordering;
@@ -91,6 +98,9 @@ struct SaddlePointSolver::Impl
     /// The boolean flag that indicates that the decomposed saddle point matrix was degenerate with no free variables.
     bool degenerate = false;
 
+    /// The boolean flag that indicates if the priority weights of the last decomposition are available (false after @ref initialize).
+    bool weighted = false;
+
     /// The saddle point method most appropriate for the structure of the H matrix.
     /// The user provided method is replaced according to the following conditions:
     /// 1) Use Rangespace if Fullspace or Nullspace is specified, but the structure of matrix H is diagonal.
@@ -108,15 +118,16 @@ struct SaddlePointSolver::Impl
         n = A.cols();
 
         // Allocate auxiliary memory
-        a.resize(n);
-        b.resize(m);
+        wvector.a.resize(n);
+        wvector.b.resize(m);
+        wvector.vec.resize(n + m);
         mat.resize(n + m, n + m);
-        vec.resize(n + m);
         weights.resize(n);
         iordering.resize(n);
 
         // Compute the canonical form of matrix A
-        canonicalizer.compute(A);
+        if(options.exact) canonicalizer.computeExact(A);
+        else canonicalizer.compute(A);
 
         // Set the number of basic and non-basic variables
         nb = canonicalizer.numBasicVariables();
@@ -149,12 +160,20 @@ struct SaddlePointSolver::Impl
         iordering.head(nb) = canonicalizer.indicesBasicVariables();
         iordering.tail(nn) = canonicalizer.indicesNonBasicVariables();
 
+        // The priority weights need to be computed in the next decomposition
+        weighted = false;
+
         return res.stop();
     }
 
     /// Update the canonical form of the coefficient matrix *A* of the saddle point problem.
-    auto updateCanonicalForm(SaddlePointMatrix lhs) -> void
+    /// If `keepbasic` is true and the fixed variables are the same as in the last decomposition,
+    /// the basic variables are kept and only their ordering is updated with the new priority weights.
+    auto updateCanonicalForm(SaddlePointMatrix lhs, bool keepbasic) -> void
     {
+        // The number of fixed variables in the last decomposition
+        const Index nfprev = nf;
+
         // Update the number of fixed and free variables
         nf = lhs.jf.size();
         nx = n - nf;
@@ -162,25 +181,32 @@ struct SaddlePointSolver::Impl
         // Determine if the saddle point matrix is degenerate
         degenerate = nx == 0;
 
-        // Skip the rest if there is no free variables
+        // Skip the rest if there is no free variables (the weights are not updated in this case)
         if(degenerate)
+        {
+            weighted = false;
             return;
+        }
 
-        // The ordering of the variables as (free variables, fixed variables)
-        partitionRight(iordering, lhs.jf);
+        // The indices of the fixed (jf) variables (the ordering of the variables is updated below from the canonical form)
+        const auto jf = lhs.jf;
 
-        // The indices of the fixed (jf) variables
-        const auto jf = iordering.tail(nf);
+        // Check if the fixed variables are the same as in the last decomposition, which had non-positive weights only for them
+        const bool samefixed = weighted && nf == nfprev && (weights(jf).array() <= 0.0).all();
 
         // Update the priority weights for the update of the canonical form
-        weights.noalias() = lhs.H.diagonalRef();
+        if(lhs.H.structure == MatrixStructure::Zero) weights.fill(0.0);
+        else weights.noalias() = lhs.H.diagonalRef();
         if(lhs.D.size()) weights += lhs.D;
 
         weights.noalias() = abs(inv(weights));
         weights(jf).noalias() = -linspace(nf, 1, nf);
 
-        // Update the canonical form and the ordering of the variables
-        canonicalizer.updateWithPriorityWeights(weights);
+        // Update the canonical form and the ordering of the variables (only the ordering if the basic variables are kept)
+        if(keepbasic && samefixed) canonicalizer.updateOrderingWithPriorityWeights(weights);
+        else canonicalizer.updateWithPriorityWeights(weights);
+
+        weighted = true;
 
         // Get the updated indices of basic and non-basic variables
         const auto ibasic = canonicalizer.indicesBasicVariables();
@@ -219,12 +245,12 @@ struct SaddlePointSolver::Impl
     }
 
     /// Decompose the coefficient matrix of the saddle point problem.
-    auto decompose(SaddlePointMatrix lhs) -> Result
+    auto decompose(SaddlePointMatrix lhs, bool keepbasic) -> Result
     {
         Result res;
 
         // Update the canonical form of the matrix A
-        updateCanonicalForm(lhs);
+        updateCanonicalForm(lhs, keepbasic);
 
         // Optimize the choice of method based on the structure of the
         switch(lhs.H.structure) {
@@ -417,7 +443,8 @@ struct SaddlePointSolver::Impl
         auto jx = iordering.head(nx);
 
         // Retrieve the entries in H corresponding to free variables.
-        Hx.noalias() = lhs.H.diagonal(jx);
+        if(lhs.H.structure == MatrixStructure::Zero) Hx.fill(0.0);
+        else Hx.noalias() = lhs.H.diagonal(jx);
 
         // Add the D contribution from the free variables to the H + D block
         if(lhs.D.size()) Hx.noalias() += lhs.D(jx);
@@ -542,7 +569,8 @@ struct SaddlePointSolver::Impl
         auto jx = iordering.head(nx);
 
         // Retrieve the entries in H corresponding to free variables.
-        Hx.noalias() = lhs.H.diagonalRef()(jx);
+        if(lhs.H.structure == MatrixStructure::Zero) Hx.fill(0.0);
+        else Hx.noalias() = lhs.H.diagonalRef()(jx);
 
         // Add the D contribution from the free variables to the H + D block
         if(lhs.D.size()) Hx.noalias() += lhs.D(jx);
@@ -810,49 +838,73 @@ struct SaddlePointSolver::Impl
 
     /// Solve the saddle point problem with diagonal Hessian matrix.
     auto solve(SaddlePointVector rhs, SaddlePointSolution sol) -> Result
+    {
+        return solve<VectorConstRef, VectorRef>(rhs.a, rhs.b, sol.x, sol.y, wvector);
+    }
+
+    /// Solve the saddle point problem for several right-hand side vectors, given as the columns of `rhs`.
+    auto solve(MatrixConstRef rhs, MatrixRef sol) -> Result
+    {
+        // Resize the workspace matrices for the number of right-hand side vectors
+        const Index k = rhs.cols();
+        wmatrix.a.resize(n, k);
+        wmatrix.b.resize(m, k);
+        wmatrix.vec.resize(n + m, k);
+
+        return solve<MatrixConstRef, MatrixRef>(rhs.topRows(n), rhs.bottomRows(m), sol.topRows(n), sol.bottomRows(m), wmatrix);
+    }
+
+    /// Solve the saddle point problem for the right-hand side [a b] with solution [x y], which are either
+    /// vectors or matrices with one column per right-hand side vector (with workspace of the same kind).
+    template<typename ConstRef, typename Ref, typename T>
+    auto solve(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y, Workspace<T>& ws) -> Result
     {
         Result res;
 
         // Check if the saddle point matrix is degenerate, with no free variables.
         if(degenerate)
-            solveDegenerateCase(rhs, sol);
+            solveDegenerateCase<ConstRef, Ref>(rhsa, rhsb, x, y);
 
         else switch(best_method)
         {
-        case SaddlePointMethod::Nullspace: solveNullspace(rhs, sol); break;
-        case SaddlePointMethod::Rangespace: solveRangespace(rhs, sol); break;
-        default: solveFullspace(rhs, sol); break;
+        case SaddlePointMethod::Nullspace: solveNullspace<ConstRef, Ref>(rhsa, rhsb, x, y, ws); break;
+        case SaddlePointMethod::Rangespace: solveRangespace<ConstRef, Ref>(rhsa, rhsb, x, y, ws); break;
+        default: solveFullspace<ConstRef, Ref>(rhsa, rhsb, x, y, ws); break;
         }
 
         return res.stop();
     }
 
     /// Solve the saddle point problem for the degenerate case of no free variables.
-    auto solveDegenerateCase(SaddlePointVector rhs, SaddlePointSolution sol) -> void
+    template<typename ConstRef, typename Ref>
+    auto solveDegenerateCase(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y) -> void
     {
-        sol.x = rhs.a;
+        x = rhsa;
 
         if(G.structure == MatrixStructure::Dense)
-            sol.y.noalias() = lu.solve(rhs.b);
+            y.noalias() = lu.solve(rhsb);
         else
-            sol.y.fill(0.0);
+            y.fill(0.0);
     }
 
     /// Solve the saddle point problem using a LU decomposition method.
-    auto solveFullspace(SaddlePointVector rhs, SaddlePointSolution sol) -> void
+    template<typename ConstRef, typename Ref, typename T>
+    auto solveFullspace(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y, Workspace<T>& ws) -> void
     {
         switch(G.structure) {
-            case MatrixStructure::Zero: solveFullspaceZeroG(rhs, sol); break;
-            default: solveFullspaceDenseG(rhs, sol); break;
+            case MatrixStructure::Zero: solveFullspaceZeroG<ConstRef, Ref>(rhsa, rhsb, x, y, ws); break;
+            default: solveFullspaceDenseG<ConstRef, Ref>(rhsa, rhsb, x, y, ws); break;
         }
     }
 
     /// Solve the saddle point problem using a LU decomposition method.
-    auto solveFullspaceZeroG(SaddlePointVector rhs, SaddlePointSolution sol) -> void
+    template<typename ConstRef, typename Ref, typename T>
+    auto solveFullspaceZeroG(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y, Workspace<T>& ws) -> void
     {
-        // Alias to members of the saddle point vector solution.
-        auto x = sol.x;
-        auto y = sol.y;
+        // Alias to the workspace of the right-hand side vectors a and b, and of the linear system
+        T& a = ws.a;
+        T& b = ws.b;
+        T& vec = ws.vec;
 
         // Alias to the matrices of the canonicalization process
         auto S = canonicalizer.S();
@@ -863,20 +915,20 @@ struct SaddlePointSolver::Impl
         auto Sbfnf = S.bottomRightCorner(nbf, nnf);
 
         // View to the sub-vectors of right-hand side vector a.
-        auto ax = a.head(nx);
-        auto af = a.tail(nf);
-        auto abf = af.head(nbf);
-        auto anf = af.tail(nnf);
+        auto ax = a.topRows(nx);
+        auto af = a.bottomRows(nf);
+        auto abf = af.topRows(nbf);
+        auto anf = af.bottomRows(nnf);
 
         // View to the sub-vectors of right-hand side vector b.
-        auto bbx = b.head(nbx);
-        auto bbf = b.segment(nbx, nbf);
+        auto bbx = b.topRows(nbx);
+        auto bbf = b.middleRows(nbx, nbf);
 
         // Retrieve the values of a using the ordering of the free and fixed variables
-        a.noalias() = rhs.a(iordering);
+        a.noalias() = rhsa(iordering, all);
 
         // Calculate b' = R * b
-        b.noalias() = R * rhs.b;
+        b.noalias() = R * rhsb;
 
         // Calculate bbx'' = bbx' - Sbxnf*anf
         bbx -= Sbxnf * anf;
@@ -885,7 +937,7 @@ struct SaddlePointSolver::Impl
         bbf -= Sbfnf * anf + abf;
 
         // View to the right-hand side vector r of the system of linear equations
-        auto r = vec.head(nx + nbx);
+        auto r = vec.topRows(nx + nbx);
 
         // Update the vector r = [ax b]
         r << ax, bbx;
@@ -894,24 +946,26 @@ struct SaddlePointSolver::Impl
         r.noalias() = lu.solve(r);
 
         // Get the result of xnx from r
-        ax.noalias() = r.head(nx);
+        ax.noalias() = r.topRows(nx);
 
         // Get the result of y' from r into bbx
-        bbx.noalias() = r.tail(nbx);
+        bbx.noalias() = r.bottomRows(nbx);
 
         // Compute y = tr(R) * y'
         y.noalias() = tr(R)*b;
 
         // Permute back the variables x to their original ordering
-        x(iordering).noalias() = a;
+        x(iordering, all).noalias() = a;
     }
 
     /// Solve the saddle point problem using a LU decomposition method.
-    auto solveFullspaceDenseG(SaddlePointVector rhs, SaddlePointSolution sol) -> void
+    template<typename ConstRef, typename Ref, typename T>
+    auto solveFullspaceDenseG(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y, Workspace<T>& ws) -> void
     {
-        // Alias to members of the saddle point vector solution.
-        auto x = sol.x;
-        auto y = sol.y;
+        // Alias to the workspace of the right-hand side vectors a and b, and of the linear system
+        T& a = ws.a;
+        T& b = ws.b;
+        T& vec = ws.vec;
 
         // Alias to the matrices of the canonicalization process
         auto S = canonicalizer.S();
@@ -922,20 +976,20 @@ struct SaddlePointSolver::Impl
         auto Sbfnf = S.bottomRightCorner(nbf, nnf);
 
         // View to the sub-vectors of right-hand side vector a.
-        auto ax = a.head(nx);
-        auto af = a.tail(nf);
-        auto abf = af.head(nbf);
-        auto anf = af.tail(nnf);
+        auto ax = a.topRows(nx);
+        auto af = a.bottomRows(nf);
+        auto abf = af.topRows(nbf);
+        auto anf = af.bottomRows(nnf);
 
         // View to the sub-vectors of right-hand side vector b.
-        auto bbx = b.head(nbx);
-        auto bbf = b.segment(nbx, nbf);
+        auto bbx = b.topRows(nbx);
+        auto bbf = b.middleRows(nbx, nbf);
 
         // Retrieve the values of a using the ordering of the free and fixed variables
-        a.noalias() = rhs.a(iordering);
+        a.noalias() = rhsa(iordering, all);
 
         // Calculate b' = R * b
-        b.noalias() = R * rhs.b;
+        b.noalias() = R * rhsb;
 
         // Calculate bbx'' = bbx' - Sbxnf*anf
         bbx -= Sbxnf * anf;
@@ -944,7 +998,7 @@ struct SaddlePointSolver::Impl
         bbf -= Sbfnf * anf + abf;
 
         // View to the right-hand side vector r of the system of linear equations
-        auto r = vec.head(nx + m);
+        auto r = vec.topRows(nx + m);
 
         // Update the vector r = [ax b]
         r << ax, b;
@@ -953,42 +1007,46 @@ struct SaddlePointSolver::Impl
         r.noalias() = lu.solve(r);
 
         // Get the result of xnx from r
-        ax.noalias() = r.head(nx);
+        ax.noalias() = r.topRows(nx);
 
         // The y' vector as the tail of the solution of the linear system
-        auto yp = r.tail(m);
+        auto yp = r.bottomRows(m);
 
         // Compute y = tr(R) * y'
         y.noalias() = tr(R)*yp;
 
         // Permute back the variables x to their original ordering
-        x(iordering).noalias() = a;
+        x(iordering, all).noalias() = a;
     }
 
     /// Solve the saddle point problem using a rangespace diagonal method.
-    auto solveRangespaceAux(SaddlePointVector rhs, SaddlePointSolution sol) -> void
+    template<typename ConstRef, typename Ref, typename T>
+    auto solveRangespaceAux(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y, Workspace<T>& ws) -> void
     {
         switch(G.structure) {
-            case MatrixStructure::Zero: solveRangespaceZeroG(rhs, sol); break;
-            default: solveRangespaceDenseG(rhs, sol); break;
+            case MatrixStructure::Zero: solveRangespaceZeroG<ConstRef, Ref>(rhsa, rhsb, x, y, ws); break;
+            default: solveRangespaceDenseG<ConstRef, Ref>(rhsa, rhsb, x, y, ws); break;
         }
     }
 
     /// Solve the saddle point problem using a rangespace diagonal method.
-    auto solveRangespace(SaddlePointVector rhs, SaddlePointSolution sol) -> void
+    template<typename ConstRef, typename Ref, typename T>
+    auto solveRangespace(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y, Workspace<T>& ws) -> void
     {
         switch(H.structure) {
-            case MatrixStructure::Dense: solveNullspace(rhs, sol); break;
-            default: solveRangespaceAux(rhs, sol); break;
+            case MatrixStructure::Dense: solveNullspace<ConstRef, Ref>(rhsa, rhsb, x, y, ws); break;
+            default: solveRangespaceAux<ConstRef, Ref>(rhsa, rhsb, x, y, ws); break;
         }
     }
 
     /// Solve the saddle point problem using a rangespace diagonal method.
-    auto solveRangespaceZeroG(SaddlePointVector rhs, SaddlePointSolution sol) -> void
+    template<typename ConstRef, typename Ref, typename T>
+    auto solveRangespaceZeroG(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y, Workspace<T>& ws) -> void
     {
-        // Alias to members of the saddle point vector solution.
-        auto x = sol.x;
-        auto y = sol.y;
+        // Alias to the workspace of the right-hand side vectors a and b, and of the linear system
+        T& a = ws.a;
+        T& b = ws.b;
+        T& vec = ws.vec;
 
         // Alias to the matrices of the canonicalization process
         auto S = canonicalizer.S();
@@ -1009,47 +1067,47 @@ struct SaddlePointSolver::Impl
         auto Hb2b2 = Hbxbx.head(nb2);
         auto Hn1n1 = Hnxnx.tail(nn1);
 
-        auto ax  = a.head(nx);
-        auto af  = a.tail(nf);
-        auto abx = ax.head(nbx);
-        auto anx = ax.tail(nnx);
-        auto anf = af.tail(nnf);
-        auto ab1 = abx.tail(nb1);
-        auto ab2 = abx.head(nb2);
-        auto an1 = anx.tail(nn1);
-        auto an2 = anx.head(nn2);
+        auto ax  = a.topRows(nx);
+        auto af  = a.bottomRows(nf);
+        auto abx = ax.topRows(nbx);
+        auto anx = ax.bottomRows(nnx);
+        auto anf = af.bottomRows(nnf);
+        auto ab1 = abx.bottomRows(nb1);
+        auto ab2 = abx.topRows(nb2);
+        auto an1 = anx.bottomRows(nn1);
+        auto an2 = anx.topRows(nn2);
 
-        auto bbx = b.head(nbx);
-        auto bb1 = bbx.tail(nb1);
-        auto bb2 = bbx.head(nb2);
+        auto bbx = b.topRows(nbx);
+        auto bb1 = bbx.bottomRows(nb1);
+        auto bb2 = bbx.topRows(nb2);
 
-        a.noalias() = rhs.a(iordering);
+        a.noalias() = rhsa(iordering, all);
 
-        b.noalias() = R * rhs.b;
+        b.noalias() = R * rhsb;
 
         anx -= tr(Sb2nx) * ab2;
         bbx -= Sbxnf * anf;
 
-        an1.noalias() = an1/Hn1n1;
+        an1.array().colwise() /= Hn1n1.array();
 
-        bb1 -= ab1/Hb1b1;
+        bb1.array() -= ab1.array().colwise() / Hb1b1.array();
         bb1 -= Sb1n1 * an1;
 
         bb2 -= Sb2n1 * an1;
 
-        auto r = vec.head(nb1 + nb2 + nn2);
+        auto r = vec.topRows(nb1 + nb2 + nn2);
 
-        auto xn2 = r.head(nn2);
-        auto yb1 = r.segment(nn2, nb1);
-        auto xb2 = r.segment(nn2 + nb1, nb2);
+        auto xn2 = r.topRows(nn2);
+        auto yb1 = r.middleRows(nn2, nb1);
+        auto xb2 = r.middleRows(nn2 + nb1, nb2);
 
         r << an2, bb1, bb2;
 
         r.noalias() = lu.solve(r);
 
-        ab1.noalias() = (ab1 - yb1)/Hb1b1;
-        bb2.noalias() = (ab2 - Hb2b2 % xb2);
-        an1.noalias() -= (tr(Sb1n1)*yb1 + tr(Sb2n1)*(bb2 - ab2))/Hn1n1;
+        ab1.array() = (ab1 - yb1).array().colwise() / Hb1b1.array();
+        bb2.array() = ab2.array() - xb2.array().colwise() * Hb2b2.array();
+        an1.array() -= (tr(Sb1n1)*yb1 + tr(Sb2n1)*(bb2 - ab2)).array().colwise() / Hn1n1.array();
 
         an2.noalias() = xn2;
         bb1.noalias() = yb1;
@@ -1059,15 +1117,17 @@ struct SaddlePointSolver::Impl
         y.noalias() = tr(R) * b;
 
         // Permute back the variables `x` to their original ordering
-        x(iordering).noalias() = a;
+        x(iordering, all).noalias() = a;
     }
 
     /// Solve the saddle point problem using a rangespace diagonal method.
-    auto solveRangespaceDenseG(SaddlePointVector rhs, SaddlePointSolution sol) -> void
+    template<typename ConstRef, typename Ref, typename T>
+    auto solveRangespaceDenseG(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y, Workspace<T>& ws) -> void
     {
-        // Alias to members of the saddle point vector solution.
-        auto x = sol.x;
-        auto y = sol.y;
+        // Alias to the workspace of the right-hand side vectors a and b, and of the linear system
+        T& a = ws.a;
+        T& b = ws.b;
+        T& vec = ws.vec;
 
         // Alias to the matrices of the canonicalization process
         auto S = canonicalizer.S();
@@ -1103,34 +1163,34 @@ struct SaddlePointSolver::Impl
         auto Gbfb2 = Gbfbx.leftCols(nb2);
         auto Gblb2 = Gblbx.leftCols(nb2);
 
-        auto ax  = a.head(nx);
-        auto af  = a.tail(nf);
-        auto abx = ax.head(nbx);
-        auto anx = ax.tail(nnx);
-        auto abf = af.head(nbf);
-        auto anf = af.tail(nnf);
-        auto ab1 = abx.tail(nb1);
-        auto ab2 = abx.head(nb2);
-        auto an1 = anx.tail(nn1);
-        auto an2 = anx.head(nn2);
+        auto ax  = a.topRows(nx);
+        auto af  = a.bottomRows(nf);
+        auto abx = ax.topRows(nbx);
+        auto anx = ax.bottomRows(nnx);
+        auto abf = af.topRows(nbf);
+        auto anf = af.bottomRows(nnf);
+        auto ab1 = abx.bottomRows(nb1);
+        auto ab2 = abx.topRows(nb2);
+        auto an1 = anx.bottomRows(nn1);
+        auto an2 = anx.topRows(nn2);
 
-        auto bbx = b.head(nbx);
-        auto bbf = b.segment(nbx, nbf);
-        auto bl  = b.tail(nl);
-        auto bb1 = bbx.tail(nb1);
-        auto bb2 = bbx.head(nb2);
+        auto bbx = b.topRows(nbx);
+        auto bbf = b.middleRows(nbx, nbf);
+        auto bl  = b.bottomRows(nl);
+        auto bb1 = bbx.bottomRows(nb1);
+        auto bb2 = bbx.topRows(nb2);
 
-        a.noalias() = rhs.a(iordering);
+        a.noalias() = rhsa(iordering, all);
 
-        b.noalias() = R * rhs.b;
+        b.noalias() = R * rhsb;
 
         anx -= tr(Sb2nx) * ab2;
         bbx -= Sbxnf * anf;
         bbf -= Sbfnf * anf + abf;
 
-        an1.noalias() = an1/Hn1n1;
+        an1.array().colwise() /= Hn1n1.array();
 
-        bb1 -= ab1/Hb1b1;
+        bb1.array() -= ab1.array().colwise() / Hb1b1.array();
         bb1 -= Sb1n1 * an1;
         bb1 -= Gb1b2 * ab2;
 
@@ -1139,21 +1199,21 @@ struct SaddlePointSolver::Impl
         bbf -= Gbfb2 * ab2;
         bl  -= Gblb2 * ab2;
 
-        auto r = vec.head(nn2 + m);
+        auto r = vec.topRows(nn2 + m);
 
-        auto xn2 = r.head(nn2);
-        auto yb1 = r.segment(nn2, nb1);
-        auto xb2 = r.segment(nn2 + nb1, nb2);
-        auto ybf = r.segment(nn2 + nb1 + nb2, nbf);
-        auto yl = r.tail(nl);
+        auto xn2 = r.topRows(nn2);
+        auto yb1 = r.middleRows(nn2, nb1);
+        auto xb2 = r.middleRows(nn2 + nb1, nb2);
+        auto ybf = r.middleRows(nn2 + nb1 + nb2, nbf);
+        auto yl = r.bottomRows(nl);
 
         r << an2, bb1, bb2, bbf, bl;
 
         r.noalias() = lu.solve(r);
 
-        ab1.noalias() = (ab1 - yb1)/Hb1b1;
-        bb2.noalias() = (ab2 - Hb2b2 % xb2);
-        an1.noalias() -= (tr(Sb1n1)*yb1 + tr(Sb2n1)*(bb2 - ab2))/Hn1n1;
+        ab1.array() = (ab1 - yb1).array().colwise() / Hb1b1.array();
+        bb2.array() = ab2.array() - xb2.array().colwise() * Hb2b2.array();
+        an1.array() -= (tr(Sb1n1)*yb1 + tr(Sb2n1)*(bb2 - ab2)).array().colwise() / Hn1n1.array();
 
         an2.noalias() = xn2;
         bb1.noalias() = yb1;
@@ -1165,36 +1225,43 @@ struct SaddlePointSolver::Impl
         y.noalias() = tr(R) * b;
 
         // Permute back the variables `x` to their original ordering
-        x(iordering).noalias() = a;
+        x(iordering, all).noalias() = a;
     }
 
     /// Solve the saddle point problem using a nullspace method.
-    auto solveNullspace(SaddlePointVector rhs, SaddlePointSolution sol) -> void
+    template<typename ConstRef, typename Ref, typename T>
+    auto solveNullspace(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y, Workspace<T>& ws) -> void
     {
         switch(G.structure) {
-            case MatrixStructure::Zero: solveNullspaceZeroG(rhs, sol); break;
-            default: solveNullspaceDenseG(rhs, sol); break;
+            case MatrixStructure::Zero: solveNullspaceZeroG<ConstRef, Ref>(rhsa, rhsb, x, y, ws); break;
+            default: solveNullspaceDenseG<ConstRef, Ref>(rhsa, rhsb, x, y, ws); break;
         }
     }
 
     /// Solve the saddle point problem using a nullspace method.
-    auto solveNullspaceZeroG(SaddlePointVector rhs, SaddlePointSolution sol) -> void
+    template<typename ConstRef, typename Ref, typename T>
+    auto solveNullspaceZeroG(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y, Workspace<T>& ws) -> void
     {
+        // Alias to the workspace of the right-hand side vectors a and b, and of the linear system
+        T& a = ws.a;
+        T& b = ws.b;
+        T& vec = ws.vec;
+
         // Alias to the matrices of the canonicalization process
         auto S = canonicalizer.S();
         auto R = canonicalizer.R();
 
         // Views to the sub-vectors of right-hand side vector a = [ax af]
-        auto ax = a.head(nx);
-        auto af = a.tail(nf);
-        auto abx = ax.head(nbx);
-        auto anx = ax.tail(nnx);
-        auto abf = af.head(nbf);
-        auto anf = af.tail(nnf);
+        auto ax = a.topRows(nx);
+        auto af = a.bottomRows(nf);
+        auto abx = ax.topRows(nbx);
+        auto anx = ax.bottomRows(nnx);
+        auto abf = af.topRows(nbf);
+        auto anf = af.bottomRows(nnf);
 
         // Views to the sub-vectors of right-hand side vector b = [bx bf bl]
-        auto bbx = b.head(nbx);
-        auto bbf = b.segment(nbx, nbf);
+        auto bbx = b.topRows(nbx);
+        auto bbf = b.middleRows(nbx, nbf);
 
         // Views to the sub-matrices of the canonical matrix S
         auto Sbxnx = S.topLeftCorner(nbx, nnx);
@@ -1208,16 +1275,16 @@ struct SaddlePointSolver::Impl
         auto Hnxbx = Hx.bottomLeftCorner(nnx, nbx);
 
         // The vector y' = [ybx' ybf' ybl']
-        auto yp   = vec.head(m);
-        auto ypbx = yp.head(nbx);
-        auto ypbf = yp.segment(nbx, nbf);
-        auto ypbl = yp.tail(nl);
+        auto yp   = vec.topRows(m);
+        auto ypbx = yp.topRows(nbx);
+        auto ypbf = yp.middleRows(nbx, nbf);
+        auto ypbl = yp.bottomRows(nl);
 
         // Set vectors `ax` and `af` using values from `a`
-        a.noalias() = rhs.a(iordering);
+        a.noalias() = rhsa(iordering, all);
 
         // Calculate b' = R*b
-        b.noalias() = R*rhs.b;
+        b.noalias() = R*rhsb;
 
         // Calculate bbx'' = bbx' - Sbxnf*anf
         bbx -= Sbxnf*anf;
@@ -1237,44 +1304,46 @@ struct SaddlePointSolver::Impl
         // Solve the system of linear equations
         if(nnx) anx.noalias() = lu.solve(anx);
 
-        // Alias to solution vectors x and y
-        auto x = sol.x;
-        auto y = sol.y;
-
         // Calculate xbx and store in abx
         abx.noalias() = bbx - Sbxnx*anx;
 
         // Calculate y'
         ypbx -= Hbxbx*abx + Hbxnx*anx;
-        ypbf.noalias() = zeros(nbf);
-        ypbl.noalias() = zeros(nl);
+        ypbf.setZero();
+        ypbl.setZero();
 
         // Calculate y = tr(R) * y'
         y.noalias() = tr(R) * yp;
 
         // Set back the values of x currently stored in a
-        x(iordering).noalias() = a;
+        x(iordering, all).noalias() = a;
     }
 
     /// Solve the saddle point problem using a nullspace method.
-    auto solveNullspaceDenseG(SaddlePointVector rhs, SaddlePointSolution sol) -> void
+    template<typename ConstRef, typename Ref, typename T>
+    auto solveNullspaceDenseG(ConstRef rhsa, ConstRef rhsb, Ref x, Ref y, Workspace<T>& ws) -> void
     {
+        // Alias to the workspace of the right-hand side vectors a and b, and of the linear system
+        T& a = ws.a;
+        T& b = ws.b;
+        T& vec = ws.vec;
+
         // Alias to the matrices of the canonicalization process
         auto S = canonicalizer.S();
         auto R = canonicalizer.R();
 
         // Views to the sub-vectors of right-hand side vector a = [ax af]
-        auto ax = a.head(nx);
-        auto af = a.tail(nf);
-        auto abx = ax.head(nbx);
-        auto anx = ax.tail(nnx);
-        auto abf = af.head(nbf);
-        auto anf = af.tail(nnf);
+        auto ax = a.topRows(nx);
+        auto af = a.bottomRows(nf);
+        auto abx = ax.topRows(nbx);
+        auto anx = ax.bottomRows(nnx);
+        auto abf = af.topRows(nbf);
+        auto anf = af.bottomRows(nnf);
 
         // Views to the sub-vectors of right-hand side vector b = [bx bf bl]
-        auto bbx = b.head(nbx);
-        auto bbf = b.segment(nbx, nbf);
-        auto bbl = b.tail(nl);
+        auto bbx = b.topRows(nbx);
+        auto bbf = b.middleRows(nbx, nbf);
+        auto bbl = b.bottomRows(nl);
 
         // Views to the sub-matrices of the canonical matrix S
         auto Sbxnx = S.topLeftCorner(nbx, nnx);
@@ -1294,19 +1363,19 @@ struct SaddlePointSolver::Impl
         auto jf = iordering.tail(nf);
 
         // The right-hand side vector r = [rnx rbx rbf rbl]
-        auto r = vec.head(nnx + m);
-        auto rnx = r.head(nnx);
-        auto rb  = r.tail(m);
-        auto rbx = rb.head(nbx);
-        auto rbf = rb.segment(nbx, nbf);
-        auto rbl = rb.tail(nl);
+        auto r = vec.topRows(nnx + m);
+        auto rnx = r.topRows(nnx);
+        auto rb  = r.bottomRows(m);
+        auto rbx = rb.topRows(nbx);
+        auto rbf = rb.middleRows(nbx, nbf);
+        auto rbl = rb.bottomRows(nl);
 
         // Set vectors `ax` and `af` using values from `a`
-        ax.noalias() = rhs.a(jx);
-        af.noalias() = rhs.a(jf);
+        ax.noalias() = rhsa(jx, all);
+        af.noalias() = rhsa(jf, all);
 
         // Calculate b' = R*b
-        b.noalias() = R*rhs.b;
+        b.noalias() = R*rhsb;
 
         // Calculate bbx'' = bbx' - Sbxnf*anf
         bbx -= Sbxnf*anf;
@@ -1323,10 +1392,6 @@ struct SaddlePointSolver::Impl
         // Solve the system of linear equations
         r.noalias() = lu.solve(r);
 
-        // Alias to solution vectors x and y
-        auto x = sol.x;
-        auto y = sol.y;
-
         // Calculate y = tr(R) * y'
         y.noalias() = tr(R) * rb;
 
@@ -1335,7 +1400,7 @@ struct SaddlePointSolver::Impl
         abx.noalias() = bbx - Sbxnx*anx - Gbx*rb;
 
         // Set back the values of x currently stored in a
-        x(iordering).noalias() = a;
+        x(iordering, all).noalias() = a;
     }
 };
 
@@ -1366,6 +1431,11 @@ auto SaddlePointSolver::options() const -> const SaddlePointOptions&
     return pimpl->options;
 }
 
+auto SaddlePointSolver::canonicalizer() const -> const Canonicalizer&
+{
+    return pimpl->canonicalizer;
+}
+
 auto SaddlePointSolver::initialize(MatrixConstRef A) -> Result
 {
     return pimpl->initialize(A);
@@ -1373,7 +1443,12 @@ auto SaddlePointSolver::initialize(MatrixConstRef A) -> Result
 
 auto SaddlePointSolver::decompose(SaddlePointMatrix lhs) -> Result
 {
-    return pimpl->decompose(lhs);
+    return pimpl->decompose(lhs, false);
+}
+
+auto SaddlePointSolver::decomposeKeepingBasicVariables(SaddlePointMatrix lhs) -> Result
+{
+    return pimpl->decompose(lhs, true);
 }
 
 auto SaddlePointSolver::solve(SaddlePointVector rhs, SaddlePointSolution sol) -> Result
@@ -1381,4 +1456,9 @@ auto SaddlePointSolver::solve(SaddlePointVector rhs, SaddlePointSolution sol) ->
     return pimpl->solve(rhs, sol);
 }
 
+auto SaddlePointSolver::solve(MatrixConstRef rhs, MatrixRef sol) -> Result
+{
+    return pimpl->solve(rhs, sol);
+}
+
 } // namespace Optima
@@ -27,6 +27,7 @@
 namespace Optima {
 
 // Forward declarations
+class Canonicalizer;
 class Result;
 class SaddlePointMatrix;
 class SaddlePointOptions;
@@ -81,6 +82,13 @@ public:
     /// @param lhs The coefficient matrix of the saddle point problem.
     auto decompose(SaddlePointMatrix lhs) -> Result;
 
+    /// Decompose the coefficient matrix of the saddle point problem keeping the basic variables of the last decomposition.
+    /// The search for basic variables with higher priority weights is skipped, and only the ordering of the basic and
+    /// non-basic variables is updated. This is done only if the fixed variables are the same as in the last decomposition,
+    /// otherwise this method is equivalent to @ref decompose.
+    /// @param lhs The coefficient matrix of the saddle point problem.
+    auto decomposeKeepingBasicVariables(SaddlePointMatrix lhs) -> Result;
+
     /// Solve the saddle point problem.
     /// @note This method expects that a call to method @ref decompose has already been performed.
     /// @param lhs The coefficient matrix of the saddle point problem.
@@ -88,6 +96,16 @@ public:
     /// @param sol The solution of the saddle point problem.
     auto solve(SaddlePointVector rhs, SaddlePointSolution sol) -> Result;
 
+    /// Solve the saddle point problem for several right-hand side vectors at once.
+    /// @note This method expects that a call to method @ref decompose has already been performed.
+    /// @param rhs The matrix whose columns are the right-hand side vectors [a b] of the saddle point problem.
+    /// @param sol The matrix whose columns are the solution vectors [x y] of the saddle point problem.
+    auto solve(MatrixConstRef rhs, MatrixRef sol) -> Result;
+
+    /// Return the canonical form of the coefficient matrix \eq{A} of the saddle point problem.
+    /// @note This method expects that a call to method @ref initialize has already been performed.
+    auto canonicalizer() const -> const Canonicalizer&;
+
 private:
     struct Impl;
 
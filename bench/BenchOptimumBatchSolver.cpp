@@ -0,0 +1,114 @@
+// Optima is a C++ library for numerical sol of linear and nonlinear programing problems.
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <iostream>
+#include <vector>
+
+// Optima includes
+#include <Optima/Matrix.hpp>
+#include <Optima/OptimumBatchSolver.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumResult.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+#include <Optima/Timing.hpp>
+using namespace Optima;
+
+Index samples = 5;
+
+/// Return the time needed to solve the given optimization problems in parallel with a given scheduling strategy.
+double timeBatchSolver(const OptimumStructure& structure, const std::vector<OptimumParams>& params, Index numthreads, BatchScheduling scheduling)
+{
+    OptimumBatchSolver solver(structure, numthreads);
+    solver.setScheduling(scheduling);
+
+    std::vector<OptimumState> states;
+
+    // Solve once before timing so that threads and solvers are warmed up
+    solver.solve(params, states);
+
+    Time begin = timenow();
+
+    for(Index i = 0; i < samples; ++i)
+        solver.solve(params, states);
+
+    return elapsed(begin)/samples;
+}
+
+void benchSkewedWorkload()
+{
+    Index m = 10;
+    Index n = 60;
+    Index numproblems = 512;
+    Index numheavy = numproblems/8;
+    Index heavycost = 200;
+
+    Matrix A = random(m, n).cwiseAbs();
+    Matrix Q = random(n, n);
+
+    OptimumStructure structure(n, m);
+    structure.A = A;
+    structure.allVariablesHaveLowerBounds();
+
+    // Create the optimization problems, with the heavy ones clustered at the beginning of the batch
+    // so that a static partition of the problems assigns all of them to the first threads
+    std::vector<OptimumParams> params(numproblems);
+    for(Index k = 0; k < numproblems; ++k)
+    {
+        const Index cost = k < numheavy ? heavycost : 1;
+        params[k].xlower = zeros(n);
+        params[k].b = A * (ones(n) + 0.001 * k * linspace(n, 0, 1));
+        params[k].objective = [=](VectorConstRef x, ObjectiveResult& f)
+        {
+            // Emulate an objective function whose evaluation cost varies from problem to problem
+            Vector work = x;
+            for(Index i = 0; i < cost; ++i)
+                work = Q * work / work.norm();
+
+            Vector c = linspace(n, -1.0, 2.0) + 1e-30 * work;
+            f.value = 0.5*(x - c).squaredNorm() + 0.1*x.array().pow(3).sum();
+            f.gradient = (x - c).array() + 0.3*x.array().square();
+            f.hessian = VectorConstRef(Vector((1.0 + 0.6*x.array()).matrix()));
+        };
+    }
+
+    std::cout << std::endl;
+    std::cout << "=============================================================" << std::endl;
+    std::cout << "Optimum Batch Solver Analysis: Skewed Workload" << std::endl;
+    std::cout << "-------------------------------------------------------------" << std::endl;
+    std::cout << "Problems: " << numproblems << " (" << numheavy << " heavy, " << heavycost << "x cost)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Threads    Time(Static)    Time(WorkStealing)    Speedup" << std::endl;
+
+    for(Index numthreads : {1, 2, 4, 8})
+    {
+        const double timestatic = timeBatchSolver(structure, params, numthreads, BatchScheduling::Static);
+        const double timestealing = timeBatchSolver(structure, params, numthreads, BatchScheduling::WorkStealing);
+
+        std::cout << numthreads << "          "
+                  << timestatic << "       "
+                  << timestealing << "             "
+                  << timestatic/timestealing << std::endl;
+    }
+    std::cout << "=============================================================" << std::endl;
+}
+
+int main()
+{
+    benchSkewedWorkload();
+}
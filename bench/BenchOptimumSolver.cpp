@@ -0,0 +1,475 @@
+// Optima is a C++ library for numerical sol of linear and nonlinear programing problems.
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// C++ includes
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Optima includes
+#include <Optima/IndexUtils.hpp>
+#include <Optima/Matrix.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumResult.hpp>
+#include <Optima/OptimumSolver.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+using namespace Optima;
+
+Index samples = 20;
+
+/// The optimization problem of a benchmark case.
+struct BenchProblem
+{
+    OptimumStructure structure;
+    OptimumParams params;
+};
+
+/// Return random factors between 10^-k and 10^k, used to scale a problem badly.
+Vector badScales(Index size, double k)
+{
+    return (k * Vector(random(size))).unaryExpr([](double e) { return std::pow(10.0, e); });
+}
+
+/// Return a linear (or quadratic) programming problem with all variables in [0, 1], many of them at a bound at the solution.
+/// The variables, the equality constraints and the objective function are badly scaled with factors up to 10^k.
+BenchProblem boxProblem(Index n, Index m, bool quadratic, double k = 0.0)
+{
+    const Vector P = badScales(m, k);
+    const Vector Q = badScales(n, k);
+    const double s = std::pow(10.0, k);
+
+    Matrix A = random(m, n);
+    Vector h = quadratic ? Vector(abs(random(n)) + 0.1*ones(n)) : Vector(zeros(n));
+    Vector c = random(n);
+
+    OptimumStructure structure(n, m);
+    structure.A = P.asDiagonal() * A * Q.asDiagonal();
+    structure.allVariablesHaveLowerBounds();
+    structure.allVariablesHaveUpperBounds();
+
+    if(quadratic) structure.setConstantHessianDiagonal(s * Q.cwiseAbs2().cwiseProduct(h));
+    else structure.setConstantHessianZero();
+
+    OptimumParams params;
+    params.xlower = zeros(n);
+    params.xupper = Q.cwiseInverse();
+    params.b = P.asDiagonal() * A * Vector(constants(n, 0.5));
+    params.objective = [=](VectorConstRef xs, ObjectiveResult& f)
+    {
+        const Vector x = Q.cwiseProduct(xs);
+        f.value = s * (c.dot(x) + 0.5*x.dot(h.cwiseProduct(x)));
+        f.gradient = s * Q.cwiseProduct(c + h.cwiseProduct(x));
+    };
+
+    return {structure, params};
+}
+
+/// Return a Gibbs-energy-like problem with lower bounds, in which many variables are nearly zero at the solution.
+/// The variables, the equality constraints and the objective function are badly scaled with factors up to 10^k.
+BenchProblem gibbsProblem(Index n, Index m, double k = 0.0)
+{
+    const Vector P = badScales(m, k);
+    const Vector Q = badScales(n, k);
+    const double s = std::pow(10.0, k);
+
+    Matrix A = random(m, n).cwiseAbs();
+    Vector c = 20.0 * random(n);
+
+    OptimumStructure structure(n, m);
+    structure.A = P.asDiagonal() * A * Q.asDiagonal();
+    structure.allVariablesHaveLowerBounds();
+
+    OptimumParams params;
+    params.xlower = zeros(n);
+    params.b = P.asDiagonal() * A * Vector(ones(n));
+    params.objective = [=](VectorConstRef xs, ObjectiveResult& f)
+    {
+        const Vector x = Q.cwiseProduct(xs);
+        const double t = x.sum();
+        const Matrix H = Matrix((1.0/x.array()).matrix().asDiagonal()) - Matrix(constants(n, n, 1.0/t));
+        f.value = s * (x.array() * (c.array() + (x.array()/t).log())).sum();
+        f.gradient = s * Q.cwiseProduct(Vector((c.array() + (x.array()/t).log()).matrix()));
+        f.hessian = MatrixConstRef(Matrix(s * Q.asDiagonal() * H * Q.asDiagonal()));
+    };
+
+    return {structure, params};
+}
+
+/// Return a linear (or quadratic) programming problem with all variables in [0, 1] and m general equality constraints, extended
+/// with parts removed by the presolve: variables with equal lower and upper bounds, singleton constraints, and forcing
+/// constraints, whose zero right-hand side can only be attained with all their variables at zero.
+BenchProblem reducibleProblem(Index n, Index m, bool quadratic)
+{
+    // The numbers of singleton constraints, forcing constraints (each with three variables) and variables with equal bounds
+    const Index ns = n/10, nf = n/20, ne = n/10;
+    const Index mt = m + ns + nf;
+
+    // The values of the variables at which the general equality constraints are satisfied (zero for those in forcing constraints)
+    Vector xb = constants(n, 0.5);
+    xb.segment(ns, 3*nf).fill(0.0);
+
+    Matrix A = zeros(mt, n);
+    A.topRows(m) = random(m, n);
+    for(Index i = 0; i < ns; ++i)
+        A(m + i, i) = 1.0 + std::abs(random(1)[0]);
+    for(Index i = 0; i < nf; ++i)
+        A.row(m + ns + i).segment(ns + 3*i, 3) = random(3).cwiseAbs().transpose() + constants(3, 0.1).transpose();
+
+    Vector h = quadratic ? Vector(abs(random(n)) + 0.1*ones(n)) : Vector(zeros(n));
+    Vector c = random(n);
+
+    OptimumStructure structure(n, mt);
+    structure.A = A;
+    structure.allVariablesHaveLowerBounds();
+    structure.allVariablesHaveUpperBounds();
+
+    if(quadratic) structure.setConstantHessianDiagonal(h);
+    else structure.setConstantHessianZero();
+
+    OptimumParams params;
+    params.xlower = zeros(n);
+    params.xupper = ones(n);
+    params.xlower.segment(ns + 3*nf, ne).fill(0.5);
+    params.xupper.segment(ns + 3*nf, ne).fill(0.5);
+    params.b = A * xb;
+    params.objective = [=](VectorConstRef x, ObjectiveResult& f)
+    {
+        f.value = c.dot(x) + 0.5*x.dot(h.cwiseProduct(x));
+        f.gradient = c + h.cwiseProduct(x);
+    };
+
+    return {structure, params};
+}
+
+/// Return a problem with n variables and n - nn general equality constraints, in which only the last nn variables have bounds
+/// (in [0, 1]). The objective function is convex with a diagonal Hessian matrix that depends on the variables.
+BenchProblem fewBoundsProblem(Index n, Index nn)
+{
+    const Index m = n - nn;
+
+    Matrix A = random(m, n);
+    Vector h = abs(random(n)) + 0.1*ones(n);
+    Vector c = random(n);
+
+    OptimumStructure structure(n, m);
+    structure.A = A;
+    structure.setVariablesWithLowerBounds(indices(n).tail(nn));
+    structure.setVariablesWithUpperBounds(indices(n).tail(nn));
+
+    OptimumParams params;
+    params.xlower = zeros(nn);
+    params.xupper = ones(nn);
+    params.b = A * Vector(constants(n, 0.5));
+    params.objective = [=](VectorConstRef x, ObjectiveResult& f)
+    {
+        f.value = c.dot(x) + 0.5*x.dot(h.cwiseProduct(x)) + 0.25*x.array().pow(4).sum();
+        f.gradient = c + h.cwiseProduct(x) + Vector(x.array().cube());
+        f.hessian = VectorConstRef(Vector(h.array() + 3.0*x.array().square()));
+    };
+
+    return {structure, params};
+}
+
+/// Output the mean number of iterations and the number of successful calculations for each barrier strategy.
+void benchBarrierModes(std::string name, std::function<BenchProblem()> problem, bool predictor_corrector)
+{
+    const std::vector<BarrierMode> modes = {BarrierMode::Fixed, BarrierMode::Monotone, BarrierMode::LOQO};
+
+    std::vector<Index> iterations(modes.size()), succeeded(modes.size());
+
+    for(Index k = 0; k < samples; ++k)
+    {
+        BenchProblem p = problem();
+
+        for(Index j = 0; j < Index(modes.size()); ++j)
+        {
+            OptimumOptions options;
+            options.max_iterations = 500;
+            options.barrier.mode = modes[j];
+            options.predictor_corrector = predictor_corrector;
+
+            OptimumSolver solver(p.structure);
+            solver.setOptions(options);
+
+            // Start from the same initial guess for every barrier strategy
+            OptimumState state;
+            state.x = ones(p.structure.numVariables());
+
+            OptimumResult res = solver.solve(p.params, state);
+
+            iterations[j] += res.iterations;
+            succeeded[j] += res.succeeded;
+        }
+    }
+
+    std::cout << std::left << std::setw(28) << name;
+    for(Index j = 0; j < Index(modes.size()); ++j)
+        std::cout << std::setw(8) << double(iterations[j])/samples << "(" << succeeded[j] << "/" << samples << ")    ";
+    std::cout << std::endl;
+}
+
+/// Output the mean number of iterations and the number of successful calculations without and with scaling of the problem.
+void benchScaling(std::string name, std::function<BenchProblem()> problem, BarrierMode mode)
+{
+    std::vector<Index> iterations(2), succeeded(2);
+
+    for(Index k = 0; k < samples; ++k)
+    {
+        BenchProblem p = problem();
+
+        for(Index j = 0; j < 2; ++j)
+        {
+            OptimumOptions options;
+            options.max_iterations = 500;
+            options.barrier.mode = mode;
+            options.scaling.active = j == 1;
+
+            OptimumSolver solver(p.structure);
+            solver.setOptions(options);
+
+            OptimumState state;
+            OptimumResult res = solver.solve(p.params, state);
+
+            iterations[j] += res.iterations;
+            succeeded[j] += res.succeeded;
+        }
+    }
+
+    std::cout << std::left << std::setw(28) << name;
+    for(Index j = 0; j < 2; ++j)
+        std::cout << std::setw(8) << double(iterations[j])/samples << "(" << succeeded[j] << "/" << samples << ")    ";
+    std::cout << std::endl;
+}
+
+/// Output the mean number of iterations, the number of successful calculations and the mean wall time without and with presolve.
+void benchPresolve(std::string name, std::function<BenchProblem()> problem, BarrierMode mode)
+{
+    std::vector<Index> iterations(2), succeeded(2);
+    std::vector<double> time(2);
+
+    for(Index k = 0; k < samples; ++k)
+    {
+        BenchProblem p = problem();
+
+        for(Index j = 0; j < 2; ++j)
+        {
+            OptimumOptions options;
+            options.max_iterations = 500;
+            options.barrier.mode = mode;
+            options.presolve.active = j == 1;
+
+            OptimumSolver solver(p.structure);
+            solver.setOptions(options);
+
+            OptimumState state;
+            OptimumResult res = solver.solve(p.params, state);
+
+            iterations[j] += res.iterations;
+            succeeded[j] += res.succeeded;
+            time[j] += res.time;
+        }
+    }
+
+    std::cout << std::left << std::setw(28) << name;
+    for(Index j = 0; j < 2; ++j)
+        std::cout << std::setw(8) << double(iterations[j])/samples << "(" << succeeded[j] << "/" << samples << ") "
+                  << std::setw(10) << time[j]/samples << "   ";
+    std::cout << std::endl;
+}
+
+/// Output the mean number of iterations, the number of successful calculations and the mean wall time in the full and in the reduced space.
+void benchReducedSpace(std::string name, std::function<BenchProblem()> problem, BarrierMode mode)
+{
+    std::vector<Index> iterations(2), succeeded(2);
+    std::vector<double> time(2);
+
+    for(Index k = 0; k < samples; ++k)
+    {
+        BenchProblem p = problem();
+
+        for(Index j = 0; j < 2; ++j)
+        {
+            OptimumOptions options;
+            options.max_iterations = 500;
+            options.barrier.mode = mode;
+            options.reduced_space = j == 1;
+
+            // The line search safeguards the Newton steps against the quartic terms of the objective function in both spaces
+            options.linesearch.active = true;
+
+            OptimumSolver solver(p.structure);
+            solver.setOptions(options);
+
+            OptimumState state;
+            OptimumResult res = solver.solve(p.params, state);
+
+            iterations[j] += res.iterations;
+            succeeded[j] += res.succeeded;
+            time[j] += res.time;
+        }
+    }
+
+    std::cout << std::left << std::setw(28) << name;
+    for(Index j = 0; j < 2; ++j)
+        std::cout << std::setw(8) << double(iterations[j])/samples << "(" << succeeded[j] << "/" << samples << ") "
+                  << std::setw(10) << time[j]/samples << "   ";
+    std::cout << std::endl;
+}
+
+/// Output the mean number of iterations, the number of successful calculations and the mean wall time without and with variables fixed at their bounds.
+/// Fixing the variables reduces the iterations of the linear problems, but on the Gibbs problems it increases the mean
+/// iterations and, depending on the samples, may also change the number of successful calculations (in both directions).
+void benchActiveSet(std::string name, std::function<BenchProblem()> problem, BarrierMode mode)
+{
+    std::vector<Index> iterations(2), succeeded(2);
+    std::vector<double> time(2);
+
+    for(Index k = 0; k < samples; ++k)
+    {
+        BenchProblem p = problem();
+
+        for(Index j = 0; j < 2; ++j)
+        {
+            OptimumOptions options;
+            options.max_iterations = 500;
+            options.barrier.mode = mode;
+            options.activeset.active = j == 1;
+
+            OptimumSolver solver(p.structure);
+            solver.setOptions(options);
+
+            OptimumState state;
+            OptimumResult res = solver.solve(p.params, state);
+
+            iterations[j] += res.iterations;
+            succeeded[j] += res.succeeded;
+            time[j] += res.time;
+        }
+    }
+
+    std::cout << std::left << std::setw(28) << name;
+    for(Index j = 0; j < 2; ++j)
+        std::cout << std::setw(8) << double(iterations[j])/samples << "(" << succeeded[j] << "/" << samples << ") "
+                  << std::setw(10) << time[j]/samples << "   ";
+    std::cout << std::endl;
+}
+
+int main()
+{
+    std::cout << std::endl;
+    std::cout << "==========================================================================================" << std::endl;
+    std::cout << "Optimum Solver Analysis: Barrier Strategies (mean iterations and successful calculations)" << std::endl;
+    std::cout << "------------------------------------------------------------------------------------------" << std::endl;
+    std::cout << std::left << std::setw(28) << "Problem" << std::setw(22) << "Fixed" << std::setw(22) << "Monotone" << "LOQO" << std::endl;
+
+    for(bool pc : {false, true})
+    {
+        const std::string suffix = pc ? " (PC)" : "";
+
+        for(Index n : {20, 60, 200})
+        {
+            benchBarrierModes("LP n=" + std::to_string(n) + suffix, [=]() { return boxProblem(n, n/4, false); }, pc);
+            benchBarrierModes("QP n=" + std::to_string(n) + suffix, [=]() { return boxProblem(n, n/4, true); }, pc);
+            benchBarrierModes("Gibbs n=" + std::to_string(n) + suffix, [=]() { return gibbsProblem(n, n/4); }, pc);
+        }
+    }
+
+    std::cout << "==========================================================================================" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "==========================================================================================" << std::endl;
+    std::cout << "Optimum Solver Analysis: Scaling (mean iterations and successful calculations)" << std::endl;
+    std::cout << "------------------------------------------------------------------------------------------" << std::endl;
+    std::cout << std::left << std::setw(28) << "Problem" << std::setw(22) << "Unscaled" << "Scaled" << std::endl;
+
+    for(BarrierMode mode : {BarrierMode::Fixed, BarrierMode::LOQO})
+    {
+        const std::string suffix = mode == BarrierMode::Fixed ? " (Fixed)" : " (LOQO)";
+
+        for(double k : {0.0, 2.0, 4.0})
+        {
+            const std::string scales = " 1e" + std::to_string(int(k));
+
+            benchScaling("LP" + scales + suffix, [=]() { return boxProblem(40, 10, false, k); }, mode);
+            benchScaling("QP" + scales + suffix, [=]() { return boxProblem(40, 10, true, k); }, mode);
+            benchScaling("Gibbs" + scales + suffix, [=]() { return gibbsProblem(40, 10, k); }, mode);
+        }
+    }
+
+    std::cout << "==========================================================================================" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "==========================================================================================" << std::endl;
+    std::cout << "Optimum Solver Analysis: Presolve (mean iterations, successful calculations and wall time)" << std::endl;
+    std::cout << "------------------------------------------------------------------------------------------" << std::endl;
+    std::cout << std::left << std::setw(28) << "Problem" << std::setw(32) << "Plain" << "Presolved" << std::endl;
+
+    for(BarrierMode mode : {BarrierMode::Fixed, BarrierMode::LOQO})
+    {
+        const std::string suffix = mode == BarrierMode::Fixed ? " (Fixed)" : " (LOQO)";
+
+        for(Index n : {40, 200})
+        {
+            benchPresolve("LP n=" + std::to_string(n) + suffix, [=]() { return reducibleProblem(n, n/4, false); }, mode);
+            benchPresolve("QP n=" + std::to_string(n) + suffix, [=]() { return reducibleProblem(n, n/4, true); }, mode);
+        }
+    }
+
+    std::cout << "==========================================================================================" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "==========================================================================================" << std::endl;
+    std::cout << "Optimum Solver Analysis: Reduced Space (mean iterations, successful calculations and wall time)" << std::endl;
+    std::cout << "------------------------------------------------------------------------------------------" << std::endl;
+    std::cout << std::left << std::setw(28) << "Problem" << std::setw(32) << "Full space" << "Reduced space" << std::endl;
+
+    for(BarrierMode mode : {BarrierMode::Fixed, BarrierMode::LOQO})
+    {
+        const std::string suffix = mode == BarrierMode::Fixed ? " (Fixed)" : " (LOQO)";
+
+        for(Index n : {40, 200})
+            for(Index nn : {n/10, n/4})
+                benchReducedSpace("n=" + std::to_string(n) + " nn=" + std::to_string(nn) + suffix, [=]() { return fewBoundsProblem(n, nn); }, mode);
+    }
+
+    std::cout << "==========================================================================================" << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "==========================================================================================" << std::endl;
+    std::cout << "Optimum Solver Analysis: Active Set (mean iterations, successful calculations and wall time)" << std::endl;
+    std::cout << "------------------------------------------------------------------------------------------" << std::endl;
+    std::cout << std::left << std::setw(28) << "Problem" << std::setw(32) << "Plain" << "Active set" << std::endl;
+
+    for(BarrierMode mode : {BarrierMode::Fixed, BarrierMode::LOQO})
+    {
+        const std::string suffix = mode == BarrierMode::Fixed ? " (Fixed)" : " (LOQO)";
+
+        for(Index n : {60, 200})
+        {
+            benchActiveSet("LP n=" + std::to_string(n) + suffix, [=]() { return boxProblem(n, n/4, false); }, mode);
+            benchActiveSet("QP n=" + std::to_string(n) + suffix, [=]() { return boxProblem(n, n/4, true); }, mode);
+            benchActiveSet("Gibbs n=" + std::to_string(n) + suffix, [=]() { return gibbsProblem(n, n/4); }, mode);
+        }
+    }
+
+    std::cout << "==========================================================================================" << std::endl;
+}
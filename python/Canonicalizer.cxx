@@ -37,12 +37,18 @@ void exportCanonicalizer(py::module& m)
         .def("R", &Canonicalizer::R, py::return_value_policy::reference_internal)
         .def("Q", &Canonicalizer::Q, py::return_value_policy::reference_internal)
         .def("C", &Canonicalizer::C)
+        .def("exact", &Canonicalizer::exact)
+        .def("denominator", &Canonicalizer::denominator)
+        .def("numeratorsS", &Canonicalizer::numeratorsS, py::return_value_policy::reference_internal)
+        .def("numeratorsR", &Canonicalizer::numeratorsR, py::return_value_policy::reference_internal)
         .def("indicesLinearlyIndependentEquations", &Canonicalizer::indicesLinearlyIndependentEquations)
         .def("indicesBasicVariables", &Canonicalizer::indicesBasicVariables, py::return_value_policy::reference_internal)
         .def("indicesNonBasicVariables", &Canonicalizer::indicesNonBasicVariables, py::return_value_policy::reference_internal)
         .def("compute", &Canonicalizer::compute)
+        .def("computeExact", &Canonicalizer::computeExact)
         .def("updateWithSwapBasicVariable", &Canonicalizer::updateWithSwapBasicVariable)
         .def("updateWithPriorityWeights", &Canonicalizer::updateWithPriorityWeights)
+        .def("updateOrderingWithPriorityWeights", &Canonicalizer::updateOrderingWithPriorityWeights)
         .def("rationalize", &Canonicalizer::rationalize)
         ;
 }
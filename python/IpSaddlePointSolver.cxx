@@ -29,12 +29,20 @@ using namespace Optima;
 
 void exportIpSaddlePointSolver(py::module& m)
 {
+    const auto solve1 = static_cast<Result(IpSaddlePointSolver::*)(IpSaddlePointVector, IpSaddlePointSolution)>(&IpSaddlePointSolver::solve);
+    const auto solve2 = static_cast<Result(IpSaddlePointSolver::*)(MatrixConstRef, MatrixRef)>(&IpSaddlePointSolver::solve);
+
     py::class_<IpSaddlePointSolver>(m, "IpSaddlePointSolver")
         .def(py::init<>())
         .def("setOptions", &IpSaddlePointSolver::setOptions)
         .def("options", &IpSaddlePointSolver::options)
+        .def("setConstantHessian", &IpSaddlePointSolver::setConstantHessian)
         .def("initialize", &IpSaddlePointSolver::initialize)
         .def("decompose", &IpSaddlePointSolver::decompose)
-        .def("solve", &IpSaddlePointSolver::solve)
+        .def("solve", solve1)
+        .def("solve", solve2)
+        .def("changedVariables", &IpSaddlePointSolver::changedVariables)
+        .def("variablesAtLowerBounds", &IpSaddlePointSolver::variablesAtLowerBounds)
+        .def("variablesAtUpperBounds", &IpSaddlePointSolver::variablesAtUpperBounds)
         ;
 }
@@ -19,6 +19,7 @@
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 namespace py = pybind11;
 
 // Optima includes
@@ -51,4 +52,22 @@ void exportObjective(py::module& m)
         .def_readwrite("requires", &ObjectiveResult::requires, "The requirements in the evaluation of the objective function.")
         .def_readwrite("failed", &ObjectiveResult::failed, "The boolean flag that indicates if the objective function evaluation failed.")
         ;
+
+    const auto getHs = [](const ObjectiveBatchResult& self)
+    {
+        return self.hessians;
+    };
+
+    const auto setHs = [](ObjectiveBatchResult& self, const std::vector<VariantMatrixConstRef>& others)
+    {
+        self.hessians.assign(others.begin(), others.end());
+    };
+
+    py::class_<ObjectiveBatchResult>(m, "ObjectiveBatchResult")
+        .def(py::init<>())
+        .def_readwrite("values", &ObjectiveBatchResult::values, "The evaluated values of the objective function, one for each point.")
+        .def_readwrite("gradients", &ObjectiveBatchResult::gradients, "The evaluated gradients of the objective function, one in each column for each point.")
+        .def_property("hessians", getHs, setHs, "The evaluated Hessians of the objective function, one for each point.")
+        .def_readwrite("requires", &ObjectiveBatchResult::requires, "The requirements in the evaluation of the objective function, which are the same for all points.")
+        ;
 }
@@ -22,18 +22,27 @@ namespace py = pybind11;
 void exportEigen(py::module& m);
 void exportCanonicalizer(py::module& m);
 void exportIndexUtils(py::module& m);
+void exportKdTree(py::module& m);
 void exportOutputter(py::module& m);
 void exportPartition(py::module& m);
 void exportResult(py::module& m);
 void exportObjective(py::module& m);
+void exportOptimumBatchSolver(py::module& m);
 void exportOptimumOptions(py::module& m);
 void exportOptimumParams(py::module& m);
+void exportOptimumPresolver(py::module& m);
+void exportOptimumPresolvedSolver(py::module& m);
 void exportOptimumProblem(py::module& m);
+void exportOptimumReducer(py::module& m);
+void exportOptimumReducedSolver(py::module& m);
 void exportOptimumResult(py::module& m);
+void exportOptimumScaling(py::module& m);
+void exportOptimumSensitivity(py::module& m);
 void exportOptimumSolver(py::module& m);
 void exportOptimumState(py::module& m);
 void exportOptimumStepper(py::module& m);
 void exportOptimumStructure(py::module& m);
+void exportQuasiNewtonHessian(py::module& m);
 void exportSaddlePointMatrix(py::module& m);
 void exportSaddlePointOptions(py::module& m);
 void exportSaddlePointSolver(py::module& m);
@@ -48,6 +57,7 @@ PYBIND11_MODULE(optima, m)
     exportEigen(m);
     exportCanonicalizer(m);
     exportIndexUtils(m);
+    exportKdTree(m);
     exportOutputter(m);
     exportPartition(m);
     exportResult(m);
@@ -56,10 +66,18 @@ PYBIND11_MODULE(optima, m)
     exportOptimumParams(m);
     exportOptimumProblem(m);
     exportOptimumResult(m);
+    exportOptimumSensitivity(m);
     exportOptimumState(m);
     exportOptimumStepper(m);
     exportOptimumStructure(m);
+    exportOptimumPresolver(m);
+    exportOptimumReducer(m);
+    exportOptimumScaling(m);
     exportOptimumSolver(m);
+    exportOptimumPresolvedSolver(m);
+    exportOptimumReducedSolver(m);
+    exportOptimumBatchSolver(m);
+    exportQuasiNewtonHessian(m);
     exportSaddlePointMatrix(m);
     exportSaddlePointOptions(m);
     exportSaddlePointSolver(m);
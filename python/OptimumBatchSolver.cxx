@@ -0,0 +1,93 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <pybind11/eigen.h>
+#include <pybind11/functional.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+namespace py = pybind11;
+
+// Optima includes
+#include <Optima/Objective.hpp>
+#include <Optima/OptimumBatchSolver.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumResult.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+using namespace Optima;
+
+void exportOptimumBatchSolver(py::module& m)
+{
+    // This is a workaround to let the given list of OptimumState objects be changed, and not copies of them
+    auto solve = [](OptimumBatchSolver& self, const std::vector<OptimumParams>& params, py::list statelist)
+    {
+        std::vector<OptimumState> states;
+        for(auto item : statelist)
+            states.push_back(item.cast<OptimumState>());
+
+        std::vector<OptimumResult> results;
+        {
+            // Release the GIL so that Python objective functions can be evaluated from the threads in the pool
+            py::gil_scoped_release release;
+            results = self.solve(params, states);
+        }
+
+        for(std::size_t i = 0; i < states.size(); ++i)
+            statelist[i].cast<OptimumState&>() = states[i];
+
+        return results;
+    };
+
+    // The same workaround as above, for the solution of the optimization problems in lockstep with a batch objective function
+    auto solvelockstep = [](OptimumBatchSolver& self, const std::vector<OptimumParams>& params, const ObjectiveBatchFunction& objective, py::list statelist)
+    {
+        std::vector<OptimumState> states;
+        for(auto item : statelist)
+            states.push_back(item.cast<OptimumState>());
+
+        std::vector<OptimumResult> results;
+        {
+            // Release the GIL so that the threads in the pool can run while the objective function is not being evaluated
+            py::gil_scoped_release release;
+            results = self.solve(params, objective, states);
+        }
+
+        for(std::size_t i = 0; i < states.size(); ++i)
+            statelist[i].cast<OptimumState&>() = states[i];
+
+        return results;
+    };
+
+    py::enum_<BatchScheduling>(m, "BatchScheduling")
+        .value("Static", BatchScheduling::Static)
+        .value("WorkStealing", BatchScheduling::WorkStealing)
+        ;
+
+    py::class_<OptimumBatchSolver>(m, "OptimumBatchSolver")
+        .def(py::init<const OptimumStructure&, Index>(), py::arg("structure"), py::arg("numthreads") = 0)
+        .def("setOptions", &OptimumBatchSolver::setOptions)
+        .def("setScheduling", &OptimumBatchSolver::setScheduling)
+        .def("scheduling", &OptimumBatchSolver::scheduling)
+        .def("setMaxLockstepProblems", &OptimumBatchSolver::setMaxLockstepProblems)
+        .def("maxLockstepProblems", &OptimumBatchSolver::maxLockstepProblems)
+        .def("numThreads", &OptimumBatchSolver::numThreads)
+        .def("solve", solve)
+        .def("solve", solvelockstep)
+        ;
+}
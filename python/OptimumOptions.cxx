@@ -17,6 +17,7 @@
 
 // pybind11 includes
 #include <pybind11/pybind11.h>
+#include <pybind11/functional.h>
 #include <pybind11/stl.h>
 namespace py = pybind11;
 
@@ -31,6 +32,19 @@ void exportOptimumOptions(py::module& m)
         .value("Aggressive", StepMode::Aggressive)
         ;
 
+    py::enum_<HessianMode>(m, "HessianMode")
+        .value("Exact", HessianMode::Exact)
+        .value("BFGS", HessianMode::BFGS)
+        .value("LBFGS", HessianMode::LBFGS)
+        .value("DiagonalSecant", HessianMode::DiagonalSecant)
+        ;
+
+    py::enum_<BarrierMode>(m, "BarrierMode")
+        .value("Fixed", BarrierMode::Fixed)
+        .value("Monotone", BarrierMode::Monotone)
+        .value("LOQO", BarrierMode::LOQO)
+        ;
+
     py::class_<OptimumOutputOptions, OutputterOptions>(m, "OptimumOutputOptions")
         .def(py::init<>())
         .def_readwrite("xprefix", &OptimumOutputOptions::xprefix)
@@ -40,6 +54,72 @@ void exportOptimumOptions(py::module& m)
         .def_readwrite("ynames", &OptimumOutputOptions::ynames)
         ;
 
+    py::class_<OptimumPredictionOptions>(m, "OptimumPredictionOptions")
+        .def(py::init<>())
+        .def_readwrite("active", &OptimumPredictionOptions::active)
+        .def_readwrite("tolerance", &OptimumPredictionOptions::tolerance)
+        .def_readwrite("max_records", &OptimumPredictionOptions::max_records)
+        ;
+
+    py::class_<OptimumLineSearchOptions>(m, "OptimumLineSearchOptions")
+        .def(py::init<>())
+        .def_readwrite("active", &OptimumLineSearchOptions::active)
+        .def_readwrite("armijo", &OptimumLineSearchOptions::armijo)
+        .def_readwrite("backtrack", &OptimumLineSearchOptions::backtrack)
+        .def_readwrite("max_backtracks", &OptimumLineSearchOptions::max_backtracks)
+        ;
+
+    py::class_<OptimumHessianOptions>(m, "OptimumHessianOptions")
+        .def(py::init<>())
+        .def_readwrite("mode", &OptimumHessianOptions::mode)
+        .def_readwrite("memory", &OptimumHessianOptions::memory)
+        .def_readwrite("damping", &OptimumHessianOptions::damping)
+        ;
+
+    py::class_<OptimumBarrierOptions>(m, "OptimumBarrierOptions")
+        .def(py::init<>())
+        .def_readwrite("mode", &OptimumBarrierOptions::mode)
+        .def_readwrite("initial", &OptimumBarrierOptions::initial)
+        .def_readwrite("kappa", &OptimumBarrierOptions::kappa)
+        .def_readwrite("theta", &OptimumBarrierOptions::theta)
+        .def_readwrite("kappa_epsilon", &OptimumBarrierOptions::kappa_epsilon)
+        ;
+
+    py::class_<OptimumReuseOptions>(m, "OptimumReuseOptions")
+        .def(py::init<>())
+        .def_readwrite("period", &OptimumReuseOptions::period)
+        .def_readwrite("contraction", &OptimumReuseOptions::contraction)
+        ;
+
+    py::class_<OptimumTerminationOptions>(m, "OptimumTerminationOptions")
+        .def(py::init<>())
+        .def_readwrite("stagnation_iterations", &OptimumTerminationOptions::stagnation_iterations)
+        .def_readwrite("stagnation_decrease", &OptimumTerminationOptions::stagnation_decrease)
+        .def_readwrite("stagnation_objective", &OptimumTerminationOptions::stagnation_objective)
+        .def_readwrite("divergence_ratio", &OptimumTerminationOptions::divergence_ratio)
+        .def_readwrite("infeasibility_iterations", &OptimumTerminationOptions::infeasibility_iterations)
+        .def_readwrite("infeasibility_multiplier", &OptimumTerminationOptions::infeasibility_multiplier)
+        ;
+
+    py::class_<OptimumScalingOptions>(m, "OptimumScalingOptions")
+        .def(py::init<>())
+        .def_readwrite("active", &OptimumScalingOptions::active)
+        .def_readwrite("passes", &OptimumScalingOptions::passes)
+        .def_readwrite("max_gradient", &OptimumScalingOptions::max_gradient)
+        ;
+
+    py::class_<OptimumPresolveOptions>(m, "OptimumPresolveOptions")
+        .def(py::init<>())
+        .def_readwrite("active", &OptimumPresolveOptions::active)
+        .def_readwrite("tolerance", &OptimumPresolveOptions::tolerance)
+        ;
+
+    py::class_<OptimumActiveSetOptions>(m, "OptimumActiveSetOptions")
+        .def(py::init<>())
+        .def_readwrite("active", &OptimumActiveSetOptions::active)
+        .def_readwrite("iterations", &OptimumActiveSetOptions::iterations)
+        ;
+
     py::class_<OptimumOptions>(m, "OptimumOptions")
         .def(py::init<>())
         .def_readwrite("output", &OptimumOptions::output)
@@ -47,9 +127,23 @@ void exportOptimumOptions(py::module& m)
         .def_readwrite("tolerancex", &OptimumOptions::tolerancex)
         .def_readwrite("tolerancef", &OptimumOptions::tolerancef)
         .def_readwrite("max_iterations", &OptimumOptions::max_iterations)
+        .def_readwrite("max_time", &OptimumOptions::max_time)
+        .def_readwrite("cancellation", &OptimumOptions::cancellation)
         .def_readwrite("mu", &OptimumOptions::mu)
+        .def_readwrite("barrier", &OptimumOptions::barrier)
         .def_readwrite("tau", &OptimumOptions::tau)
         .def_readwrite("step", &OptimumOptions::step)
+        .def_readwrite("predictor_corrector", &OptimumOptions::predictor_corrector)
+        .def_readwrite("warmstart", &OptimumOptions::warmstart)
         .def_readwrite("kkt", &OptimumOptions::kkt)
+        .def_readwrite("prediction", &OptimumOptions::prediction)
+        .def_readwrite("linesearch", &OptimumOptions::linesearch)
+        .def_readwrite("hessian", &OptimumOptions::hessian)
+        .def_readwrite("reuse", &OptimumOptions::reuse)
+        .def_readwrite("termination", &OptimumOptions::termination)
+        .def_readwrite("scaling", &OptimumOptions::scaling)
+        .def_readwrite("presolve", &OptimumOptions::presolve)
+        .def_readwrite("reduced_space", &OptimumOptions::reduced_space)
+        .def_readwrite("activeset", &OptimumOptions::activeset)
         ;
 }
@@ -0,0 +1,48 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+// pybind11 includes
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+namespace py = pybind11;
+
+// Optima includes
+#include <Optima/Objective.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumPresolvedSolver.hpp>
+#include <Optima/OptimumResult.hpp>
+#include <Optima/OptimumSensitivity.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+using namespace Optima;
+
+void exportOptimumPresolvedSolver(py::module& m)
+{
+    const auto step1 = static_cast<bool(OptimumPresolvedSolver::*)()>(&OptimumPresolvedSolver::step);
+    const auto step2 = static_cast<bool(OptimumPresolvedSolver::*)(const ObjectiveResult&)>(&OptimumPresolvedSolver::step);
+
+    py::class_<OptimumPresolvedSolver>(m, "OptimumPresolvedSolver")
+        .def(py::init<const OptimumStructure&>())
+        .def("setOptions", &OptimumPresolvedSolver::setOptions)
+        .def("begin", &OptimumPresolvedSolver::begin, py::keep_alive<1, 2>(), py::keep_alive<1, 3>())
+        .def("step", step1)
+        .def("step", step2)
+        .def("converged", &OptimumPresolvedSolver::converged)
+        .def("finish", &OptimumPresolvedSolver::finish)
+        .def("sensitivities", &OptimumPresolvedSolver::sensitivities)
+        ;
+}
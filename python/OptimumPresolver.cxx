@@ -0,0 +1,57 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+namespace py = pybind11;
+
+// Optima includes
+#include <Optima/Objective.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumPresolver.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+using namespace Optima;
+
+void exportOptimumPresolver(py::module& m)
+{
+    const auto presolve1 = static_cast<bool(OptimumPresolver::*)(const OptimumParams&)>(&OptimumPresolver::presolve);
+    const auto presolve2 = static_cast<void(OptimumPresolver::*)(const OptimumState&, OptimumState&) const>(&OptimumPresolver::presolve);
+    const auto presolve3 = static_cast<void(OptimumPresolver::*)(const ObjectiveResult&, ObjectiveResult&) const>(&OptimumPresolver::presolve);
+    const auto postsolve1 = static_cast<void(OptimumPresolver::*)(VectorConstRef, VectorRef) const>(&OptimumPresolver::postsolve);
+    const auto postsolve2 = static_cast<void(OptimumPresolver::*)(const OptimumState&, OptimumState&) const>(&OptimumPresolver::postsolve);
+    const auto postsolve3 = static_cast<void(OptimumPresolver::*)(const OptimumState&, VectorConstRef, OptimumState&) const>(&OptimumPresolver::postsolve);
+
+    py::class_<OptimumPresolver>(m, "OptimumPresolver")
+        .def(py::init<const OptimumStructure&>())
+        .def("setOptions", &OptimumPresolver::setOptions)
+        .def("presolve", presolve1)
+        .def("presolve", presolve2)
+        .def("presolve", presolve3)
+        .def("structure", &OptimumPresolver::structure, py::return_value_policy::reference_internal)
+        .def("params", &OptimumPresolver::params, py::return_value_policy::reference_internal)
+        .def("variables", &OptimumPresolver::variables, py::return_value_policy::reference_internal)
+        .def("constraints", &OptimumPresolver::constraints, py::return_value_policy::reference_internal)
+        .def("dependentVariables", &OptimumPresolver::dependentVariables, py::return_value_policy::reference_internal)
+        .def("postsolve", postsolve1)
+        .def("postsolve", postsolve2)
+        .def("postsolve", postsolve3)
+        .def("derivatives", &OptimumPresolver::derivatives)
+        ;
+}
@@ -0,0 +1,57 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+namespace py = pybind11;
+
+// Optima includes
+#include <Optima/Objective.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumReducer.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+using namespace Optima;
+
+void exportOptimumReducer(py::module& m)
+{
+    const auto reduce1 = static_cast<bool(OptimumReducer::*)(const OptimumParams&)>(&OptimumReducer::reduce);
+    const auto reduce2 = static_cast<void(OptimumReducer::*)(const OptimumState&, OptimumState&) const>(&OptimumReducer::reduce);
+    const auto reduce3 = static_cast<void(OptimumReducer::*)(const ObjectiveResult&, ObjectiveResult&) const>(&OptimumReducer::reduce);
+    const auto recover1 = static_cast<void(OptimumReducer::*)(VectorConstRef, VectorRef) const>(&OptimumReducer::recover);
+    const auto recover2 = static_cast<void(OptimumReducer::*)(const OptimumState&, VectorConstRef, OptimumState&) const>(&OptimumReducer::recover);
+
+    py::class_<OptimumReducer>(m, "OptimumReducer")
+        .def(py::init<const OptimumStructure&>())
+        .def("setOptions", &OptimumReducer::setOptions)
+        .def("reducible", &OptimumReducer::reducible)
+        .def("reduce", reduce1)
+        .def("reduce", reduce2)
+        .def("reduce", reduce3)
+        .def("structure", &OptimumReducer::structure, py::return_value_policy::reference_internal)
+        .def("params", &OptimumReducer::params, py::return_value_policy::reference_internal)
+        .def("basicVariables", &OptimumReducer::basicVariables, py::return_value_policy::reference_internal)
+        .def("nonBasicVariables", &OptimumReducer::nonBasicVariables, py::return_value_policy::reference_internal)
+        .def("reducedGradient", &OptimumReducer::reducedGradient)
+        .def("recover", recover1)
+        .def("recover", recover2)
+        .def("derivatives", &OptimumReducer::derivatives)
+        .def("multipliers", &OptimumReducer::multipliers)
+        ;
+}
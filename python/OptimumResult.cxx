@@ -26,11 +26,28 @@ using namespace Optima;
 
 void exportOptimumResult(py::module& m)
 {
+    py::enum_<OptimumStatus>(m, "OptimumStatus")
+        .value("Unfinished", OptimumStatus::Unfinished)
+        .value("Converged", OptimumStatus::Converged)
+        .value("SmallStep", OptimumStatus::SmallStep)
+        .value("SmallObjectiveChange", OptimumStatus::SmallObjectiveChange)
+        .value("Stagnated", OptimumStatus::Stagnated)
+        .value("Diverged", OptimumStatus::Diverged)
+        .value("Infeasible", OptimumStatus::Infeasible)
+        .value("MaxIterations", OptimumStatus::MaxIterations)
+        .value("TimeLimit", OptimumStatus::TimeLimit)
+        .value("Cancelled", OptimumStatus::Cancelled)
+        ;
+
     py::class_<OptimumResult>(m, "OptimumResult")
         .def(py::init<>())
         .def_readwrite("succeeded", &OptimumResult::succeeded)
+        .def_readwrite("status", &OptimumResult::status)
         .def_readwrite("iterations", &OptimumResult::iterations)
         .def_readwrite("num_objective_evals", &OptimumResult::num_objective_evals)
+        .def_readwrite("num_hessian_evals", &OptimumResult::num_hessian_evals)
+        .def_readwrite("num_factorizations", &OptimumResult::num_factorizations)
+        .def_readwrite("num_factorizations_saved", &OptimumResult::num_factorizations_saved)
         .def_readwrite("convergence_rate", &OptimumResult::convergence_rate)
         .def_readwrite("error", &OptimumResult::error)
         .def_readwrite("error_optimality", &OptimumResult::error_optimality)
@@ -41,6 +58,12 @@ void exportOptimumResult(py::module& m)
         .def_readwrite("time_objective_evals", &OptimumResult::time_objective_evals)
         .def_readwrite("time_constraint_evals", &OptimumResult::time_constraint_evals)
         .def_readwrite("time_linear_systems", &OptimumResult::time_linear_systems)
+        .def_readwrite("predicted", &OptimumResult::predicted)
+        .def_readwrite("num_prediction_attempts", &OptimumResult::num_prediction_attempts)
+        .def_readwrite("num_prediction_hits", &OptimumResult::num_prediction_hits)
+        .def_readwrite("time_predictions", &OptimumResult::time_predictions)
+        .def_readwrite("time_saved_by_predictions", &OptimumResult::time_saved_by_predictions)
+        .def("predictionHitRate", &OptimumResult::predictionHitRate)
         .def(py::self += py::self)
         ;
 }
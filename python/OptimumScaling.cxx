@@ -0,0 +1,62 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2014-2018 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+#include <pybind11/functional.h>
+namespace py = pybind11;
+
+// Optima includes
+#include <Optima/Objective.hpp>
+#include <Optima/OptimumOptions.hpp>
+#include <Optima/OptimumParams.hpp>
+#include <Optima/OptimumScaling.hpp>
+#include <Optima/OptimumSensitivity.hpp>
+#include <Optima/OptimumState.hpp>
+#include <Optima/OptimumStructure.hpp>
+using namespace Optima;
+
+void exportOptimumScaling(py::module& m)
+{
+    const auto scale1 = static_cast<void(OptimumScaling::*)(const OptimumStructure&, const OptimumParams&, OptimumParams&) const>(&OptimumScaling::scale);
+    const auto scale2 = static_cast<void(OptimumScaling::*)(const OptimumState&, OptimumState&) const>(&OptimumScaling::scale);
+    const auto scale3 = static_cast<void(OptimumScaling::*)(const ObjectiveResult&, ObjectiveResult&) const>(&OptimumScaling::scale);
+    const auto unscale1 = static_cast<void(OptimumScaling::*)(const OptimumState&, OptimumState&) const>(&OptimumScaling::unscale);
+    const auto unscale2 = static_cast<void(OptimumScaling::*)(OptimumSensitivity&) const>(&OptimumScaling::unscale);
+
+    py::class_<OptimumScaling>(m, "OptimumScaling")
+        .def(py::init<>())
+        .def("initialize", &OptimumScaling::initialize)
+        .def("determine", &OptimumScaling::determine)
+        .def("fixObjectiveScaling", &OptimumScaling::fixObjectiveScaling)
+        .def("active", &OptimumScaling::active)
+        .def("undetermined", &OptimumScaling::undetermined)
+        .def("colScaling", &OptimumScaling::colScaling, py::return_value_policy::reference_internal)
+        .def("rowScaling", &OptimumScaling::rowScaling, py::return_value_policy::reference_internal)
+        .def("objectiveScaling", &OptimumScaling::objectiveScaling)
+        .def("scaled", &OptimumScaling::scaled)
+        .def("scale", scale1)
+        .def("scale", scale2)
+        .def("scale", scale3)
+        .def("unscale", unscale1)
+        .def("unscale", unscale2)
+        .def("evaluate", &OptimumScaling::evaluate)
+        .def("scaledGradientDerivatives", &OptimumScaling::scaledGradientDerivatives)
+        .def("scaledVectorDerivatives", &OptimumScaling::scaledVectorDerivatives)
+        ;
+}
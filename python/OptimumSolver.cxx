@@ -21,9 +21,11 @@
 namespace py = pybind11;
 
 // Optima includes
+#include <Optima/Objective.hpp>
 #include <Optima/OptimumOptions.hpp>
 #include <Optima/OptimumParams.hpp>
 #include <Optima/OptimumResult.hpp>
+#include <Optima/OptimumSensitivity.hpp>
 #include <Optima/OptimumSolver.hpp>
 #include <Optima/OptimumState.hpp>
 #include <Optima/OptimumStructure.hpp>
@@ -31,10 +33,20 @@ using namespace Optima;
 
 void exportOptimumSolver(py::module& m)
 {
+    const auto step1 = static_cast<bool(OptimumSolver::*)()>(&OptimumSolver::step);
+    const auto step2 = static_cast<bool(OptimumSolver::*)(const ObjectiveResult&)>(&OptimumSolver::step);
+
     py::class_<OptimumSolver>(m, "OptimumSolver")
         .def(py::init<const OptimumStructure&>())
         .def("setOptions", &OptimumSolver::setOptions)
         .def("solve", &OptimumSolver::solve)
+        .def("begin", &OptimumSolver::begin, py::keep_alive<1, 2>(), py::keep_alive<1, 3>())
+        .def("step", step1)
+        .def("step", step2)
+        .def("converged", &OptimumSolver::converged)
+        .def("finish", &OptimumSolver::finish)
+        .def("accumulatedResult", &OptimumSolver::accumulatedResult, py::return_value_policy::reference_internal)
+        .def("sensitivities", &OptimumSolver::sensitivities)
         .def("dxdp", &OptimumSolver::dxdp)
         ;
 }
@@ -32,13 +32,23 @@ using namespace Optima;
 
 void exportOptimumStepper(py::module& m)
 {
+    const auto residual1 = static_cast<IpSaddlePointVector(OptimumStepper::*)() const>(&OptimumStepper::residual);
+    const auto residual2 = static_cast<IpSaddlePointVector(OptimumStepper::*)(const OptimumParams&, const OptimumState&, const ObjectiveResult&)>(&OptimumStepper::residual);
+
     py::class_<OptimumStepper>(m, "OptimumStepper")
         .def(py::init<const OptimumStructure&>())
         .def("setOptions", &OptimumStepper::setOptions)
+        .def("setBarrier", &OptimumStepper::setBarrier)
+        .def("barrier", &OptimumStepper::barrier)
+        .def("fixVariablesAtBounds", &OptimumStepper::fixVariablesAtBounds)
+        .def("releasedVariables", &OptimumStepper::releasedVariables)
+        .def("variablesAtLowerBounds", &OptimumStepper::variablesAtLowerBounds)
+        .def("variablesAtUpperBounds", &OptimumStepper::variablesAtUpperBounds)
         .def("decompose", &OptimumStepper::decompose)
         .def("solve", &OptimumStepper::solve)
         .def("step", &OptimumStepper::step)
-        .def("residual", &OptimumStepper::residual)
+        .def("residual", residual1)
+        .def("residual", residual2)
         .def("matrix", &OptimumStepper::matrix)
         ;
 }
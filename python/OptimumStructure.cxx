@@ -34,6 +34,10 @@ void exportOptimumStructure(py::module& m)
         .def("setVariablesWithUpperBounds", &OptimumStructure::setVariablesWithUpperBounds, "Set the indices of the variables in `x` with upper bounds.")
         .def("allVariablesHaveUpperBounds", &OptimumStructure::allVariablesHaveUpperBounds, "Set all variables in `x` with upper bounds.")
         .def("setVariablesWithFixedValues", &OptimumStructure::setVariablesWithFixedValues, "Set the indices of the variables in `x` with fixed values.")
+        .def("setConstantHessianDense", &OptimumStructure::setConstantHessianDense, "Set a constant dense Hessian matrix for the objective function.")
+        .def("setConstantHessianDiagonal", &OptimumStructure::setConstantHessianDiagonal, "Set a constant diagonal Hessian matrix for the objective function.")
+        .def("setConstantHessianZero", &OptimumStructure::setConstantHessianZero, "Set a constant zero Hessian matrix for the objective function.")
+        .def("hasConstantHessian", &OptimumStructure::hasConstantHessian, "Return true if the Hessian matrix of the objective function is constant.")
         .def("numVariables", &OptimumStructure::numVariables, py::return_value_policy::reference_internal, "Return the number of variables.")
         .def("numEqualityConstraints", &OptimumStructure::numEqualityConstraints, py::return_value_policy::reference_internal, "Return the number of linear equality constraints.")
         .def("variablesWithLowerBounds", &OptimumStructure::variablesWithLowerBounds, py::return_value_policy::reference_internal, "Return the indices of the variables with lower bounds.")
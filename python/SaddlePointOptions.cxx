@@ -36,6 +36,7 @@ void exportSaddlePointOptions(py::module& m)
         .def(py::init<>())
         .def_readwrite("method", &SaddlePointOptions::method)
         .def_readwrite("rationalize", &SaddlePointOptions::rationalize)
+        .def_readwrite("exact", &SaddlePointOptions::exact)
         .def_readwrite("maxdenominator", &SaddlePointOptions::maxdenominator)
         ;
 }
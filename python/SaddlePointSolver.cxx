@@ -29,12 +29,17 @@ using namespace Optima;
 
 void exportSaddlePointSolver(py::module& m)
 {
+    const auto solve1 = static_cast<Result(SaddlePointSolver::*)(SaddlePointVector, SaddlePointSolution)>(&SaddlePointSolver::solve);
+    const auto solve2 = static_cast<Result(SaddlePointSolver::*)(MatrixConstRef, MatrixRef)>(&SaddlePointSolver::solve);
+
     py::class_<SaddlePointSolver>(m, "SaddlePointSolver")
         .def(py::init<>())
         .def("setOptions", &SaddlePointSolver::setOptions)
         .def("options", &SaddlePointSolver::options)
         .def("initialize", &SaddlePointSolver::initialize)
         .def("decompose", &SaddlePointSolver::decompose)
-        .def("solve", &SaddlePointSolver::solve)
+        .def("decomposeKeepingBasicVariables", &SaddlePointSolver::decomposeKeepingBasicVariables)
+        .def("solve", solve1)
+        .def("solve", solve2)
         ;
 }
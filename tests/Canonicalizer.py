@@ -124,6 +124,21 @@ def check_canonicalizer(canonicalizer, A):
 
     check_canonical_ordering(canonicalizer, weigths)
 
+    #---------------------------------------------------------------------------
+    # Sort the variables with new weights without changing the basic variables
+    #---------------------------------------------------------------------------
+    ibasic = set(canonicalizer.indicesBasicVariables())
+
+    weigths = abs(random.rand(n)) + 1.0
+
+    canonicalizer.updateOrderingWithPriorityWeights(weigths)
+
+    check_canonical_form(canonicalizer, A)
+
+    assert set(canonicalizer.indicesBasicVariables()) == ibasic
+
+    check_canonical_ordering(canonicalizer, weigths)
+
 
 @mark.parametrize("assemble_A", tested_matrices_A)
 def test_canonicalizer(assemble_A):
@@ -134,3 +149,37 @@ def test_canonicalizer(assemble_A):
 
     canonicalizer = Canonicalizer(A)
     check_canonicalizer(canonicalizer, A)
+
+
+@mark.parametrize("assemble_A", tested_matrices_A)
+def test_canonicalizer_exact(assemble_A):
+    m = 4
+    n = 6
+
+    A = around(10 * assemble_A(m, n))
+
+    canonicalizer = Canonicalizer()
+
+    assert canonicalizer.computeExact(A)
+
+    check_canonicalizer(canonicalizer, A)
+
+    # Check the exact numerators of S and R with respect to the common denominator
+    nb = canonicalizer.numBasicVariables()
+    d = canonicalizer.denominator()
+
+    assert canonicalizer.exact()
+    assert d > 0
+    assert canonicalizer.numeratorsS() == approx(d * canonicalizer.S())
+    assert canonicalizer.numeratorsR()[:nb] == approx(d * canonicalizer.R()[:nb])
+
+
+def test_canonicalizer_exact_fallback():
+    A = eigen.random(4, 6) + 0.5
+
+    canonicalizer = Canonicalizer()
+
+    assert not canonicalizer.computeExact(A)
+    assert not canonicalizer.exact()
+
+    check_canonicalizer(canonicalizer, A)
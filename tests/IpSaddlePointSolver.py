@@ -146,3 +146,62 @@ def test_ip_saddle_point_solver(args):
     # Check the residual of the equation M * s = r
     assert norm(M.dot(s) - r) / norm(r) == approx(0.0)
 
+
+
+def test_ip_saddle_point_solver_changed_variables():
+    m, n = 5, 10
+    t = 3 * n + m
+
+    A = Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, n)
+    H = eigen.random(n, n)
+    Z = eigen.ones(n)
+    W = eigen.ones(n)
+    L = eigen.ones(n)
+    U = eigen.ones(n)
+    jf = arange(0)
+
+    solver = IpSaddlePointSolver()
+    solver.initialize(A)
+
+    expected = linspace(1, t, t)
+
+    # Solve the problem with the given partition of the variables and check its residual
+    def check(lhs):
+        M = lhs.array()
+        r = M.dot(expected)
+        s = eigen.zeros(t)
+        solver.decompose(lhs)
+        solver.solve(IpSaddlePointVector(r, n, m), IpSaddlePointSolution(s, n, m))
+        assert norm(M.dot(s) - r) / norm(r) == approx(0.0)
+        R = column_stack([r, M.dot(-expected), M.dot(ones(t))])
+        S = zeros((t, 3), order='F')
+        solver.solve(R, S)
+        assert norm(M.dot(S) - R) / norm(R) == approx(0.0)
+
+    # All variables remain in partition s
+    check(IpSaddlePointMatrix(H, A, Z, W, L, U, jf))
+    assert len(solver.changedVariables()) == 0
+
+    # Move variable 2 to partition l and variable 7 to partition w
+    L[2] = 1.0e-3; Z[2] = 1.0
+    U[7] = 1.0e-18; W[7] = 1.0
+    check(IpSaddlePointMatrix(H, A, Z, W, L, U, jf))
+    assert set(solver.changedVariables()) == {2, 7}
+    assert len(solver.variablesAtLowerBounds()) == 0
+    assert set(solver.variablesAtUpperBounds()) == {7}
+
+    # Move variable 2 to partition z and fix variable 4
+    L[2] = 1.0e-18
+    jf = array([4])
+    check(IpSaddlePointMatrix(H, A, Z, W, L, U, jf))
+    assert set(solver.changedVariables()) == {2, 4}
+    assert set(solver.variablesAtLowerBounds()) == {2}
+    assert set(solver.variablesAtUpperBounds()) == {7}
+
+    # Move all variables back to partition s
+    Z = eigen.ones(n); W = eigen.ones(n); L = eigen.ones(n); U = eigen.ones(n)
+    jf = arange(0)
+    check(IpSaddlePointMatrix(H, A, Z, W, L, U, jf))
+    assert set(solver.changedVariables()) == {2, 4, 7}
+    assert len(solver.variablesAtLowerBounds()) == 0
+    assert len(solver.variablesAtUpperBounds()) == 0
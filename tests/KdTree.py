@@ -0,0 +1,49 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2014-2018 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+from optima import *
+from numpy import *
+from numpy.linalg import norm
+
+
+def test_kd_tree():
+
+    random.seed(0)
+
+    tree = KdTree()
+
+    # The nearest vector in an empty kd-tree does not exist
+    assert tree.size() == 0
+    assert tree.nearest(zeros(3)) == -1
+
+    points = random.rand(50, 3)
+
+    for p in points:
+        tree.insert(p)
+
+    assert tree.size() == len(points)
+
+    for i, p in enumerate(points):
+        assert norm(tree.point(i) - p) == 0.0
+
+    # Compare the nearest vectors with those found by brute force
+    for q in random.rand(100, 3):
+        assert tree.nearest(q) == argmin(norm(points - q, axis=1))
+
+    # The nearest vector to a stored one is itself
+    for i, p in enumerate(points):
+        assert tree.nearest(p) == i
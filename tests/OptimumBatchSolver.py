@@ -0,0 +1,183 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2014-2018 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+from optima import *
+from numpy import *
+from numpy.linalg import norm
+from pytest import approx, mark
+
+import Canonicalizer
+
+# The number of variables and number of equality constraints
+n = 10
+m = 5
+
+# Tested cases for the number of threads
+tested_numthreads = [1, 2, 4]
+
+# Tested cases for the scheduling strategies
+tested_schedulings = [BatchScheduling.Static, BatchScheduling.WorkStealing]
+
+
+def objective(x, f):
+    f.value = sum((x - 0.5) ** 2)
+    f.gradient = 2.0 * (x - 0.5)
+    f.hessian = 2.0 * ones(len(x))
+
+
+@mark.parametrize("numthreads", tested_numthreads)
+@mark.parametrize("scheduling", tested_schedulings)
+def test_optimum_batch_solver(numthreads, scheduling):
+
+    A = abs(Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, n))
+
+    structure = OptimumStructure(n, m)
+    structure.allVariablesHaveLowerBounds()
+    structure.A = A
+
+    # The parameters of each optimization problem, which differ only in b
+    params = []
+    for k in range(10):
+        p = OptimumParams()
+        p.b = A.dot(ones(n) + 0.1 * k)
+        p.xlower = zeros(n)
+        p.objective = objective
+        params.append(p)
+
+    states = [OptimumState() for p in params]
+
+    solver = OptimumBatchSolver(structure, numthreads)
+
+    assert solver.numThreads() == numthreads
+    assert solver.scheduling() == BatchScheduling.WorkStealing
+
+    solver.setScheduling(scheduling)
+
+    assert solver.scheduling() == scheduling
+
+    results = solver.solve(params, states)
+
+    assert len(results) == len(params)
+
+    for p, state, res in zip(params, states, results):
+        assert res.succeeded
+        assert norm(A.dot(state.x) - p.b) == approx(0.0, abs=1e-6)
+
+
+@mark.parametrize("numthreads", tested_numthreads)
+@mark.parametrize("scheduling", tested_schedulings)
+def test_optimum_batch_solver_reproducible(numthreads, scheduling):
+
+    A = abs(Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, n))
+
+    structure = OptimumStructure(n, m)
+    structure.allVariablesHaveLowerBounds()
+    structure.A = A
+
+    # The predictions of solutions, which would use the problems solved before by the same thread if the solvers kept their state
+    options = OptimumOptions()
+    options.prediction.active = True
+
+    # The parameters of each optimization problem, which are so close that their solutions can be predicted from each other
+    params = []
+    for k in range(20):
+        p = OptimumParams()
+        p.b = A.dot(ones(n) + 1e-9 * k)
+        p.xlower = zeros(n)
+        p.objective = objective
+        params.append(p)
+
+    # The number of iterations of each problem solved alone with a new solver
+    expected = []
+    for p in params:
+        single = OptimumSolver(structure)
+        single.setOptions(options)
+        expected.append(single.solve(p, OptimumState()).iterations)
+
+    solver = OptimumBatchSolver(structure, numthreads)
+    solver.setOptions(options)
+    solver.setScheduling(scheduling)
+
+    # The iterations do not depend on the number of threads, the scheduling, or the problems solved before
+    for repeat in range(2):
+        states = [OptimumState() for p in params]
+        results = solver.solve(params, states)
+        assert [res.iterations for res in results] == expected
+
+
+@mark.parametrize("numthreads", tested_numthreads)
+def test_optimum_batch_solver_lockstep(numthreads):
+
+    A = abs(Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, n))
+
+    structure = OptimumStructure(n, m)
+    structure.allVariablesHaveLowerBounds()
+    structure.A = A
+
+    # The parameters of each optimization problem, which differ only in b
+    params = []
+    for k in range(10):
+        p = OptimumParams()
+        p.b = A.dot(ones(n) + 0.1 * k)
+        p.xlower = zeros(n)
+        params.append(p)
+
+    # The number of points in each call to the batch objective function
+    numpoints = []
+
+    # The objective function evaluated at many points, one in each column of X
+    def batch_objective(problems, X, F):
+        numpoints.append(X.shape[1])
+        F.values = sum((X - 0.5) ** 2, axis=0)
+        F.gradients = 2.0 * (X - 0.5)
+        F.hessians = [2.0 * ones(n) for j in range(X.shape[1])]
+
+    states = [OptimumState() for p in params]
+
+    solver = OptimumBatchSolver(structure, numthreads)
+
+    results = solver.solve(params, batch_objective, states)
+
+    assert len(results) == len(params)
+
+    # All problems are evaluated together in the first call
+    assert numpoints[0] == len(params)
+
+    for p, state, res in zip(params, states, results):
+        assert res.succeeded
+        assert norm(A.dot(state.x) - p.b) == approx(0.0, abs=1e-6)
+
+        # Compare with the solution of the same problem calculated with a single objective function
+        p.objective = objective
+        expected = OptimumState()
+        OptimumSolver(structure).solve(p, expected)
+
+        assert norm(state.x - expected.x) == approx(0.0, abs=1e-10)
+
+    # Solve the problems again with at most three of them solved at the same time
+    solver.setMaxLockstepProblems(3)
+    assert solver.maxLockstepProblems() == 3
+
+    numpoints.clear()
+    capped = [OptimumState() for p in params]
+    results = solver.solve(params, batch_objective, capped)
+
+    assert max(numpoints) <= 3
+
+    for state, cappedstate, res in zip(states, capped, results):
+        assert res.succeeded
+        assert norm(cappedstate.x - state.x) == approx(0.0, abs=1e-10)
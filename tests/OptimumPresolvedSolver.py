@@ -0,0 +1,106 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2014-2018 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+from optima import *
+from numpy import *
+from numpy.linalg import norm
+from pytest import approx
+
+import OptimumPresolver
+
+
+def test_optimum_presolved_solver():
+
+    # The problem with fixed variables, equal bounds, and singleton, forcing and empty constraints removed in the presolve
+    structure = OptimumPresolver.create_structure()
+    params = OptimumPresolver.create_params()
+
+    A = OptimumPresolver.A
+    nx, mx = A.shape
+
+    options = OptimumOptions()
+    options.tolerance = 1.0e-10
+    options.barrier.mode = BarrierMode.Monotone
+    options.presolve.active = True
+
+    # The solution calculated by OptimumSolver with presolve active, used as reference
+    expectedsolver = OptimumSolver(structure)
+    expectedsolver.setOptions(options)
+
+    expected = OptimumState()
+    expectedres = expectedsolver.solve(params, expected)
+
+    assert expectedres.succeeded
+
+    solver = OptimumPresolvedSolver(structure)
+    solver.setOptions(options)
+
+    # The step-by-step calculation with the presolved problem, with the state of the original problem updated along the iterations
+    state = OptimumState()
+    solver.begin(params, state)
+
+    while solver.step():
+        pass
+
+    assert solver.converged()
+    assert not solver.step()
+
+    res = solver.finish()
+
+    assert res.succeeded
+    assert res.iterations == expectedres.iterations
+    assert state.x == approx(expected.x)
+    assert state.y == approx(expected.y)
+    assert state.z == approx(expected.z)
+    assert state.w == approx(expected.w)
+
+    # The sensitivity derivatives with respect to b0 (of the singleton constraint) and b3
+    dbdp = zeros((mx, 2))
+    dbdp[0, 0] = 1.0
+    dbdp[3, 1] = 1.0
+
+    sensitivity = OptimumSensitivity()
+    solver.sensitivities(zeros((nx, 2)), dbdp, sensitivity)
+
+    expectedsensitivity = OptimumSensitivity()
+    expectedsolver.sensitivities(zeros((nx, 2)), dbdp, expectedsensitivity)
+
+    assert sensitivity.dxdp == approx(expectedsensitivity.dxdp)
+    assert sensitivity.dydp == approx(expectedsensitivity.dydp)
+    assert sensitivity.dxdp[2, 0] == approx(0.5)
+
+
+def test_optimum_presolved_solver_infeasibility():
+
+    structure = OptimumPresolver.create_structure()
+
+    solver = OptimumPresolvedSolver(structure)
+    solver.setOptions(OptimumOptions())
+
+    # A forcing constraint with b below the minimum of its left-hand side is detected in the presolve, before any iteration
+    params = OptimumPresolver.create_params()
+    params.b[1] = -0.1
+
+    state = OptimumState()
+    solver.begin(params, state)
+
+    assert not solver.step()
+    assert not solver.converged()
+
+    res = solver.finish()
+
+    assert not res.succeeded
+    assert res.iterations == 0
@@ -0,0 +1,192 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2014-2018 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+from optima import *
+from numpy import *
+from numpy.linalg import norm
+from pytest import approx
+
+
+# The number of variables and number of equality constraints
+n = 8
+m = 5
+
+# The coefficient matrix of the equality constraints, with rows that are removed in the presolve
+A = zeros((m, n))
+A[0, 2] = 2.0                               # a singleton constraint that determines x2
+A[1, 3], A[1, 4] = 1.0, 2.0                 # a forcing constraint (with b = 0) that fixes x3 and x4 at their lower bounds
+A[2, 7] = 1.0                               # an empty constraint after the removal of the fixed variable x7
+A[3] = [1.0, 2.0, 1.0, 0.0, 0.0, 1.0, 1.0, 0.0]
+A[4] = [0.5, 1.0, 3.0, 0.0, 0.0, 2.0, 0.5, 0.0]
+
+# The values of the variables at which the equality constraints are satisfied
+xb = array([1.0, 0.7, 0.5, 0.0, 0.0, 0.9, 0.5, 0.3])
+
+# The minimum point of the objective function without constraints
+c = linspace(-1.0, 1.0, n)
+
+
+def objective(x, f):
+    f.value = sum((x - c) ** 2)
+    f.gradient = 2.0 * (x - c)
+    f.hessian = 2.0 * ones(len(x))
+
+
+def create_structure():
+    structure = OptimumStructure(n, m)
+    structure.A = A
+    structure.setVariablesWithLowerBounds(arange(7))
+    structure.setVariablesWithUpperBounds(arange(7))
+    structure.setVariablesWithFixedValues(array([7]))
+    return structure
+
+
+def create_params():
+    params = OptimumParams()
+    params.b = A.dot(xb)
+    params.xlower = zeros(7)
+    params.xupper = 10.0 * ones(7)
+    params.xlower[6] = params.xupper[6] = 0.5  # the variable x6 has equal lower and upper bounds
+    params.xfixed = array([0.3])
+    params.objective = objective
+    return params
+
+
+def test_optimum_presolver_reductions():
+
+    structure = create_structure()
+    params = create_params()
+
+    presolver = OptimumPresolver(structure)
+    presolver.setOptions(OptimumOptions())
+
+    assert presolver.presolve(params)
+
+    # Only the variables x0, x1, x5 and the last two equality constraints remain in the presolved problem
+    assert all(presolver.variables() == [0, 1, 5])
+    assert all(presolver.constraints() == [3, 4])
+    assert all(presolver.dependentVariables() == [2])
+
+    ivariables = presolver.variables()
+    iconstraints = presolver.constraints()
+
+    # The values of the removed variables determined in the presolve
+    xremoved = array([0.0, 0.0, 0.5, 0.0, 0.0, 0.0, 0.5, 0.3])
+
+    presolvedstructure = presolver.structure()
+    presolvedparams = presolver.params()
+
+    assert presolvedstructure.numVariables() == 3
+    assert presolvedstructure.numEqualityConstraints() == 2
+    assert len(presolvedstructure.variablesWithFixedValues()) == 0
+    assert presolvedstructure.A == approx(A[iconstraints][:, ivariables])
+    assert presolvedparams.b == approx((A.dot(xb) - A.dot(xremoved))[iconstraints])
+    assert presolvedparams.xlower == approx(zeros(3))
+    assert presolvedparams.xupper == approx(10.0 * ones(3))
+
+    # The derivatives of the removed variables with respect to b, with x2 = b0/2 the only one depending on b
+    dxdp = presolver.derivatives(eye(m))
+    expected = zeros((n, m))
+    expected[2, 0] = 0.5
+    assert dxdp == approx(expected)
+
+
+def test_optimum_presolver_postsolve():
+
+    structure = create_structure()
+    params = create_params()
+
+    presolver = OptimumPresolver(structure)
+    presolver.setOptions(OptimumOptions())
+    presolver.presolve(params)
+
+    ivariables = presolver.variables()
+
+    # The presolved problem, with the objective function evaluated at all variables
+    def presolved_objective(xp, fp):
+        x = zeros(n)
+        presolver.postsolve(xp, x)
+        f = ObjectiveResult()
+        f.requires = fp.requires
+        objective(x, f)
+        presolver.presolve(f, fp)
+
+    presolvedparams = OptimumParams()
+    presolvedparams.b = presolver.params().b
+    presolvedparams.xlower = presolver.params().xlower
+    presolvedparams.xupper = presolver.params().xupper
+    presolvedparams.objective = presolved_objective
+
+    options = OptimumOptions()
+    options.tolerance = 1.0e-10
+    options.barrier.mode = BarrierMode.Monotone
+
+    solver = OptimumSolver(presolver.structure())
+    solver.setOptions(options)
+
+    presolvedstate = OptimumState()
+    res = solver.solve(presolvedparams, presolvedstate)
+
+    assert res.succeeded
+
+    # Recover the state of the original problem, with the multipliers of the removed constraints and bounds
+    state = OptimumState()
+    presolver.postsolve(presolvedstate, state)
+
+    f = ObjectiveResult()
+    objective(state.x, f)
+
+    presolver.postsolve(presolvedstate, f.gradient, state)
+
+    assert state.x[ivariables] == approx(presolvedstate.x)
+    assert state.x[[2, 3, 4, 6, 7]] == approx([0.5, 0.0, 0.0, 0.5, 0.3])
+    assert norm(A.dot(state.x) - params.b) < 1.0e-10
+
+    # The optimality conditions of the original problem are satisfied (except for the fixed variable x7)
+    residual = f.gradient + A.T.dot(state.y) - state.z - state.w
+    assert norm(residual[:7]) < 1.0e-8
+    assert all(state.z >= 0.0)
+    assert all(state.w <= 0.0)
+
+
+def test_optimum_presolver_infeasibility():
+
+    structure = create_structure()
+
+    presolver = OptimumPresolver(structure)
+    presolver.setOptions(OptimumOptions())
+
+    # A forcing constraint with b below the minimum of its left-hand side
+    params = create_params()
+    params.b[1] = -0.1
+    assert not presolver.presolve(params)
+
+    # A singleton constraint that determines a variable beyond its bounds
+    params = create_params()
+    params.b[0] = -1.0
+    assert not presolver.presolve(params)
+
+    # An empty constraint that is not satisfied
+    params = create_params()
+    params.b[2] = 0.5
+    assert not presolver.presolve(params)
+
+    # Lower bounds greater than upper bounds
+    params = create_params()
+    params.xlower[0] = 2.0
+    params.xupper[0] = 1.0
+    assert not presolver.presolve(params)
@@ -0,0 +1,94 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2014-2018 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+from optima import *
+from numpy import *
+from numpy.linalg import norm
+from pytest import approx
+
+import OptimumReducer
+
+
+def test_optimum_reduced_solver():
+
+    # The problem with bounds only on the non-basic variables, whose basic variables are eliminated in the reduced space
+    structure = OptimumReducer.create_structure()
+    params = OptimumReducer.create_params()
+
+    A = OptimumReducer.A
+    nx, mx = A.shape
+
+    options = OptimumOptions()
+    options.tolerance = 1.0e-10
+    options.barrier.mode = BarrierMode.Monotone
+    options.reduced_space = True
+
+    # The solution calculated by OptimumSolver in the reduced space, used as reference
+    expectedsolver = OptimumSolver(structure)
+    expectedsolver.setOptions(options)
+
+    expected = OptimumState()
+    expectedres = expectedsolver.solve(params, expected)
+
+    assert expectedres.succeeded
+
+    solver = OptimumReducedSolver(structure)
+    solver.setOptions(options)
+
+    assert solver.reducible()
+
+    # The step-by-step calculation with the reduced problem, with the basic variables recovered along the iterations
+    state = OptimumState()
+    solver.begin(params, state)
+
+    while solver.step():
+        assert norm(A.dot(state.x) - params.b) < 1.0e-8 * norm(params.b)
+
+    assert solver.converged()
+    assert not solver.step()
+
+    res = solver.finish()
+
+    assert res.succeeded
+    assert res.iterations == expectedres.iterations
+    assert state.x == approx(expected.x)
+    assert state.y == approx(expected.y)
+
+    # The sensitivity derivatives with respect to b0 and b3
+    dbdp = zeros((mx, 2))
+    dbdp[0, 0] = 1.0
+    dbdp[3, 1] = 1.0
+
+    sensitivity = OptimumSensitivity()
+    solver.sensitivities(zeros((nx, 2)), dbdp, sensitivity)
+
+    expectedsensitivity = OptimumSensitivity()
+    expectedsolver.sensitivities(zeros((nx, 2)), dbdp, expectedsensitivity)
+
+    assert sensitivity.dxdp == approx(expectedsensitivity.dxdp)
+    assert sensitivity.dydp == approx(expectedsensitivity.dydp)
+
+
+def test_optimum_reduced_solver_reducible():
+
+    # The problem cannot be reduced if all variables have bounds
+    structure = OptimumReducer.create_structure()
+    structure.setVariablesWithLowerBounds(arange(OptimumReducer.n))
+
+    solver = OptimumReducedSolver(structure)
+    solver.setOptions(OptimumOptions())
+
+    assert not solver.reducible()
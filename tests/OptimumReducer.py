@@ -0,0 +1,161 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2014-2018 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+from optima import *
+from numpy import *
+from numpy.linalg import norm
+from pytest import approx
+
+
+# The number of variables and number of equality constraints
+n = 6
+m = 4
+
+# The coefficient matrix of the equality constraints, in which only the last two variables have bounds
+A = array([
+    [1.0, 1.0, 0.0, 0.0, 1.0, 2.0],
+    [0.0, 1.0, 0.0, 0.0, 2.0, 1.0],
+    [0.0, 0.0, 1.0, 0.5, 1.0, 1.0],
+    [0.0, 0.0, 0.0, 1.0, 3.0, 1.0]])
+
+# The values of the variables at which the equality constraints are satisfied
+xb = array([1.0, 2.0, 0.5, 1.0, 0.5, 0.2])
+
+# The minimum point of the quadratic part of the objective function
+c = linspace(-1.0, 1.0, n)
+
+
+def objective(x, f):
+    f.value = sum((x - c) ** 2) + 0.25 * sum(x ** 4)
+    f.gradient = 2.0 * (x - c) + x ** 3
+    f.hessian = 2.0 + 3.0 * x ** 2
+
+
+def create_structure():
+    structure = OptimumStructure(n, m)
+    structure.A = A
+    structure.setVariablesWithLowerBounds(array([4, 5]))
+    structure.setVariablesWithUpperBounds(array([4, 5]))
+    return structure
+
+
+def create_params():
+    params = OptimumParams()
+    params.b = A.dot(xb)
+    params.xlower = zeros(2)
+    params.xupper = 10.0 * ones(2)
+    params.objective = objective
+    return params
+
+
+def test_optimum_reducer_reduction():
+
+    structure = create_structure()
+    params = create_params()
+
+    reducer = OptimumReducer(structure)
+    reducer.setOptions(OptimumOptions())
+
+    assert reducer.reducible()
+    assert reducer.reduce(params)
+
+    # The basic variables are the ones without bounds, and the reduced problem has the bounded ones only
+    assert sorted(reducer.basicVariables()) == [0, 1, 2, 3]
+    assert sorted(reducer.nonBasicVariables()) == [4, 5]
+
+    reducedstructure = reducer.structure()
+    reducedparams = reducer.params()
+
+    assert reducedstructure.numVariables() == 2
+    assert reducedstructure.numEqualityConstraints() == 0
+    assert len(reducedstructure.variablesWithLowerBounds()) == 2
+    assert len(reducedstructure.variablesWithUpperBounds()) == 2
+    assert len(reducedparams.b) == 0
+    assert reducedparams.xlower == approx(zeros(2))
+    assert reducedparams.xupper == approx(10.0 * ones(2))
+
+    # The basic variables are recovered from the non-basic ones with the equality constraints
+    inonbasic = reducer.nonBasicVariables()
+    x = zeros(n)
+    reducer.recover(xb[inonbasic], x)
+    assert x == approx(xb)
+
+    # The derivatives of the variables with respect to b, with the non-basic variables constant
+    dxdp = reducer.derivatives(zeros((2, m)), eye(m))
+    assert A.dot(dxdp) == approx(eye(m))
+    assert dxdp[inonbasic] == approx(zeros((2, m)))
+
+    # The problem cannot be reduced if all variables have bounds
+    structure.setVariablesWithLowerBounds(arange(n))
+    assert not OptimumReducer(structure).reducible()
+
+
+def test_optimum_reducer_recover():
+
+    structure = create_structure()
+    params = create_params()
+
+    reducer = OptimumReducer(structure)
+    reducer.setOptions(OptimumOptions())
+    reducer.reduce(params)
+
+    # The reduced problem, with the objective function evaluated at all variables
+    def reduced_objective(xn, fn):
+        x = zeros(n)
+        reducer.recover(xn, x)
+        f = ObjectiveResult()
+        f.requires = fn.requires
+        objective(x, f)
+        reducer.reduce(f, fn)
+
+    reducedparams = OptimumParams()
+    reducedparams.b = reducer.params().b
+    reducedparams.xlower = reducer.params().xlower
+    reducedparams.xupper = reducer.params().xupper
+    reducedparams.objective = reduced_objective
+
+    options = OptimumOptions()
+    options.tolerance = 1.0e-10
+    options.barrier.mode = BarrierMode.Monotone
+
+    solver = OptimumSolver(reducer.structure())
+    solver.setOptions(options)
+
+    reducedstate = OptimumState()
+    res = solver.solve(reducedparams, reducedstate)
+
+    assert res.succeeded
+
+    # Recover the state of the original problem, with the multipliers y determined from the gradient at the solution
+    state = OptimumState()
+    x = zeros(n)
+    reducer.recover(reducedstate.x, x)
+
+    f = ObjectiveResult()
+    objective(x, f)
+
+    reducer.recover(reducedstate, f.gradient, state)
+
+    assert state.x == approx(x)
+    assert norm(A.dot(state.x) - params.b) < 1.0e-10
+
+    # The optimality conditions of the original problem are satisfied, with zero multipliers z and w for the basic variables
+    residual = f.gradient + A.T.dot(state.y) - state.z - state.w
+    assert norm(residual) < 1.0e-8
+    assert all(state.z >= 0.0)
+    assert all(state.w <= 0.0)
+    assert all(state.z[reducer.basicVariables()] == 0.0)
@@ -0,0 +1,118 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2014-2018 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+from optima import *
+from numpy import *
+from numpy.linalg import norm
+from pytest import approx
+
+
+# The number of variables and number of equality constraints
+n = 4
+m = 2
+
+# The coefficient matrix of the equality constraints, with rows and columns of very different magnitudes
+A = array([
+    [1.0e+4, 2.0e+4, 0.0,    1.0e+3],
+    [0.0,    1.0e-2, 3.0e-3, 2.0e-2]])
+
+
+def objective(x, f):
+    f.value = 1.0e+6 * sum(x ** 2)
+    f.gradient = 2.0e+6 * x
+    f.hessian = 2.0e+6 * ones(len(x))
+
+
+def is_power_of_two(v):
+    return all(log2(v) == round(log2(v)))
+
+
+def test_optimum_scaling():
+
+    structure = OptimumStructure(n, m)
+    structure.A = A
+    structure.allVariablesHaveLowerBounds()
+
+    options = OptimumScalingOptions()
+    options.active = True
+
+    scaling = OptimumScaling()
+
+    # The default scaling does not scale the problem
+    assert not scaling.active()
+
+    scaling.initialize(structure, options)
+
+    assert scaling.active()
+    assert scaling.undetermined()
+    assert scaling.objectiveScaling() == 1.0
+
+    # The scaling factors are powers of two, and the largest entry of each row and column of the scaled matrix A is close to one
+    assert is_power_of_two(scaling.colScaling())
+    assert is_power_of_two(scaling.rowScaling())
+
+    scaledA = scaling.scaled(structure).A
+
+    assert all(abs(scaledA).max(axis=1) > 0.25) and all(abs(scaledA).max(axis=1) < 4.0)
+    assert all(abs(scaledA).max(axis=0) > 0.25) and all(abs(scaledA).max(axis=0) < 4.0)
+
+    # Determine the scaling factor of the objective function from its scaled gradient (with unit scaling factor) at an initial guess
+    x = ones(n)
+    f = ObjectiveResult()
+    f.requires.hessian = False
+    scaling.evaluate(objective, x, f)
+
+    scaling.determine(f)
+    scaling.fixObjectiveScaling()
+
+    assert not scaling.undetermined()
+    assert is_power_of_two(array([scaling.objectiveScaling()]))
+    assert scaling.objectiveScaling() < 1.0
+
+    # The scaled gradient does not exceed the maximum entry given in the options
+    scaledf = ObjectiveResult()
+    scaling.evaluate(objective, x, scaledf)
+
+    assert abs(scaledf.gradient).max() <= options.max_gradient
+
+    # The scaled and then unscaled state is identical to the original one, since all scaling factors are powers of two
+    state = OptimumState()
+    state.x = linspace(1.0, 2.0, n)
+    state.y = linspace(-1.0, 1.0, m)
+    state.z = linspace(0.1, 0.4, n)
+    state.w = zeros(n)
+
+    scaledstate = OptimumState()
+    scaling.scale(state, scaledstate)
+
+    unscaledstate = OptimumState()
+    scaling.unscale(scaledstate, unscaledstate)
+
+    assert norm(unscaledstate.x - state.x) == 0.0
+    assert norm(unscaledstate.y - state.y) == 0.0
+    assert norm(unscaledstate.z - state.z) == 0.0
+    assert norm(unscaledstate.w - state.w) == 0.0
+
+    # The scaled equality constraints are satisfied by the scaled variables
+    params = OptimumParams()
+    params.b = A.dot(state.x)
+    params.xlower = zeros(n)
+
+    scaledparams = OptimumParams()
+    scaling.scale(structure, params, scaledparams)
+
+    assert norm(scaledA.dot(scaledstate.x) - scaledparams.b) == approx(0.0, abs=1e-12 * norm(scaledparams.b))
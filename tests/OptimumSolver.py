@@ -17,11 +17,13 @@
 
 from optima import *
 from numpy import *
-from numpy.linalg import norm
+from numpy.linalg import norm, inv
 from pytest import approx, mark
 from itertools import product
 
 import Canonicalizer
+import OptimumPresolver
+import OptimumReducer
 
 # The number of variables and number of equality constraints
 n = 10
@@ -142,6 +144,1031 @@ def test_optimum_solver(args):
     assert res.succeeded
 
 
+
+def objective_without_hessian(x, f):
+    f.value = sum((x - 0.5) ** 2)
+    f.gradient = 2.0 * (x - 0.5)
+
+
+# The coefficients of the Gibbs-energy-like objective function
+cgibbs = linspace(-1.0, 1.0, n)
+
+
+# A Gibbs-energy-like objective, whose Hessian matrix is dense and evaluated only when required
+def gibbs(x, f):
+    f.value = sum(x * (cgibbs + log(x / sum(x))))
+    f.gradient = cgibbs + log(x / sum(x))
+    if f.requires.hessian:
+        f.hessian = diag(1.0 / x) - 1.0 / sum(x)
+
+
+# Return the structure and parameters of the problem with the Gibbs-energy-like objective and all variables with lower bounds
+def create_gibbs_problem(A=None):
+    if A is None:
+        A = abs(Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, n)) + 0.1
+
+    structure = OptimumStructure(n, m)
+    structure.allVariablesHaveLowerBounds()
+    structure.A = A
+
+    params = OptimumParams()
+    params.b = A.dot(ones(n))
+    params.xlower = zeros(n)
+    params.objective = gibbs
+
+    return structure, params
+
+
+# The number of variables in the linear and quadratic programming problems with lower and upper bounds
+nbox = 4*n
+
+# The coefficients of the linear and quadratic terms in their objective functions
+cbox = linspace(-1.0, 1.0, nbox)
+hbox = linspace(0.1, 1.0, nbox)
+
+
+# Return the objective function of a linear or quadratic programming problem with diagonal Hessian matrix h
+def quadratic_objective(c, h):
+    def quadratic(x, f):
+        f.value = c.dot(x) + 0.5 * x.dot(h * x)
+        f.gradient = c + h * x
+    return quadratic
+
+
+# Return the structure and parameters of a linear (zero h) or quadratic programming problem with all variables
+# in [0, 1], whose solution has many active lower and upper bounds
+def create_bounded_problem(A, c, h):
+    mx, nx = A.shape
+
+    structure = OptimumStructure(nx, mx)
+    structure.allVariablesHaveLowerBounds()
+    structure.allVariablesHaveUpperBounds()
+    structure.A = A
+
+    if any(h): structure.setConstantHessianDiagonal(h)
+    else: structure.setConstantHessianZero()
+
+    params = OptimumParams()
+    params.b = A.dot(0.5 * ones(nx))
+    params.xlower = zeros(nx)
+    params.xupper = ones(nx)
+    params.objective = quadratic_objective(c, h)
+
+    return structure, params
+
+
+@mark.parametrize("structure_H", tested_structures_H)
+def test_optimum_solver_constant_hessian(structure_H):
+
+    A = Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, n)
+
+    structure = OptimumStructure(n, m)
+    structure.allVariablesHaveLowerBounds()
+    structure.A = A
+
+    if structure_H == 'dense':
+        structure.setConstantHessianDense(2.0 * eye(n))
+    else:
+        structure.setConstantHessianDiagonal(2.0 * ones(n))
+
+    assert structure.hasConstantHessian()
+
+    params = OptimumParams()
+    params.b = A.dot(ones(n))
+    params.xlower = zeros(n)
+    params.objective = objective_without_hessian
+
+    state = OptimumState()
+
+    solver = OptimumSolver(structure)
+    res = solver.solve(params, state)
+
+    assert res.succeeded
+    assert norm(A.dot(state.x) - params.b) == approx(0.0)
+
+
+def test_optimum_solver_constant_hessian_zero():
+
+    A = Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, nbox)
+
+    # A linear programming problem, whose objective function evaluates only its value and gradient
+    structure, params = create_bounded_problem(A, cbox, zeros(nbox))
+
+    assert structure.hasConstantHessian()
+
+    options = OptimumOptions()
+    options.max_iterations = 500
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    state = OptimumState()
+    res = solver.solve(params, state)
+
+    assert res.succeeded
+    assert norm(A.dot(state.x) - params.b) == approx(0.0, abs=1e-6)
+    assert all(state.x >= params.xlower) and all(state.x <= params.xupper)
+
+    # The optimality conditions hold with the multipliers of the lower and upper bounds
+    residual = cbox + A.T.dot(state.y) - state.z - state.w
+    assert norm(residual) == approx(0.0, abs=1e-6)
+
+
+def test_optimum_solver_sensitivities():
+
+    A = Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, n)
+
+    p = linspace(1, 2, n)
+
+    def objective_with_parameters(x, f):
+        f.value = 0.5 * sum((x - p) ** 2)
+        f.gradient = x - p
+        f.hessian = ones(len(x))
+
+    structure = OptimumStructure(n, m)
+    structure.A = A
+
+    params = OptimumParams()
+    params.b = A.dot(ones(n))
+    params.objective = objective_with_parameters
+
+    state = OptimumState()
+
+    solver = OptimumSolver(structure)
+    res = solver.solve(params, state)
+
+    assert res.succeeded
+
+    # The parameters are p and b, with dg/dp = [-I 0] and db/dp = [0 I]
+    dgdp = hstack([-eye(n), zeros((n, m))])
+    dbdp = hstack([zeros((m, n)), eye(m)])
+
+    sensitivity = OptimumSensitivity()
+    solver.sensitivities(dgdp, dbdp, sensitivity)
+
+    # The exact derivatives of x = p + tr(A)*inv(A*tr(A))*(b - A*p)
+    K = A.T.dot(inv(A.dot(A.T)))
+    dxdp_expected = hstack([eye(n) - K.dot(A), K])
+
+    assert norm(sensitivity.dxdp - dxdp_expected) == approx(0.0, abs=1e-8)
+    assert sensitivity.dydp.shape == (m, n + m)
+
+
+def test_optimum_solver_prediction():
+
+    A = abs(Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, n))
+
+    structure = OptimumStructure(n, m)
+    structure.allVariablesHaveLowerBounds()
+    structure.A = A
+
+    params = OptimumParams()
+    params.xlower = zeros(n)
+    params.objective = objective
+
+    options = OptimumOptions()
+    options.prediction.active = True
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    # Solve a sequence of problems with slightly different vectors b
+    results = []
+    for k in range(10):
+        params.b = A.dot(ones(n) + 1.0e-5 * k)
+        state = OptimumState()
+        res = solver.solve(params, state)
+        assert res.succeeded
+        assert norm(A.dot(state.x) - params.b) == approx(0.0, abs=1e-6)
+        results.append(res)
+
+    # The first problem is fully solved and the others are predicted from it
+    assert not results[0].predicted
+    assert all(res.predicted for res in results[1:])
+    assert all(res.iterations == 0 for res in results[1:])
+
+    # The predictions are checked without evaluating the Hessian matrix
+    assert all(res.num_hessian_evals == 0 for res in results[1:])
+
+    # The accumulated result of the solver has the prediction attempts and hits of all calculations
+    total = solver.accumulatedResult()
+    assert total.num_prediction_attempts == 9
+    assert total.num_prediction_hits == 9
+    assert total.predictionHitRate() == approx(1.0)
+
+
+def test_optimum_solver_prediction_sensitivities():
+
+    A = 0.1 + abs(sin(arange(m*n) + 1.0)).reshape(m, n)
+
+    structure, params = create_gibbs_problem(A)
+
+    options = OptimumOptions()
+    options.prediction.active = True
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    # Solve two problems with distant vectors b, and then one whose solution is predicted from the first, not the last, of them
+    for x in [ones(n), linspace(0.1, 5.0, n), ones(n) + 1.0e-7]:
+        params.b = A.dot(x)
+        state = OptimumState()
+        state.x = ones(n)
+        res = solver.solve(params, state)
+        assert res.succeeded
+
+    assert res.predicted
+
+    dbdp = eye(m)
+
+    sensitivity = OptimumSensitivity()
+    solver.sensitivities(zeros((n, m)), dbdp, sensitivity)
+
+    # The derivatives with respect to b are those of the stored solution used in the prediction, not those of the last decomposition
+    expected = OptimumState()
+    expected.x = ones(n)
+
+    fullsolver = OptimumSolver(structure)
+    assert fullsolver.solve(params, expected).succeeded
+
+    expectedsensitivity = OptimumSensitivity()
+    fullsolver.sensitivities(zeros((n, m)), dbdp, expectedsensitivity)
+
+    assert norm(sensitivity.dxdp - expectedsensitivity.dxdp) / norm(expectedsensitivity.dxdp) == approx(0.0, abs=1e-6)
+    assert norm(sensitivity.dydp - expectedsensitivity.dydp) / norm(expectedsensitivity.dydp) == approx(0.0, abs=1e-6)
+
+
+def test_optimum_solver_warmstart():
+
+    A = abs(Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, n))
+
+    structure = OptimumStructure(n, m)
+    structure.allVariablesHaveLowerBounds()
+    structure.A = A
+
+    params = OptimumParams()
+    params.xlower = zeros(n)
+    params.objective = objective
+
+    options = OptimumOptions()
+    options.warmstart = True
+
+    warmsolver = OptimumSolver(structure)
+    warmsolver.setOptions(options)
+
+    coldsolver = OptimumSolver(structure)
+
+    warmstate = OptimumState()
+    coldstate = OptimumState()
+
+    # Solve a sequence of problems with slightly different vectors b, using the previous solution as initial guess
+    for k in range(5):
+        params.b = A.dot(ones(n) + 1.0e-3 * k)
+        warmres = warmsolver.solve(params, warmstate)
+        coldres = coldsolver.solve(params, coldstate)
+        assert warmres.succeeded
+        assert norm(warmstate.x - coldstate.x) == approx(0.0, abs=1e-6)
+
+
+def test_optimum_solver_step_by_step():
+
+    A = abs(Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, n))
+
+    structure = OptimumStructure(n, m)
+    structure.allVariablesHaveLowerBounds()
+    structure.A = A
+
+    # The parameters of a few problems with different vectors b
+    params = []
+    for k in range(3):
+        p = OptimumParams()
+        p.b = A.dot(ones(n) + 0.1 * k)
+        p.xlower = zeros(n)
+        p.objective = objective
+        params.append(p)
+
+    solvers = [OptimumSolver(structure) for p in params]
+    states = [OptimumState() for p in params]
+
+    # Interleave the iterations of all problems until they are all finished
+    for solver, p, state in zip(solvers, params, states):
+        solver.begin(p, state)
+
+    active = [True for p in params]
+    while any(active):
+        active = [active[k] and solvers[k].step() for k in range(len(params))]
+
+    for solver, p, state in zip(solvers, params, states):
+        assert solver.converged()
+        assert not solver.step()
+
+        res = solver.finish()
+
+        # Compare with the solution of the same problem calculated with method solve
+        expected = OptimumState()
+        expectedres = OptimumSolver(structure).solve(p, expected)
+
+        assert res.succeeded
+        assert res.iterations == expectedres.iterations
+        assert norm(state.x - expected.x) == approx(0.0, abs=1e-10)
+
+
+def test_optimum_solver_linesearch():
+
+    A = abs(Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, n)) + 0.1
+
+    structure = OptimumStructure(n, m)
+    structure.allVariablesHaveLowerBounds()
+    structure.A = A
+
+    c = linspace(-5.0, 5.0, n)
+
+    # A pseudo-Huber objective, for which full Newton steps diverge far from the minimum
+    def huber(x, f):
+        d = x - c
+        s = sqrt(1.0 + d**2)
+        f.value = sum(s)
+        if f.requires.gradient:
+            f.gradient = d / s
+        if f.requires.hessian:
+            f.hessian = 1.0 / s**3
+
+    params = OptimumParams()
+    params.b = A.dot(c)
+    params.xlower = -20.0 * ones(n)
+    params.objective = huber
+
+    for step in [StepMode.Aggressive, StepMode.Conservative]:
+        options = OptimumOptions()
+        options.step = step
+        options.max_iterations = 300
+        options.linesearch.active = True
+
+        solver = OptimumSolver(structure)
+        solver.setOptions(options)
+
+        state = OptimumState()
+        state.x = 10.0 * ones(n)
+
+        res = solver.solve(params, state)
+
+        assert res.succeeded
+        assert norm(A.dot(state.x) - params.b) == approx(0.0, abs=1e-6)
+
+        # The trial iterates in the line search require extra evaluations of the objective function
+        assert res.num_objective_evals > res.iterations
+
+
+@mark.parametrize("mode", [HessianMode.BFGS, HessianMode.LBFGS, HessianMode.DiagonalSecant])
+def test_optimum_solver_quasi_newton(mode):
+
+    structure, params = create_gibbs_problem()
+
+    # Solve the problem with the exact Hessian matrix for comparison
+    options = OptimumOptions()
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    expected = OptimumState()
+    expected.x = ones(n)
+
+    assert solver.solve(params, expected).succeeded
+
+    # Solve the problem again with the Hessian matrix approximated, which the objective function is then never asked for
+    def gibbs_without_hessian(x, f):
+        assert not f.requires.hessian
+        gibbs(x, f)
+
+    params.objective = gibbs_without_hessian
+
+    options.hessian.mode = mode
+    options.max_iterations = 200
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    state = OptimumState()
+    state.x = ones(n)
+
+    res = solver.solve(params, state)
+
+    assert res.succeeded
+    assert norm(state.x - expected.x) / norm(expected.x) == approx(0.0, abs=1e-4)
+
+    # Solve the problem again from the default initial guess, at the bounds, which needs the monotone barrier
+    options.barrier.mode = BarrierMode.Monotone
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    state = OptimumState()
+
+    res = solver.solve(params, state)
+
+    assert res.succeeded
+    assert norm(state.x - expected.x) / norm(expected.x) == approx(0.0, abs=1e-4)
+
+
+def test_optimum_solver_reuse():
+
+    structure, params = create_gibbs_problem()
+
+    # Solve the problem with a new decomposition in every iteration for comparison
+    expected = OptimumState()
+    expected.x = ones(n)
+
+    expectedres = OptimumSolver(structure).solve(params, expected)
+
+    assert expectedres.succeeded
+    assert expectedres.num_factorizations == expectedres.iterations
+    assert expectedres.num_factorizations_saved == 0
+
+    # Solve the problem again reusing each decomposition for up to three iterations
+    options = OptimumOptions()
+    options.reuse.period = 3
+    options.max_iterations = 200
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    state = OptimumState()
+    state.x = ones(n)
+
+    res = solver.solve(params, state)
+
+    assert res.succeeded
+    assert res.num_factorizations_saved > 0
+    assert res.num_factorizations + res.num_factorizations_saved == res.iterations
+    assert res.num_hessian_evals == res.num_factorizations
+    assert norm(state.x - expected.x) / norm(expected.x) == approx(0.0, abs=1e-5)
+
+
+@mark.parametrize("qp", [False, True])
+def test_optimum_solver_predictor_corrector(qp):
+
+    A = Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, nbox)
+
+    # A linear or quadratic programming problem with many active lower and upper bounds at the solution
+    c = cbox
+    h = hbox if qp else zeros(nbox)
+
+    structure, params = create_bounded_problem(A, c, h)
+
+    # Solve the problem with plain Newton steps for comparison
+    options = OptimumOptions()
+    options.max_iterations = 500
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    expected = OptimumState()
+    expectedres = solver.solve(params, expected)
+
+    assert expectedres.succeeded
+
+    # Solve the problem again with Mehrotra's predictor-corrector steps
+    options.predictor_corrector = True
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    state = OptimumState()
+    res = solver.solve(params, state)
+
+    assert res.succeeded
+    assert norm(A.dot(state.x) - params.b) == approx(0.0, abs=1e-6)
+    assert all(state.x >= params.xlower) and all(state.x <= params.xupper)
+    assert c.dot(state.x) + 0.5 * state.x.dot(h * state.x) == approx(c.dot(expected.x) + 0.5 * expected.x.dot(h * expected.x), rel=1e-6)
+
+
+@mark.parametrize("mode", [BarrierMode.Monotone, BarrierMode.LOQO])
+def test_optimum_solver_barrier(mode):
+
+    A = Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, nbox)
+
+    # A quadratic programming problem with many active lower and upper bounds at the solution
+    c = cbox
+    h = hbox
+
+    structure, params = create_bounded_problem(A, c, h)
+
+    # Solve the problem with a fixed barrier parameter for comparison
+    options = OptimumOptions()
+    options.max_iterations = 500
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    expected = OptimumState()
+    expectedres = solver.solve(params, expected)
+
+    assert expectedres.succeeded
+
+    # Solve the problem again updating the barrier parameter along the iterations
+    options.barrier.mode = mode
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    state = OptimumState()
+    res = solver.solve(params, state)
+
+    assert res.succeeded
+    assert norm(A.dot(state.x) - params.b) == approx(0.0, abs=1e-6)
+    assert c.dot(state.x) + 0.5 * state.x.dot(h * state.x) == approx(c.dot(expected.x) + 0.5 * expected.x.dot(h * expected.x), rel=1e-6)
+
+
+def test_optimum_solver_termination():
+
+    A = Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, nbox)
+
+    # A quadratic programming problem with many active lower and upper bounds at the solution
+    structure, params = create_bounded_problem(A, cbox, hbox)
+
+    quadratic = quadratic_objective(cbox, hbox)
+
+    def solve(options):
+        solver = OptimumSolver(structure)
+        solver.setOptions(options)
+        state = OptimumState()
+        return solver.solve(params, state)
+
+    # Check the status of a calculation that converged
+    res = solve(OptimumOptions())
+
+    assert res.succeeded
+    assert res.status == OptimumStatus.Converged
+
+    # Check the status of a calculation that reached the maximum number of iterations
+    options = OptimumOptions()
+    options.max_iterations = 2
+
+    res = solve(options)
+
+    assert not res.succeeded
+    assert res.status == OptimumStatus.MaxIterations
+    assert res.iterations == 2
+
+    # Check the status of a calculation stopped by the small variation of the objective value
+    options = OptimumOptions()
+    options.tolerancef = 1.0e-2
+
+    res = solve(options)
+
+    assert res.succeeded
+    assert res.status in [OptimumStatus.SmallObjectiveChange, OptimumStatus.Converged]
+
+    # Check the status of a calculation whose gradient is perturbed in every evaluation, so that the residual error cannot decrease
+    perturbation = [1.0]
+
+    def perturbed(x, f):
+        quadratic(x, f)
+        perturbation[0] = -perturbation[0]
+        f.gradient = f.gradient + perturbation[0] * ones(nbox)
+
+    params.objective = perturbed
+
+    # The detection of stagnation is disabled by default
+    assert OptimumOptions().termination.stagnation_iterations == 0
+
+    options = OptimumOptions()
+    options.termination.stagnation_iterations = 10
+
+    res = solve(options)
+
+    assert not res.succeeded
+    assert res.status == OptimumStatus.Stagnated
+    assert res.iterations < options.max_iterations
+
+    # Check the status of a calculation whose objective function produces non-finite numbers after the first evaluations
+    evaluations = [0]
+
+    def nonfinite(x, f):
+        quadratic(x, f)
+        evaluations[0] += 1
+        if evaluations[0] > 3:
+            f.gradient = f.gradient * nan
+
+    params.objective = nonfinite
+
+    res = solve(OptimumOptions())
+
+    assert not res.succeeded
+    assert res.status == OptimumStatus.Diverged
+    assert res.iterations < 5
+
+
+def test_optimum_solver_cutoff():
+
+    A = Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, nbox)
+
+    # A linear programming problem with many active lower and upper bounds at the solution
+    structure, params = create_bounded_problem(A, cbox, zeros(nbox))
+
+    linear = quadratic_objective(cbox, zeros(nbox))
+
+    evaluations = [0]
+
+    def counted(x, f):
+        evaluations[0] += 1
+        linear(x, f)
+
+    params.objective = counted
+
+    # Return the residual error of a given state
+    def error(state):
+        stepper = OptimumStepper(structure)
+        stepper.setOptions(OptimumOptions())
+        f = ObjectiveResult()
+        linear(state.x, f)
+        r = stepper.residual(params, state, f)
+        return max(norm(r.a, inf), norm(r.b, inf), norm(r.c, inf), norm(r.d, inf))
+
+    # Cancel the calculation after a few evaluations of the objective function
+    options = OptimumOptions()
+    options.cancellation = lambda: evaluations[0] >= 5
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    state = OptimumState()
+    res = solver.solve(params, state)
+
+    assert not res.succeeded
+    assert res.status == OptimumStatus.Cancelled
+    assert res.iterations < 5
+    assert res.error == approx(error(state))
+
+    # Stop the calculation after a wall time that is too short for its convergence
+    options = OptimumOptions()
+    options.max_time = 1.0e-6
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    state = OptimumState()
+    res = solver.solve(params, state)
+
+    assert not res.succeeded
+    assert res.status == OptimumStatus.TimeLimit
+    assert res.error == approx(error(state))
+
+def test_optimum_solver_infeasibility():
+
+    # Return the status and number of iterations of a calculation of the quadratic programming problem with given matrix A and vector b
+    def solve(A, b):
+        structure, params = create_bounded_problem(A, cbox, hbox)
+        params.b = b
+
+        options = OptimumOptions()
+        options.termination.infeasibility_iterations = 5
+
+        solver = OptimumSolver(structure)
+        solver.setOptions(options)
+
+        state = OptimumState()
+        res = solver.solve(params, state)
+
+        return res.status, res.iterations
+
+    # A matrix A whose third row is a linear combination of the first two
+    A = Canonicalizer.assemble_matrix_A_with_one_linearly_dependent_row(m, nbox)
+    b = A.dot(0.5 * ones(nbox))
+
+    status, iterations = solve(A, b)
+
+    assert status == OptimumStatus.Converged
+
+    # Perturb b so that the linearly dependent equality constraints become inconsistent
+    b[2] += 1.0e-3
+
+    status, iterations = solve(A, b)
+
+    assert status == OptimumStatus.Infeasible
+    assert iterations == 0
+
+    # Require the sum of the variables to exceed its largest value permitted by the upper bounds
+    A = Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, nbox)
+    A[0, :] = 1.0
+    b = A.dot(0.5 * ones(nbox))
+    b[0] = nbox + 1.0
+
+    status, iterations = solve(A, b)
+
+    assert status == OptimumStatus.Infeasible
+    assert iterations < OptimumOptions().max_iterations
+
+def test_optimum_solver_infeasibility_linesearch():
+
+    # A feasible problem with the Gibbs-energy-like objective, whose multipliers grow large while the line search shortens the steps
+    A = 0.1 + abs(sin(arange(m*n) + 1.0)).reshape(m, n)
+
+    structure, params = create_gibbs_problem(A)
+
+    for infeasibility_iterations in [0, 5]:
+        options = OptimumOptions()
+        options.linesearch.active = True
+        options.predictor_corrector = True
+        options.termination.infeasibility_iterations = infeasibility_iterations
+
+        solver = OptimumSolver(structure)
+        solver.setOptions(options)
+
+        state = OptimumState()
+        res = solver.solve(params, state)
+
+        # The problem is never regarded as infeasible, neither by default nor with the check of diverging multipliers
+        assert res.succeeded
+        assert res.status == OptimumStatus.Converged
+        assert norm(A.dot(state.x) - params.b) == approx(0.0, abs=1e-6)
+
+    # The check of diverging multipliers is disabled by default
+    assert OptimumOptions().termination.infeasibility_iterations == 0
+
+
+def test_optimum_solver_scaling():
+
+    nx = 4*n
+
+    # A quadratic programming problem whose variables, equality constraints and objective function are badly scaled
+    P = 10.0**linspace(-2.0, 2.0, m)
+    Q = 10.0**linspace(2.0, -2.0, nx)
+
+    A = diag(P).dot(Canonicalizer.assemble_matrix_A_with_linearly_independent_rows_only(m, nx)).dot(diag(Q))
+
+    h = 1.0e+2 * Q**2 * linspace(0.1, 1.0, nx)
+    c = 1.0e+2 * Q * linspace(-1.0, 1.0, nx)
+
+    # The variables are in [0, 1/Q] instead of [0, 1]
+    structure, params = create_bounded_problem(A, c, h)
+    params.b = A.dot(0.5 / Q)
+    params.xupper = 1.0 / Q
+
+    dgdp = eigen.random(nx, 2)
+    dbdp = eigen.random(m, 2)
+
+    # Return the solution and its sensitivity derivatives calculated with or without scaling
+    def solve(scaled):
+        options = OptimumOptions()
+        options.tolerance = 1.0e-10
+        options.scaling.active = scaled
+
+        solver = OptimumSolver(structure)
+        solver.setOptions(options)
+
+        state = OptimumState()
+        res = solver.solve(params, state)
+
+        assert res.succeeded
+
+        sensitivity = OptimumSensitivity()
+        solver.sensitivities(dgdp, dbdp, sensitivity)
+
+        return state, sensitivity
+
+    state, sensitivity = solve(False)
+    scaledstate, scaledsensitivity = solve(True)
+
+    # The state and sensitivity derivatives calculated with scaling are returned unscaled
+    assert scaledstate.x == approx(state.x)
+    assert scaledstate.y == approx(state.y)
+    assert scaledstate.z == approx(state.z)
+    assert scaledstate.w == approx(state.w)
+
+    assert norm(scaledsensitivity.dxdp - sensitivity.dxdp) < 1.0e-6 * norm(sensitivity.dxdp)
+    assert norm(scaledsensitivity.dydp - sensitivity.dydp) < 1.0e-6 * norm(sensitivity.dydp)
+
+
+def test_optimum_solver_scaling_linesearch():
+
+    nx, mx = 8, 3
+
+    # A problem with the Gibbs-energy-like objective whose variables, equality constraints and objective function are badly scaled
+    P = array([1.0e-3, 1.0, 1.0e+3])
+    Q = 10.0**linspace(-2.0, 2.0, nx)
+
+    A = diag(P).dot(0.1 + abs(sin(arange(mx*nx) + 1.0)).reshape(mx, nx)).dot(diag(Q))
+
+    c = linspace(-1.0, 1.0, nx)
+
+    def gibbs(x, f):
+        y = Q * x
+        f.value = 1.0e+3 * y.dot(c + log(y / sum(y)))
+        f.gradient = 1.0e+3 * Q * (c + log(y / sum(y)))
+        if f.requires.hessian:
+            f.hessian = 1.0e+3 * diag(Q).dot(diag(1.0 / y) - 1.0 / sum(y)).dot(diag(Q))
+
+    structure = OptimumStructure(nx, mx)
+    structure.allVariablesHaveLowerBounds()
+    structure.A = A
+
+    params = OptimumParams()
+    params.b = A.dot(1.0 / Q)
+    params.xlower = zeros(nx)
+    params.objective = gibbs
+
+    # Return the solution calculated with or without scaling and line search
+    def solve(scaled, linesearch):
+        options = OptimumOptions()
+        options.scaling.active = scaled
+        options.linesearch.active = linesearch
+
+        solver = OptimumSolver(structure)
+        solver.setOptions(options)
+
+        state = OptimumState()
+        res = solver.solve(params, state)
+
+        assert res.succeeded
+        assert norm(A.dot(state.x) - params.b) < 1.0e-8 * norm(params.b)
+
+        return state
+
+    expected = solve(False, False)
+
+    # The merit function of the line search measures the feasibility of the scaled problem with the scaled matrix A
+    state = solve(True, True)
+
+    assert norm(state.x - expected.x) < 1.0e-8 * norm(expected.x)
+
+
+@mark.parametrize("scaled", [False, True])
+def test_optimum_solver_presolve(scaled):
+
+    # The problem with fixed variables, equal bounds, and singleton, forcing and empty constraints removed in the presolve
+    structure = OptimumPresolver.create_structure()
+    params = OptimumPresolver.create_params()
+
+    A = OptimumPresolver.A
+    nx, mx = A.shape
+
+    options = OptimumOptions()
+    options.tolerance = 1.0e-10
+    options.barrier.mode = BarrierMode.Monotone
+    options.presolve.active = True
+    options.scaling.active = scaled
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    state = OptimumState()
+    res = solver.solve(params, state)
+
+    assert res.succeeded
+
+    # The removed variables have the values determined in the presolve
+    assert state.x[[2, 3, 4, 6, 7]] == approx([0.5, 0.0, 0.0, 0.5, 0.3])
+    assert norm(A.dot(state.x) - params.b) < 1.0e-10
+
+    # The postsolved state satisfies the optimality conditions of the original problem (except for the fixed variable x7)
+    f = ObjectiveResult()
+    OptimumPresolver.objective(state.x, f)
+
+    residual = f.gradient + A.T.dot(state.y) - state.z - state.w
+    assert norm(residual[:7]) < 1.0e-8
+    assert all(state.z >= 0.0)
+    assert all(state.w <= 0.0)
+
+    # The sensitivity derivatives with respect to b0 (of the singleton constraint) and b3, compared with finite differences
+    dbdp = zeros((mx, 2))
+    dbdp[0, 0] = 1.0
+    dbdp[3, 1] = 1.0
+
+    sensitivity = OptimumSensitivity()
+    solver.sensitivities(zeros((nx, 2)), dbdp, sensitivity)
+
+    eps = 1.0e-6
+    for k in range(2):
+        perturbed = OptimumPresolver.create_params()
+        perturbed.b = params.b + eps * dbdp[:, k]
+        perturbedstate = OptimumState()
+        assert solver.solve(perturbed, perturbedstate).succeeded
+        assert (perturbedstate.x - state.x) / eps == approx(sensitivity.dxdp[:, k], abs=1.0e-4)
+
+    assert sensitivity.dxdp[2, 0] == approx(0.5)
+
+
+@mark.parametrize("scaled", [False, True])
+def test_optimum_solver_reduced_space(scaled):
+
+    # The problem with bounds only on the non-basic variables, whose basic variables are eliminated in the reduced space
+    structure = OptimumReducer.create_structure()
+    params = OptimumReducer.create_params()
+
+    A = OptimumReducer.A
+    nx, mx = A.shape
+
+    options = OptimumOptions()
+    options.tolerance = 1.0e-10
+    options.barrier.mode = BarrierMode.Monotone
+    options.scaling.active = scaled
+
+    # The solution in the full space, used as reference
+    fullsolver = OptimumSolver(structure)
+    fullsolver.setOptions(options)
+
+    fullstate = OptimumState()
+    assert fullsolver.solve(params, fullstate).succeeded
+
+    options.reduced_space = True
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    state = OptimumState()
+    res = solver.solve(params, state)
+
+    assert res.succeeded
+
+    # The solution in the reduced space is the same, with multipliers y recovered from the gradient at the solution
+    assert state.x == approx(fullstate.x, abs=1.0e-8)
+    assert state.y == approx(fullstate.y, abs=1.0e-6)
+    assert norm(A.dot(state.x) - params.b) < 1.0e-10
+
+    f = ObjectiveResult()
+    OptimumReducer.objective(state.x, f)
+
+    residual = f.gradient + A.T.dot(state.y) - state.z - state.w
+    assert norm(residual) < 1.0e-8
+
+    # The sensitivity derivatives with respect to b0 and b3, compared with finite differences
+    dbdp = zeros((mx, 2))
+    dbdp[0, 0] = 1.0
+    dbdp[3, 1] = 1.0
+
+    sensitivity = OptimumSensitivity()
+    solver.sensitivities(zeros((nx, 2)), dbdp, sensitivity)
+
+    eps = 1.0e-6
+    for k in range(2):
+        perturbed = OptimumReducer.create_params()
+        perturbed.b = params.b + eps * dbdp[:, k]
+        perturbedstate = OptimumState()
+        assert solver.solve(perturbed, perturbedstate).succeeded
+        assert (perturbedstate.x - state.x) / eps == approx(sensitivity.dxdp[:, k], abs=1.0e-4)
+        assert (perturbedstate.y - state.y) / eps == approx(sensitivity.dydp[:, k], abs=1.0e-4)
+
+
+@mark.parametrize("iterations", [1, 5])
+def test_optimum_solver_active_set(iterations):
+
+    # The problem whose solution has about half of the variables at their lower bounds
+    random.seed(50)
+
+    nx, mx = 20, 4
+
+    A = random.rand(mx, nx)
+    c = random.rand(nx) - 0.5
+
+    def objective(x, f):
+        f.value = sum((x - c) ** 2)
+        f.gradient = 2.0 * (x - c)
+        f.hessian = 2.0 * ones(nx)
+
+    structure = OptimumStructure(nx, mx)
+    structure.allVariablesHaveLowerBounds()
+    structure.setConstantHessianDiagonal(2.0 * ones(nx))
+    structure.A = A
+
+    params = OptimumParams()
+    params.b = A.dot(0.1 * ones(nx))
+    params.xlower = zeros(nx)
+    params.objective = objective
+
+    options = OptimumOptions()
+    options.tolerance = 1.0e-10
+    options.max_iterations = 200
+
+    # The solution without the active set, used as reference
+    plainsolver = OptimumSolver(structure)
+    plainsolver.setOptions(options)
+
+    plainstate = OptimumState()
+    assert plainsolver.solve(params, plainstate).succeeded
+
+    options.activeset.active = True
+    options.activeset.iterations = iterations
+
+    solver = OptimumSolver(structure)
+    solver.setOptions(options)
+
+    # The solution is the same, with the multipliers of the fixed variables satisfying the optimality conditions
+    for k in range(2):
+        state = OptimumState()
+        assert solver.solve(params, state).succeeded
+
+        assert state.x == approx(plainstate.x, abs=1.0e-8)
+        assert norm(A.dot(state.x) - params.b) < 1.0e-10
+
+        f = ObjectiveResult()
+        objective(state.x, f)
+
+        residual = f.gradient + A.T.dot(state.y) - state.z - state.w
+        assert norm(residual) < 1.0e-8
+        assert all(state.z >= 0.0)
+        assert norm(state.x * state.z) < 1.0e-8
+
 # 
 # def test_optimum_solver():
 # 
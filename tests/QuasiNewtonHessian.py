@@ -0,0 +1,87 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2014-2018 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+from optima import *
+from numpy import *
+from numpy.linalg import norm
+from pytest import approx, mark
+
+# The number of variables
+n = 5
+
+# Tested cases for the quasi-Newton modes
+tested_modes = [HessianMode.BFGS, HessianMode.LBFGS, HessianMode.DiagonalSecant]
+
+
+@mark.parametrize("mode", tested_modes)
+def test_quasi_newton_hessian(mode):
+
+    random.seed(0)
+
+    # The Hessian matrix of a convex quadratic objective function, well conditioned so that no pair of variations is damped
+    H = diag(linspace(1.0, 4.0, n))
+
+    def evaluate(x):
+        f = ObjectiveResult()
+        f.value = 0.5 * x.dot(H).dot(x)
+        f.gradient = H.dot(x)
+        return f
+
+    options = OptimumHessianOptions()
+    options.mode = mode
+    options.memory = 3
+
+    hessian = QuasiNewtonHessian()
+    hessian.initialize(options, n)
+
+    x0 = random.rand(n)
+    x1 = random.rand(n)
+
+    # The initial approximation, before any variation of the gradient is known, is the identity matrix
+    f0 = hessian.update(x0, evaluate(x0))
+
+    assert f0.value == approx(0.5 * x0.dot(H).dot(x0))
+    assert norm(f0.gradient - H.dot(x0)) == 0.0
+
+    if mode == HessianMode.DiagonalSecant:
+        assert norm(f0.hessian.diagonal - ones(n)) == 0.0
+    else:
+        assert norm(f0.hessian.dense - eye(n)) == 0.0
+
+    # The approximation is copied, since the result of every update is the same object
+    f1 = hessian.update(x1, evaluate(x1))
+    B1 = array(f1.hessian.dense)
+    D1 = array(f1.hessian.diagonal)
+
+    # The updated approximation satisfies the secant condition B*s = y (only its weak form s'*B*s = s'*y in the diagonal mode)
+    s = x1 - x0
+    y = H.dot(s)
+
+    if mode == HessianMode.DiagonalSecant:
+        assert all(D1 > 0.0)
+        assert s.dot(D1 * s) == approx(s.dot(y))
+    else:
+        assert norm(B1.dot(s) - y) == approx(0.0, abs=1e-10)
+        assert norm(B1 - B1.T) == approx(0.0, abs=1e-12)
+
+    # Repeated iterates are skipped, since the variation of x is comparable to round-off errors
+    f2 = hessian.update(x1, evaluate(x1))
+
+    if mode == HessianMode.DiagonalSecant:
+        assert norm(f2.hessian.diagonal - D1) == 0.0
+    else:
+        assert norm(f2.hessian.dense - B1) == 0.0
@@ -136,3 +136,11 @@ def test_saddle_point_solver(args):
 
     # Check the residual of the equation M * s = r
     assert norm(M.dot(s) - r) / norm(r) == approx(0.0)
+
+    # Solve the saddle point problem for several right-hand side vectors at once, one per column
+    R = column_stack([r, M.dot(-expected), M.dot(ones(t))])
+    S = zeros((t, 3), order='F')
+    solver.solve(R, S)
+
+    # Check the residual of the equation M * S = R
+    assert norm(M.dot(S) - R) / norm(R) == approx(0.0)